@@ -91,6 +91,10 @@ namespace Annwvyn
 		/// \param id The string ID of the object you want
 		AnnGameObject* AnnGetGameObject(std::string id);
 
+		///ScriptFunction: get a handle to a GameObject from it's ID. Unlike the object itself, a handle can be kept between frames
+		/// \param id The string ID of the object you want
+		AnnGameObjectHandle AnnGetGameObjectHandle(std::string id);
+
 		///ScriptFunction: set the gravity vector
 		/// \param gravity The vector to use as `g`
 		void AnnChangeGravity(const Ogre::Vector3& gravity);
@@ -102,6 +106,10 @@ namespace Annwvyn
 		/// \param id The ID number of the level
 		void AnnJumpLevel(level_id id);
 
+		///ScriptFunction: Jump the level manager to another level, loading it in the background without stopping the rendering
+		/// \param id The ID number of the level
+		void AnnJumpLevelAsync(level_id id);
+
 		///Call the Win32 API to change the game process priority to "normal". Reduce the impact of the game on background task but also can create performance problems.
 		void AnnSetProcessPriorityNormal();
 
@@ -270,6 +278,20 @@ namespace Annwvyn
 
 			///Play a sound
 			void playSound(std::string name, bool loop = true);
+
+			///Get a handle to this object
+			AnnGameObjectHandle getHandle();
+		};
+
+		///Reference to a game object that knows when the object has been removed
+		class AnnGameObjectHandle
+		{
+		public:
+			///Get the object, or null if it has been removed
+			AnnGameObject* get();
+
+			///Return true if the object still exists
+			bool isValid();
 		};
 
 		///Collision between 2 game objects
@@ -287,6 +309,12 @@ namespace Annwvyn
 
 			///Get the name of 2nd object
 			std::string getBObjectName();
+
+			///Get a handle to the 1st object in the pair
+			AnnGameObjectHandle getAObjectHandle();
+
+			///Get a handle to the 2nd object in the pair
+			AnnGameObjectHandle getBObjectHandle();
 		};
 
 		///Collision between the player and a game object
@@ -298,6 +326,9 @@ namespace Annwvyn
 
 			///Get the name of the object that collided with the player
 			std::string getObjectName();
+
+			///Get a handle to the object that collided with the player
+			AnnGameObjectHandle getObjectHandle();
 		};
 
 		///Value of Pi
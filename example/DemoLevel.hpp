@@ -103,7 +103,7 @@ public:
 		rotating	  = nullptr;
 	}
 
-	void TriggerEvent(AnnTriggerEvent e) override
+	void TriggerEvent(const AnnTriggerEvent& e) override
 	{
 		AnnDebug() << "got trigger event";
 		if(e.getContactStatus())
@@ -13,20 +13,20 @@ public:
 		AnnDebug() << "constructed a GoBackToDemoHub listener";
 	}
 
-	void KeyEvent(AnnKeyEvent e) override
+	void KeyEvent(const AnnKeyEvent& e) override
 	{
 		if(e.shouldIgnore()) return;
 		if(e.isPressed() && e.getKey() == KeyCode::space)
 			jumpToHub();
 	}
 
-	void ControllerEvent(AnnControllerEvent e) override
+	void ControllerEvent(const AnnControllerEvent& e) override
 	{
 		if(e.isXboxController() && e.isPressed(8))
 			jumpToHub();
 	}
 
-	void HandControllerEvent(AnnHandControllerEvent e) override
+	void HandControllerEvent(const AnnHandControllerEvent& e) override
 	{
 		if(e.buttonPressed(3))
 			switch(e.getSide())
@@ -57,7 +57,7 @@ public:
 	}
 
 	//When this method is called "a" timer (any one of them) did timeout. Test the "getID()" value of the event to get the ID you want
-	void TimeEvent(AnnTimeEvent e) override
+	void TimeEvent(const AnnTimeEvent& e) override
 	{
 		//Seeing if this event is really the one we are looking for
 		if(waitFor == e.getID())
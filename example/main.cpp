@@ -46,7 +46,7 @@ public:
 	}
 
 	///Quit app when button zero of left controller is pressed
-	void HandControllerEvent(AnnHandControllerEvent e) override
+	void HandControllerEvent(const AnnHandControllerEvent& e) override
 	{
 		if(e.getSide() == AnnHandController::leftHandController)
 			if(e.buttonPressed(0))
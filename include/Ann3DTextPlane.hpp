@@ -5,6 +5,7 @@
 
 #include <Overlay/OgreFontManager.h>
 #include <Overlay/OgreFont.h>
+#include <Hlms/Unlit/OgreHlmsUnlitDatablock.h>
 #include <string>
 
 #include "AnnTypes.h"
@@ -20,6 +21,14 @@ namespace Annwvyn
 						 ALIGN_CENTER = 'c',
 						 ALIGN_RIGHT  = 'r' };
 
+		///How the text is drawn
+		enum RenderMode {
+			///Text is rasterized on the CPU in a texture. Changing it re-render the whole texture
+			RENDER_TEXTURE,
+			///Text is drawn as quads sampling a signed distance field of the font. Changing it only rewrites the vertices of the quads
+			RENDER_DISTANCE_FIELD
+		};
+
 		///Construct a 3D text plane. Need to provide a caption to auto render text
 		/// \param w Width in meter
 		/// \param h Height in meter
@@ -28,7 +37,8 @@ namespace Annwvyn
 		/// \param resolution Character "print" resolution in DPI. This will influence the texture resolution
 		/// \param font Your name of the font. To reuse a font configuration
 		/// \param fontTTF Name of the TTF file known by the resource manager
-		Ann3DTextPlane(const float& w, const float& h, const std::string& caption = "", const int& size = 128, const float& resolution = 96.0f, const std::string& font = "defaultFont", const std::string& fontTTF = "VeraMono.ttf");
+		/// \param mode How the text is drawn. Use RENDER_DISTANCE_FIELD for text that changes often
+		Ann3DTextPlane(const float& w, const float& h, const std::string& caption = "", const int& size = 128, const float& resolution = 96.0f, const std::string& font = "defaultFont", const std::string& fontTTF = "VeraMono.ttf", RenderMode mode = RENDER_TEXTURE);
 
 		///Class destructor
 		~Ann3DTextPlane();
@@ -74,7 +84,35 @@ namespace Annwvyn
 		/// \param imgName name of an image loaded in the resource manager
 		void setBackgroundImage(const std::string& imgName);
 
+		///Get how the text is drawn
+		RenderMode getRenderMode() const;
+
+		///Number of glyph quads the vertex buffer can hold. Only used in RENDER_DISTANCE_FIELD mode
+		size_t getGlyphCapacity() const;
+
 	private:
+		///A glyph placed on the plane, in meters
+		struct GlyphQuad
+		{
+			float left, top, right, bottom;
+			float u0, v0, u1, v1;
+		};
+
+		///Create the unlit datablocks used to draw the distance field text and the background
+		void createDistanceFieldDatablocks();
+
+		///Recreate the geometry of a distance field plane, with room for `capacity` glyphs
+		void createDistanceFieldPlane(size_t capacity);
+
+		///Write the vertices of every glyph quad, unused quads are degenerated
+		void writeGlyphQuads(const std::vector<GlyphQuad>& quads);
+
+		///Place the glyphs of the caption. Uses the same line breaking and alignment rules as AnnConsole::WriteToTexture
+		std::vector<GlyphQuad> layoutText() const;
+
+		///Lay the text out and rewrite the glyph quads
+		void renderDistanceFieldText();
+
 		///Create the font
 		void createFont(const int& size);
 
@@ -161,5 +199,17 @@ namespace Annwvyn
 
 		///Will use an image as background
 		bool useImageAsBackground;
+
+		///How the text is drawn
+		RenderMode renderMode;
+
+		///Number of glyph quads in the geometry
+		size_t glyphCapacity;
+
+		///Datablock of the glyphs, in RENDER_DISTANCE_FIELD mode
+		Ogre::HlmsUnlitDatablock* textDatablock;
+
+		///Datablock of the background, in RENDER_DISTANCE_FIELD mode
+		Ogre::HlmsUnlitDatablock* backgroundDatablock;
 	};
 }
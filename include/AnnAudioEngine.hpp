@@ -109,6 +109,12 @@ namespace Annwvyn
 		/// \copydoc loadBuffer()
 		void preLoadBuffer(const std::string& filename);
 
+		///Load a sound file already read in memory, without any disk I/O. Used by the resource preloader
+		/// \param filename Name of the file
+		/// \param group Resource group of the file
+		/// \param data Content of the file
+		void preLoadBuffer(const std::string& filename, const std::string& group, Ogre::DataStreamPtr data);
+
 		///Return "false" if buffer not loaded. Return buffer index if buffer is loaded.
 		ALuint isBufferLoader(const std::string& filename);
 
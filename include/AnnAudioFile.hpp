@@ -19,6 +19,9 @@ namespace Annwvyn
 		///Read bytes from a data stream and stick them inside the "data" re-sizable array
 		void readFromStream(Ogre::DataStreamPtr& stream);
 
+		///Content of the file already read, used by the next load instead of opening the file
+		Ogre::DataStreamPtr preloadedData;
+
 		///Utility class that perform a static_cast<AnnAudioFile*> on the pointer you give it.
 		inline static AnnAudioFile* cast(void* audioFileRawPtr);
 
@@ -46,6 +49,9 @@ namespace Annwvyn
 		///Return a raw const pointer to the data, in bytes
 		const byte* getData() const;
 
+		///Give the content of the file, already read. The next load will use it instead of opening the file
+		void setPreloadedData(Ogre::DataStreamPtr stream);
+
 		///Return the size
 		size_t getSize() const override;
 
@@ -99,6 +105,9 @@ namespace Annwvyn
 		///Load a file via the AudioFileManager
 		virtual AnnAudioFilePtr load(const Ogre::String& name, const Ogre::String& group);
 
+		///Load a file from it's content, already read
+		AnnAudioFilePtr load(const Ogre::String& name, const Ogre::String& group, Ogre::DataStreamPtr data);
+
 		///Get singleton ref
 		static AnnAudioFileManager& getSingleton();
 
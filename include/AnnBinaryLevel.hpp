@@ -0,0 +1,100 @@
+/**
+* \file AnnBinaryLevel.hpp
+* \brief Level loaded from a compiled level file
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <string>
+#include <vector>
+
+#include "AnnLevel.hpp"
+#include "AnnGameObject.hpp"
+#include "AnnLightObject.hpp"
+#include "AnnInstancedMesh.hpp"
+#include "AnnMappedFile.hpp"
+#include "AnnBinaryLevelFormat.hpp"
+#include "AnnFrameArena.hpp"
+
+namespace Annwvyn
+{
+	///Level object loaded from a compiled level file.
+	///The file is mapped in memory and the objects are created directly from it's records, without any parsing.
+	///Compiled level files are created from the same JSON files AnnJsonLevel uses, by the AnnLevelCompiler tool or by compileFile().
+	class AnnDllExport AnnBinaryLevel : LEVEL
+	{
+	public:
+		///Open a compiled level file, and declare the resources it needs
+		/// \param path Path to the compiled level
+		/// \param preload If set to false, resource groups will not be loaded now
+		AnnBinaryLevel(const std::string& path, const bool preload = true);
+
+		///Dtor
+		virtual ~AnnBinaryLevel();
+
+		///Create every object, light and set of instances of the level
+		void load() override;
+
+		///Run logic, actually empty here
+		void runLogic() override;
+
+		///Load the whole compiled level file in memory
+		void prepare() override;
+
+		///Create objects, lights and sets of instances for about `budget` milliseconds, then place the player once everything exists
+		bool loadIncrementally(double budget) override;
+
+		///Fraction of the records already instantiated
+		float getLoadingProgress() const override;
+
+		///Unload the level, and restart incremental loading from the first record
+		void unload() override;
+
+		///Compile the JSON code of a level. Throws AnnInitializationError if the JSON is not a valid level
+		static std::vector<char> compile(const std::string& jsonCode);
+
+		///Compile a JSON level file into a compiled level file
+		static void compileFile(const std::string& jsonPath, const std::string& binaryPath);
+
+	protected:
+		///Get a string of the level. Return an empty string for noString
+		const char* getString(uint32_t reference) const;
+
+		///Get the records of a table
+		template <class Record>
+		AnnSpan<const Record> getTable(const AnnBinaryLevelFormat::Table& table) const
+		{
+			return { reinterpret_cast<const Record*>(file.data() + table.offset), table.count };
+		}
+
+		///Get the header of the file
+		const AnnBinaryLevelFormat::Header& getHeader() const;
+
+		///Create the game object described by a record, and add it to the level
+		AnnGameObjectPtr instantiate(const AnnBinaryLevelFormat::ObjectRecord& object);
+
+		///Create the light described by a record, and add it to the level
+		AnnLightObjectPtr instantiate(const AnnBinaryLevelFormat::LightRecord& light);
+
+		///Create the set of instances described by a record, and add it to the level
+		AnnInstancedMeshPtr instantiate(const AnnBinaryLevelFormat::InstanceSetRecord& instanceSet);
+
+		///Put the player at the start position of the level
+		void placePlayer() const;
+
+	private:
+		///Check that the file is a compiled level this engine can read, and that every table and string is inside the file
+		void validate() const;
+
+		///The compiled level
+		AnnMappedFile file;
+		///Header at the start of the file
+		const AnnBinaryLevelFormat::Header* header;
+		///If set to false, resource group will not be initialized
+		const bool preloadResources;
+		///Number of records (objects, lights, then sets of instances) already instantiated by loadIncrementally()
+		size_t instantiatedRecords;
+	};
+}
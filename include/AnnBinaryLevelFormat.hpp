@@ -0,0 +1,203 @@
+/**
+* \file AnnBinaryLevelFormat.hpp
+* \brief Layout of compiled level files. Shared by the engine and the level compiler
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Annwvyn
+{
+	///Layout of a compiled level file.
+	///A file is a Header, followed by tables of fixed size records. Strings are stored once in a string table, and records
+	///refer to them by their offset in that table. Every value is little endian. Offsets are counted from the start of the file.
+	namespace AnnBinaryLevelFormat
+	{
+		///First bytes of a compiled level
+		static constexpr char magic[4]{ 'A', 'N', 'L', 'V' };
+		///Version of the format written by the compiler
+		static constexpr uint32_t version{ 3 };
+		///Value of a string reference that doesn't point to any string
+		static constexpr uint32_t noString{ 0xFFFFFFFF };
+
+		///Location and number of records in a table
+		struct Table
+		{
+			///Offset of the first record
+			uint32_t offset;
+			///Number of records
+			uint32_t count;
+		};
+
+		///Header of the file
+		struct Header
+		{
+			///Should be equal to magic
+			char magic[4];
+			///Version of the format
+			uint32_t version;
+			///Size of the whole file
+			uint32_t fileSize;
+			///Name of the level
+			uint32_t name;
+			///Concatenated null terminated strings. The count is in bytes
+			Table strings;
+			///ResourceRecord table
+			Table resources;
+			///ObjectRecord table
+			Table objects;
+			///ScriptRecord table. Objects refer to a range of it
+			Table scripts;
+			///LightRecord table
+			Table lights;
+			///CellRecord table. Empty if the level isn't divided in cells
+			Table cells;
+			///Size of the side of a cell, in meters
+			float cellSize;
+			///Position of the player when the level starts
+			float playerPosition[3];
+			///Orientation of the player when the level starts. x, y, z, w
+			float playerOrientation[4];
+			///InstanceSetRecord table
+			Table instanceSets;
+			///InstanceRecord table. Sets refer to a range of it
+			Table instances;
+		};
+
+		///A resource location to declare when the level is constructed
+		struct ResourceRecord
+		{
+			///Resource group
+			uint32_t group;
+			///Path of the location
+			uint32_t path;
+			///Type of location ("Zip")
+			uint32_t type;
+		};
+
+		///Flags of an ObjectRecord
+		enum ObjectFlags : uint8_t {
+			hasPhysics		 = 1 << 0,
+			colideWithPlayer = 1 << 1
+		};
+
+		///A game object
+		struct ObjectRecord
+		{
+			///Name of the object
+			uint32_t name;
+			///Mesh file
+			uint32_t mesh;
+			///Position
+			float position[3];
+			///Orientation. x, y, z, w
+			float orientation[4];
+			///Scale
+			float scale[3];
+			///Mass of the physics body
+			float mass;
+			///Index of the first script of this object in the script table
+			uint32_t firstScript;
+			///Number of scripts attached to this object
+			uint32_t scriptCount;
+			///Shape of the physics body, as a phyShapeType
+			uint8_t shape;
+			///Combination of ObjectFlags
+			uint8_t flags;
+			///Unused
+			uint8_t padding[2];
+		};
+
+		///A script attached to an object
+		struct ScriptRecord
+		{
+			///Name of the script
+			uint32_t name;
+			///Script domain to run it into, or noString for the object itself
+			uint32_t domain;
+		};
+
+		///Flags of a LightRecord
+		enum LightFlags : uint8_t {
+			hasPosition  = 1 << 0,
+			hasDirection = 1 << 1
+		};
+
+		///A light source
+		struct LightRecord
+		{
+			///Name of the light
+			uint32_t name;
+			///Type of the light, as a AnnLightObject::LightTypes
+			int32_t type;
+			///Power of the light
+			float power;
+			///Position
+			float position[3];
+			///Direction
+			float direction[3];
+			///Combination of LightFlags
+			uint8_t flags;
+			///Unused
+			uint8_t padding[3];
+		};
+
+		///Flags of an InstanceSetRecord
+		enum InstanceSetFlags : uint8_t {
+			staticInstances = 1 << 0
+		};
+
+		///A set of instances of the same mesh, created as an AnnInstancedMesh
+		struct InstanceSetRecord
+		{
+			///Name of the set
+			uint32_t name;
+			///Mesh file
+			uint32_t mesh;
+			///Index of the first instance of this set in the instance table
+			uint32_t firstInstance;
+			///Number of instances in this set
+			uint32_t instanceCount;
+			///Combination of InstanceSetFlags
+			uint8_t flags;
+			///Unused
+			uint8_t padding[3];
+		};
+
+		///Transform of one instance
+		struct InstanceRecord
+		{
+			///Position
+			float position[3];
+			///Orientation. x, y, z, w
+			float orientation[4];
+			///Scale
+			float scale[3];
+		};
+
+		///A square of the ground. Cells divide the level on the X and Z axis, with cellSize sided squares.
+		///The objects of a cell are contiguous in the object table
+		struct CellRecord
+		{
+			///Index of the cell on the X axis. The cell starts at x * cellSize
+			int32_t x;
+			///Index of the cell on the Z axis. The cell starts at z * cellSize
+			int32_t z;
+			///Index of the first object of this cell in the object table
+			uint32_t firstObject;
+			///Number of objects in this cell
+			uint32_t objectCount;
+		};
+
+		static_assert(std::is_trivially_copyable<Header>::value && sizeof(Header) == 112, "Header layout changed");
+		static_assert(sizeof(ResourceRecord) == 12, "ResourceRecord layout changed");
+		static_assert(sizeof(ObjectRecord) == 64, "ObjectRecord layout changed");
+		static_assert(sizeof(ScriptRecord) == 8, "ScriptRecord layout changed");
+		static_assert(sizeof(LightRecord) == 40, "LightRecord layout changed");
+		static_assert(sizeof(InstanceSetRecord) == 20, "InstanceSetRecord layout changed");
+		static_assert(sizeof(InstanceRecord) == 40, "InstanceRecord layout changed");
+		static_assert(sizeof(CellRecord) == 16, "CellRecord layout changed");
+	}
+}
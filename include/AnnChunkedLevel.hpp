@@ -0,0 +1,113 @@
+/**
+* \file AnnChunkedLevel.hpp
+* \brief Compiled level that streams it's cells in and out around the player
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <deque>
+#include <vector>
+
+#include "AnnBinaryLevel.hpp"
+
+namespace Annwvyn
+{
+	///Compiled level divided in cells. Only the cells close to the player exist in the scene.
+	///Cells are created from the compiled level file when the player comes within the load radius, a few objects per frame.
+	///They are destroyed when the player goes farther than the unload radius. Having the unload radius bigger than the load radius
+	///prevent a cell to be loaded and unloaded repeatedly when the player walks along it's border.
+	///The level file needs to be compiled with a "cellSize". Lights are global to the level, and are always loaded
+	class AnnDllExport AnnChunkedLevel : public AnnBinaryLevel
+	{
+	public:
+		///Open a compiled level file divided in cells
+		/// \param path Path to the compiled level
+		/// \param loadRadius Cells closer than this distance to the player are loaded
+		/// \param unloadRadius Cells farther than this distance to the player are unloaded. Should be bigger than loadRadius
+		/// \param maxLoadedCells Maximum number of cells in the scene at the same time
+		/// \param preload If set to false, resource groups will not be loaded now
+		AnnChunkedLevel(const std::string& path, float loadRadius, float unloadRadius, size_t maxLoadedCells = 64, const bool preload = true);
+
+		///Dtor
+		virtual ~AnnChunkedLevel();
+
+		///Create the lights, place the player and load every cell around it
+		void load() override;
+
+		///Create the lights, place the player, then load the cells around it for about `budget` milliseconds
+		bool loadIncrementally(double budget) override;
+
+		///Fraction of the cells around the player that are loaded
+		float getLoadingProgress() const override;
+
+		///Unload every cell
+		void unload() override;
+
+		///Load and unload cells following the player
+		void runLogic() override;
+
+		///Set the time spent creating objects at each frame, in milliseconds
+		void setStreamingBudget(double milliseconds);
+
+		///Number of cells currently in the scene, partially created or not
+		size_t getLoadedCellCount() const;
+
+		///Number of cells waiting to be created
+		size_t getPendingCellCount() const;
+
+	private:
+		///Streaming state of a cell
+		enum class CellState {
+			unloaded,
+			queued,
+			loaded
+		};
+
+		///Objects of a cell that are in the scene
+		struct Cell
+		{
+			///Current state
+			CellState state = CellState::unloaded;
+			///Number of objects of the cell already created
+			uint32_t createdObjects = 0;
+			///The created objects
+			std::vector<AnnGameObjectPtr> objects;
+		};
+
+		///Distance on the ground between the player and the closest point of the cell
+		float distanceToPlayer(const AnnBinaryLevelFormat::CellRecord& cell, const AnnVect3& player) const;
+
+		///Queue the cells entering the load radius, and unload the ones leaving the unload radius
+		void updateCells();
+
+		///Destroy every object of a cell
+		void unloadCell(size_t index);
+
+		///Create one object of the first queued cell. Return true if the queue is empty
+		bool streamStep();
+
+		///Radius where cells are loaded
+		const float loadRadius;
+		///Radius where cells are unloaded
+		const float unloadRadius;
+		///Maximum number of cells in the scene
+		const size_t maxLoadedCells;
+		///Time spent creating objects at each frame
+		double streamingBudget;
+
+		///State of each CellRecord
+		std::vector<Cell> cells;
+		///Cells to create, closest first
+		std::deque<size_t> loadQueue;
+		///Number of cells queued or loaded
+		size_t loadedCellCount;
+		///Position of the player at the last cell update
+		AnnVect3 lastUpdatePosition;
+		///Set to true when cells needs to be reconsidered, even if the player didn't move
+		bool cellsDirty;
+		///Set to true once the lights are created and the player placed
+		bool staticContentLoaded;
+	};
+}
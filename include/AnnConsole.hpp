@@ -53,8 +53,8 @@ namespace Annwvyn
 		///True if text has been updated on the console and the console is visible.
 		bool needUpdate() override;
 
-		///Update the console by filling it with background texture then blitting text on it.
-		///Can take some computing time depending on the size/resolution of the textures and buffer
+		///Redraw the lines of the console that changed since the last update, and move the cursor.
+		///Each line has it's own region of the texture. Log lines are kept in a ring : scrolling only moves the part of the surface showing them
 		void update() override;
 
 		///Move the console where it should
@@ -88,14 +88,26 @@ namespace Annwvyn
 		///Return true if the given string match with any of the forbidden keyword int the array
 		bool isForbdiden(const std::string& keyword);
 
-		///True if content of the buffer has been modified
-		bool modified;
+		///Get the height of a line and the width of a character from the font
+		void measureFont();
+
+		///Redraw a row of the texture if it doesn't already show this text
+		void drawRow(size_t row, const std::string& text);
+
+		///Region of the texture used by a row
+		Ogre::Image::Box getRowBox(size_t row) const;
 
-		///Array of 3D points to construct the render plane
-		std::array<AnnVect3, 4> points;
+		///Rewrite the vertices of the surface, so the log lines are displayed in order from the start of the ring
+		void updateSurface();
 
-		///Array of UV coordinates to constructed the render plane
-		std::array<AnnVect2, 4> textCoord;
+		///Write a horizontal band of the surface, from top to bottom in pixels, that show the texture from textureTop
+		void writeSurfaceBand(size_t index, float top, float bottom, float textureTop);
+
+		///Move the cursor quad under a column of the command line
+		void updateCursor(size_t column);
+
+		///True if content of the buffer has been modified
+		bool modified;
 
 		///Buffer of string objects
 		std::string buffer[CONSOLE_BUFFER];
@@ -138,6 +150,24 @@ namespace Annwvyn
 
 		///Position of the text cursor, indexed from the end of the string.
 		int cursorPos;
+
+		///Text currently drawn in each row of the texture : the log lines, the separator and the command line
+		std::array<std::string, CONSOLE_BUFFER + 2> drawnRows;
+
+		///Row of the texture showing the oldest log line
+		size_t ringHead;
+
+		///Number of lines appended since the last update
+		size_t pendingScroll;
+
+		///Height of a row, in pixels. 0 until the font is measured
+		size_t lineHeight;
+
+		///Width of a character of the mono-spaced font, in pixels
+		size_t charAdvance;
+
+		///Column of the command line the cursor is under
+		size_t cursorColumn;
 	};
 
 	using AnnConsolePtr = std::shared_ptr<AnnConsole>;
@@ -21,14 +21,14 @@ namespace Annwvyn
 		///Construct the default listener
 		AnnDefaultEventListener();
 		///Get events from keyboards
-		void KeyEvent(AnnKeyEvent e) override;
+		void KeyEvent(const AnnKeyEvent& e) override;
 		///Get events from the mouse
-		void MouseEvent(AnnMouseEvent e) override;
+		void MouseEvent(const AnnMouseEvent& e) override;
 		///Get events from the joystick
-		void ControllerEvent(AnnControllerEvent e) override;
+		void ControllerEvent(const AnnControllerEvent& e) override;
 		static void reclampDegreeToPositiveRange(float& degree);
 		///Get events from an hand controller
-		void HandControllerEvent(AnnHandControllerEvent e) override;
+		void HandControllerEvent(const AnnHandControllerEvent& e) override;
 
 		///Set all the key-codes for the controls
 		void setKeys(KeyCode::code fw,
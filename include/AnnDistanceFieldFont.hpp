@@ -0,0 +1,88 @@
+/**
+* \file AnnDistanceFieldFont.hpp
+* \brief Signed distance field atlas of a font, to draw text as textured quads on the GPU
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <Overlay/OgreFont.h>
+#include <OgreTexture.h>
+
+namespace Annwvyn
+{
+	///Texture where each glyph of a font is stored as a signed distance field : the alpha is 0.5 on the outline of the glyph,
+	///more inside it and less outside it. Text drawn from it with an alpha test at 0.5 keeps sharp edges when scaled.
+	///The field is computed once from the glyph atlas, and cached per font.
+	class AnnDllExport AnnDistanceFieldFont
+	{
+	public:
+		///Position of a glyph in the texture
+		struct Glyph
+		{
+			///Left side of the cell, including the spread
+			float u0;
+			///Top side of the cell, including the spread
+			float v0;
+			///Right side of the cell, including the spread
+			float u1;
+			///Bottom side of the cell, including the spread
+			float v1;
+			///Width of the glyph, in pixels of the font, without the spread
+			uint16_t width;
+			///Height of the glyph, in pixels of the font, without the spread
+			uint16_t height;
+		};
+
+		///Compute the distance field of every glyph of the font and upload it. Use get() to share them
+		/// \param font The font
+		/// \param spread Distance, in pixels, covered by the field on each side of the outline
+		AnnDistanceFieldFont(Ogre::Font* font, uint16_t spread = 4);
+
+		///Remove the texture
+		~AnnDistanceFieldFont();
+
+		///This class own a texture, it cannot be copied
+		AnnDistanceFieldFont(const AnnDistanceFieldFont&) = delete;
+		///This class own a texture, it cannot be copied
+		AnnDistanceFieldFont& operator=(const AnnDistanceFieldFont&) = delete;
+
+		///Get the distance field of a font, build it if needed. Main thread only
+		static const AnnDistanceFieldFont& get(Ogre::Font* font);
+
+		///Forget every cached distance field. Called when the engine stops
+		static void clearCache();
+
+		///Get the glyph of a character. Characters that are not in the font have an empty glyph
+		const Glyph& getGlyph(char c) const { return glyphs[uint8_t(c)]; }
+
+		///Distance, in pixels, covered by the field on each side of the outline
+		uint16_t getSpread() const { return spread; }
+
+		///Texture holding the distance fields, white with the field in the alpha channel
+		Ogre::TexturePtr getTexture() const { return texture; }
+
+		///Compute the distance field of a glyph. Pixels with a coverage of 128 or more are inside.
+		/// \param coverage width * height bytes of coverage
+		/// \param width Width of the glyph
+		/// \param height Height of the glyph
+		/// \param spread Distance covered by the field on each side of the outline
+		/// \param field (width + 2 * spread) * (height + 2 * spread) bytes, the glyph is centered in it
+		static void computeDistanceField(const uint8_t* coverage, size_t width, size_t height, uint16_t spread, uint8_t* field);
+
+	private:
+		///Handle of the font, to detect another font created at the same address
+		Ogre::ResourceHandle fontHandle;
+		///Distance covered by the field on each side of the outline
+		uint16_t spread;
+		///Texture holding the distance fields
+		Ogre::TexturePtr texture;
+		///Glyph of each 8 bits character
+		std::array<Glyph, 256> glyphs;
+	};
+}
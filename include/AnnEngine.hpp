@@ -21,6 +21,10 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <iomanip>
 
 //Annwvyn
 #include "AnnTypes.h"
@@ -39,6 +43,7 @@
 #include "AnnStringUtility.hpp"
 #include "AnnPlayerBody.hpp"
 #include "AnnDynamicLibraryHolder.hpp"
+#include "AnnLogger.hpp"
 
 #ifdef _WIN32
 #include <io.h>
@@ -89,6 +94,10 @@ namespace Annwvyn
 		///scope
 		AnnEngineSingletonReseter resetGuard;
 
+		///Writes the log in the background. Declared just after resetGuard, so it is still running while everything else shuts down
+		std::unique_ptr<AnnLogger> logger;
+		friend class AnnLogger;
+
 		///Private method that configure the rendering from the two given strings. It may call itself again with modified strings in circumstances.
 		void selectAndCreateRenderer(const std::string& hmd, const std::string& title);
 
@@ -133,7 +142,8 @@ namespace Annwvyn
 		///Class destructor. Do clean up stuff.
 		~AnnEngine();
 
-		///Log something to the console. If flag = true (by default), will print "Annwvyn - " in front of the message
+		///Log something to the console. If flag = true (by default), will print "Annwvyn - " in front of the message.
+		///The message is written by the logger thread, and shown on the console at the next frame
 		/// \param message Message to be logged
 		/// \param flag If true : Put the "Annwvyn -" flag before the message
 		static void writeToLog(std::string message, bool flag = true); //engine
@@ -213,7 +223,7 @@ namespace Annwvyn
 		///Return true if the app is visible inside the head mounted display
 		bool appVisibleInHMD() const;
 
-		///Get elapsed time from engine startup in millisecond
+		///Get elapsed time from engine startup in millisecond. While input is recorded or replayed, it's the clock of the current frame
 		unsigned long getTimeFromStartUp() const; //engine
 
 		///Get elapsed time from engine startup in seconds
@@ -222,6 +232,9 @@ namespace Annwvyn
 		///Get elapsed time between two frames in seconds
 		double getFrameTime() const;
 
+		///Get the time spent in each step of the engine startup, in milliseconds, in the order they happened
+		const std::vector<std::pair<std::string, double>>& getStartupTimings() const;
+
 		///Get the pose of the HMD in VR world space
 		DEPRECATED AnnPose getHmdPose() const;
 
@@ -272,6 +285,12 @@ namespace Annwvyn
 		///If true, should quit the app ASAP
 		bool applicationQuitRequested;
 
+		///Display the messages written by the logger since the last frame on the console
+		void writeDeferredLog() const;
+
+		///Write the startup time breakdown to the log
+		void logStartupTimings(double total) const;
+
 		///loaded libraries
 		static std::vector<AnnUniqueDynamicLibraryHolder> dynamicLibraries;
 
@@ -312,5 +331,8 @@ namespace Annwvyn
 
 		///Container for all the subsystem. Populated in the update/delete order
 		std::vector<AnnSubSystemPtr> subsystems;
+
+		///Name and duration in milliseconds of each startup step
+		std::vector<std::pair<std::string, double>> startupTimings;
 	};
 }
@@ -20,21 +20,21 @@ namespace Annwvyn
 		///Construct a listener
 		AnnEventListener();
 		///Event from the keyboard
-		virtual void KeyEvent(AnnKeyEvent e) {}
+		virtual void KeyEvent(const AnnKeyEvent& e) {}
 		///Event from the mouse
-		virtual void MouseEvent(AnnMouseEvent e) {}
+		virtual void MouseEvent(const AnnMouseEvent& e) {}
 		///Event for a Joystick
-		virtual void ControllerEvent(AnnControllerEvent e) {}
+		virtual void ControllerEvent(const AnnControllerEvent& e) {}
 		///Event from a timer
-		virtual void TimeEvent(AnnTimeEvent e) {}
+		virtual void TimeEvent(const AnnTimeEvent& e) {}
 		///Event from a trigger
-		virtual void TriggerEvent(AnnTriggerEvent e) {}
+		virtual void TriggerEvent(const AnnTriggerEvent& e) {}
 		///Event from an HandController
-		virtual void HandControllerEvent(AnnHandControllerEvent e) {}
+		virtual void HandControllerEvent(const AnnHandControllerEvent& e) {}
 		///Event from detected collisions
-		virtual void CollisionEvent(AnnCollisionEvent e) {}
+		virtual void CollisionEvent(const AnnCollisionEvent& e) {}
 		///Event from detected player collisions
-		virtual void PlayerCollisionEvent(AnnPlayerCollisionEvent e) {}
+		virtual void PlayerCollisionEvent(const AnnPlayerCollisionEvent& e) {}
 		///Events from code outside of Annwvyn itself
 		virtual void EventFromUserSubsystem(AnnUserSpaceEvent& e, AnnUserSpaceEventLauncher* origin) {}
 		///This method is called at each frame. Useful for updating player's movement command for example
@@ -17,6 +17,9 @@
 #include "AnnEvents.hpp"
 #include "AnnUserSpaceSubSystem.hpp"
 #include "AnnTextInputer.hpp"
+#include "AnnInputThread.hpp"
+#include "AnnInputRecorder.hpp"
+#include "AnnInputReplay.hpp"
 #include "AnnEventListener.hpp"
 
 ///Macro for declaring a listener
@@ -41,7 +44,7 @@ namespace Annwvyn
 	//You'll crash the engine if you destroy a listener without removing it from the EventManager (the EM will dereference an non-existing pointer)
 
 	///Event Manager : Object that handle the event system
-	class AnnDllExport AnnEventManager : public AnnSubSystem
+	class AnnDllExport AnnEventManager : public AnnSubSystem, private OIS::KeyListener
 	{
 	public:
 		///Construct the event manager
@@ -97,6 +100,35 @@ namespace Annwvyn
 		void keyboardUsedForText(bool state = true);
 		//---------------------------- other
 
+		//---------------------------- input thread
+		///Capture the keyboard, the mouse and the sticks on a separate thread instead of once per frame. Changes are timed when they are
+		///captured (see AnnEvent::getTime()), and quick presses between two frames are not lost. The events are still sent during update().
+		///Hand controllers are still read once per frame, as they are updated with the head tracking
+		/// \param frequency Captures per second
+		void startInputThread(double frequency = 500);
+		///Go back to capturing input once per frame
+		void stopInputThread();
+		///Return true if input is captured by the input thread
+		bool isInputThreadRunning() const;
+		//---------------------------- input thread
+
+		//---------------------------- input recording
+		///Record, every frame, the frame time, the head pose, the hand controllers and the changes of the keyboard, the mouse and the sticks.
+		///Play the file back with the "Replay" renderer (see AnnOgreReplayRenderer) to run the same session again without the user
+		/// \param fileName Recording to write. Return false if it can't be opened
+		bool startInputRecording(const std::string& fileName);
+		///Write what is buffered and close the recording
+		void stopInputRecording();
+		///Return true if input is being recorded
+		bool isRecordingInput() const;
+		///Return true if input comes from a recording instead of the devices
+		bool isReplayingInput() const;
+		///While input is recorded or replayed, the engine time doesn't move during a frame : it is the clock stored with the frame, so the
+		///timers of a replay run on the same times as the recorded session. Return false if input isn't recorded or replayed
+		/// \param clock Set to the clock of the current frame, in seconds
+		bool getRecordedClock(double& clock) const;
+		//---------------------------- input recording
+
 		OIS::InputManager* _getOISInputManager();
 
 	private:
@@ -115,12 +147,32 @@ namespace Annwvyn
 		void update() override;
 		///Capture the event from OIS
 		void captureEvents();
-		///Process keyboard events
-		void processKeyboardEvents();
+		///Current time on the engine clock, in seconds, with sub millisecond precision
+		static double getInputTime();
+		///OIS callback, called during capture for each key pressed since the last capture, in order
+		bool keyPressed(const OIS::KeyEvent& arg) override;
+		///OIS callback, called during capture for each key released since the last capture, in order
+		bool keyReleased(const OIS::KeyEvent& arg) override;
+		///Add a key event to the buffer if the key changed state
+		void bufferKeyEvent(OIS::KeyCode key, bool pressed, double time);
 		///Process mouse events
 		void processMouseEvents();
-		///Process joystick events
+		///Point the event of a stick to its state
+		void setupControllerEvent(AnnControllerBuffer& joystick);
+		///Set the state of a stick button. A change is added to the press or release list
+		void setStickButton(size_t stick, size_t button, bool down, double time);
+		///Set the state of a stick axis
+		void setStickAxis(size_t stick, size_t axis, int abs, int rel, double time);
+		///Set the direction of a stick PoV
+		void setStickPov(size_t stick, size_t pov, int direction, double time);
+		///Update the state of the sticks in place from what OIS captured
 		void processJoystickEvents();
+		///Apply an input change, captured or replayed
+		void processSample(const AnnInputSample& sample, double time);
+		///Create the events from what the input thread captured since the last frame
+		void processSampledInput();
+		///Create the events from the input changes of the replayed frame
+		void processReplayedInput();
 		///Process hand controller events
 		void processHandControllerEvents();
 		///Set the content of the event buffers to all registered listeners
@@ -144,8 +196,8 @@ namespace Annwvyn
 		std::vector<AnnKeyEvent> keyEventBuffer;
 		///Buffer of mouse events
 		std::vector<AnnMouseEvent> mouseEventBuffer;
-		///Buffer of stick events
-		std::vector<AnnControllerEvent> stickEventBuffer;
+		///Sticks that changed this frame. The events are owned by the stick buffers
+		std::vector<const AnnControllerEvent*> stickEventBuffer;
 		///Buffer of hand controller events
 		std::vector<AnnHandControllerEvent> handControllerEventBuffer;
 
@@ -161,8 +213,8 @@ namespace Annwvyn
 		//----------------------- OIS and other library input objects
 
 		//----------------------- PREVIOUS STATE FOR EVENT DETECTION FROM UNBUFFERED STATE
-		///Array for remembering the key states at last update.
-		std::array<bool, KeyCode::SIZE> previousKeyStates;
+		///State of each key, as known from the buffered events. Repeated presses of a held key are dropped
+		std::array<bool, KeyCode::SIZE> keyStates;
 		///Array for remembering the button states at last update
 		std::array<bool, ButtonCount> previousMouseButtonStates;
 		//----------------------- PREVIOUS STATE FOR EVENT DETECTION FROM UNBUFFERED STATE
@@ -180,9 +232,9 @@ namespace Annwvyn
 
 		//----------------------- COLLISION MANAGEMENT
 		///Collision reported by the physics engine to consider
-		std::vector<std::tuple<void*, void*, AnnVect3, AnnVect3>> collisionBuffers;
+		std::vector<std::tuple<AnnGameObjectHandle, AnnGameObjectHandle, AnnVect3, AnnVect3>> collisionBuffers;
 		///Player collision reported by the physics engine to consider
-		std::vector<AnnGameObject*> playerCollisionBuffer;
+		std::vector<AnnGameObjectHandle> playerCollisionBuffer;
 		//----------------------- COLLISION MANAGEMENT
 
 		///The text inputer object itself
@@ -198,6 +250,16 @@ namespace Annwvyn
 		bool knowXbox;
 		///True if keyboard event should be ignored (keyboard used for "text input")
 		bool keyboardIgnore;
+		///Time of the last capture done on the main thread
+		double inputTime;
+		///Capture thread, if running
+		std::unique_ptr<AnnInputThread> inputThread;
+		///Mouse state built from the input samples
+		AnnMouseEvent sampledMouse;
+		///Input recording, if any
+		AnnInputRecorder inputRecorder;
+		///Recording input is taken from, if the renderer is replaying one
+		AnnInputReplay* inputReplay;
 	};
 
 	using AnnEventManagerPtr = std::shared_ptr<AnnEventManager>;
@@ -4,6 +4,8 @@
 #include "AnnUserSpaceEvent.hpp"
 #include "AnnKeyCode.h"
 #include "AnnHandController.hpp"
+#include "AnnFrameArena.hpp"
+#include "AnnGameObjectHandle.hpp"
 
 namespace Annwvyn
 {
@@ -27,9 +29,14 @@ namespace Annwvyn
 		///Event constructor
 		AnnEvent();
 		AnnEventType getType() const;
+		///For input events, when the input was captured, in seconds on the engine clock (see AnnEngine::getTimeFromStartupSeconds).
+		///With the input thread running, this is more precise than the frame. 0 for the other events
+		double getTime() const;
 
 	protected:
 		AnnEventType type;
+		///When the input was captured
+		double time;
 		friend class AnnEventManager;
 	};
 
@@ -127,11 +134,11 @@ namespace Annwvyn
 		AnnMouseEvent();
 		///Returns true if given button is pressed
 		/// \param id Id of the button
-		bool getButtonState(MouseButtonId id);
+		bool getButtonState(MouseButtonId id) const;
 
 		///Get given axis data
 		/// \param id Id of the axis
-		AnnMouseAxis getAxis(MouseAxisID id);
+		AnnMouseAxis getAxis(MouseAxisID id) const;
 
 	private:
 		AnnMouseAxis axes[AxisCount];
@@ -236,7 +243,9 @@ namespace Annwvyn
 		AnnControllerPov(unsigned int binaryDirection);
 	};
 
-	///A joystick event
+	///A joystick event. Only sent on the frames where a button, an axis or a PoV of the stick changed.
+	///The arrays of the event live in the state of the stick kept by the event manager, and are rewritten at the next capture. Don't keep
+	///a copy of the event after the end of the event method, copy the values you need instead.
 	class AnnDllExport AnnControllerEvent : public AnnEvent
 	{
 	public:
@@ -249,28 +258,28 @@ namespace Annwvyn
 		size_t getNbButtons() const;
 
 		///Get the list of pressed buttons
-		std::vector<unsigned short> getPressed() const;
+		AnnSpan<const unsigned short> getPressed() const;
 		///Get the list of released buttons
-		std::vector<unsigned short> getReleased() const;
+		AnnSpan<const unsigned short> getReleased() const;
 
 		///Return true if this button just have been pressed
-		bool isPressed(ButtonId id);
+		bool isPressed(ButtonId id) const;
 		///Return true if this button just have been released
-		bool isReleased(ButtonId id);
+		bool isReleased(ButtonId id) const;
 		///Return true if this button is currently pressed
-		bool isDown(ButtonId id);
+		bool isDown(ButtonId id) const;
 		///Get the axis object for this ID
-		AnnControllerAxis getAxis(ControllerAxisID ax);
+		AnnControllerAxis getAxis(ControllerAxisID ax) const;
 		///Get the number of axes the controller has
 		size_t getAxisCount() const;
 		///Get the unique ID given by Annwvyn for this stick
 		ControllerID getControllerID() const;
 		///Get the "vendor string" of this joystick (could be its name)
-		std::string getVendor() const;
+		const std::string& getVendor() const;
 		///Get the number of PoV controller on this one
 		size_t getPovCount() const;
 		///Get the PoV corresponding to this ID
-		AnnControllerPov getPov(PovId pov);
+		AnnControllerPov getPov(PovId pov) const;
 
 		///Return true if this event is from an Xbox controller
 		bool isXboxController() const;
@@ -280,17 +289,17 @@ namespace Annwvyn
 		bool xbox;
 		friend class AnnEventManager;
 		///Button array
-		std::vector<byte> buttons;
+		AnnSpan<byte> buttons;
 		///Axis array
-		std::vector<AnnControllerAxis> axes;
+		AnnSpan<AnnControllerAxis> axes;
 		///Pov Array
-		std::vector<AnnControllerPov> povs;
+		AnnSpan<AnnControllerPov> povs;
 		///Pressed event "queue"
-		std::vector<unsigned short> pressed;
+		AnnSpan<unsigned short> pressed;
 		///Released event "queue"
-		std::vector<unsigned short> released;
-		///Joystick "vendor" name (generally the brand and model)
-		std::string vendor;
+		AnnSpan<unsigned short> released;
+		///Joystick "vendor" name (generally the brand and model). Owned by the joystick
+		const std::string* vendor;
 		///Joystick ID for the engine
 		int stickID;
 	};
@@ -363,13 +372,19 @@ namespace Annwvyn
 	{
 	public:
 		///Event constructor
-		AnnCollisionEvent(AnnGameObject* first, AnnGameObject* second, AnnVect3 position, AnnVect3 normal);
+		AnnCollisionEvent(AnnGameObjectHandle first, AnnGameObjectHandle second, AnnVect3 position, AnnVect3 normal);
 		///Check if this event is about that object
 		bool hasObject(AnnGameObject* obj) const;
-		///Get first object
+		///Check if this event is about that object
+		bool hasObject(AnnGameObjectHandle obj) const;
+		///Get first object. nullptr if it has been removed since the collision
 		AnnGameObject* getA() const;
-		///Get second object
+		///Get second object. nullptr if it has been removed since the collision
 		AnnGameObject* getB() const;
+		///Get a handle to the first object
+		AnnGameObjectHandle getHandleA() const;
+		///Get a handle to the second object
+		AnnGameObjectHandle getHandleB() const;
 		///Get the position of the "contact point" from that collision
 		AnnVect3 getPosition() const;
 		///Get the normal on the "B" body at the "contact point"
@@ -386,8 +401,8 @@ namespace Annwvyn
 		bool isCeilingCollision(const float scalarApprox = 0.125) const;
 
 	private:
-		///Some naked pointers
-		AnnGameObject *a, *b;
+		///Handles to the objects, they can be removed by a listener before the others get the event
+		AnnGameObjectHandle a, b;
 		const AnnVect3 position, normal;
 	};
 
@@ -396,13 +411,15 @@ namespace Annwvyn
 	{
 	public:
 		///Constructor
-		AnnPlayerCollisionEvent(AnnGameObject* collided);
-		///Get the object this event is about
+		AnnPlayerCollisionEvent(AnnGameObjectHandle collided);
+		///Get the object this event is about. nullptr if it has been removed since the collision
 		AnnGameObject* getObject() const;
+		///Get a handle to the object this event is about
+		AnnGameObjectHandle getObjectHandle() const;
 
 	private:
-		///Naked pointer to the collider
-		AnnGameObject* col;
+		///Handle to the collider
+		AnnGameObjectHandle col;
 	};
 
 	///Trigger in/out event
@@ -464,8 +481,22 @@ namespace Annwvyn
 	private:
 		///Joystick object from OIS. Deleted by constructor
 		OIS::JoyStick* oisJoystick;
-		///Array of "bool" for previous buttons
-		std::vector<byte> previousStickButtonStates;
+		///State of the buttons, updated in place at each capture
+		std::vector<byte> buttons;
+		///State of the axes, updated in place at each capture
+		std::vector<AnnControllerAxis> axes;
+		///State of the PoVs, updated in place at each capture
+		std::vector<AnnControllerPov> povs;
+		///Raw direction of each PoV, to detect changes
+		std::vector<int> povDirections;
+		///Buttons pressed during the last capture. Sized for every button to be pressed at once
+		std::vector<unsigned short> pressed;
+		///Buttons released during the last capture. Sized for every button to be released at once
+		std::vector<unsigned short> released;
+		///Set when something changed this frame
+		bool changed;
+		///Event sent to the listeners. Its arrays point to the state above
+		AnnControllerEvent event;
 		///Get the ID if this stick
 		unsigned int getID() const { return id; }
 		///The ID
@@ -0,0 +1,108 @@
+/**
+* \file AnnFrameArena.hpp
+* \brief Memory that lives for one frame, and views over it
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Annwvyn
+{
+	///Non owning view over a contiguous array
+	template <class T>
+	class AnnSpan
+	{
+	public:
+		///Empty span
+		AnnSpan() :
+		 first(nullptr), count(0) {}
+
+		///View over count elements starting at data
+		AnnSpan(T* data, size_t count) :
+		 first(data), count(count) {}
+
+		///Pointer to the first element
+		T* data() const { return first; }
+		///Number of elements
+		size_t size() const { return count; }
+		///Return true if there is no element
+		bool empty() const { return count == 0; }
+		///Access an element. Not bound checked
+		T& operator[](size_t index) const { return first[index]; }
+		///Start of the range
+		T* begin() const { return first; }
+		///End of the range
+		T* end() const { return first + count; }
+
+	private:
+		///First element
+		T* first;
+		///Number of elements
+		size_t count;
+	};
+
+	///Bump allocator for data that only lives for one frame.
+	///Memory is taken from big blocks, and given back all at once by reset(). The blocks are kept for the next frame, so once
+	///the arena has grown to the size needed by a frame it doesn't allocate anymore.
+	///Only trivially destructible objects can live here, as nothing is ever destructed.
+	class AnnDllExport AnnFrameArena
+	{
+	public:
+		///Construct an arena. Memory is requested from the system blockSize bytes at a time
+		AnnFrameArena(size_t blockSize = 16 * 1024);
+
+		///Memory given by the arena is pointed to, it cannot be copied
+		AnnFrameArena(const AnnFrameArena&) = delete;
+		///Memory given by the arena is pointed to, it cannot be copied
+		AnnFrameArena& operator=(const AnnFrameArena&) = delete;
+
+		///Get an array of count default constructed objects
+		template <class T>
+		AnnSpan<T> allocate(size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Objects in a frame arena are never destructed");
+			auto storage = static_cast<T*>(allocateBytes(sizeof(T) * count, alignof(T)));
+			for(size_t i{ 0 }; i < count; ++i) new(storage + i) T();
+			return { storage, count };
+		}
+
+		///Get a copy of an array
+		template <class T>
+		AnnSpan<T> copy(const T* source, size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Objects in a frame arena are never destructed");
+			auto storage = static_cast<T*>(allocateBytes(sizeof(T) * count, alignof(T)));
+			for(size_t i{ 0 }; i < count; ++i) new(storage + i) T(source[i]);
+			return { storage, count };
+		}
+
+		///Forget everything allocated since the last reset. Every span given by the arena becomes invalid
+		void reset();
+
+		///Number of bytes reserved from the system
+		size_t getCapacity() const;
+
+	private:
+		///Get raw memory
+		void* allocateBytes(size_t size, size_t alignment);
+
+		///Memory blocks
+		std::vector<std::unique_ptr<unsigned char[]>> blocks;
+		///Size of each memory block
+		std::vector<size_t> blockSizes;
+		///Size of a new block
+		const size_t blockSize;
+		///Index of the block being filled
+		size_t currentBlock;
+		///Bytes used in the current block
+		size_t offset;
+	};
+}
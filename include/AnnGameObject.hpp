@@ -13,13 +13,17 @@
 //Annwvyn
 #include "AnnTypes.h"
 #include "AnnAbstractMovable.hpp"
+#include "AnnGameObjectHandle.hpp"
 #pragma warning(default : 4996)
 
 namespace Annwvyn
 {
 	class AnnDllExport AnnGameObjectManager;
 	class AnnBehaviorScript;
+	class AnnNativeBehavior;
 	class AnnAudioSource;
+	class AnnObjectRecycler;
+	class AnnPrefabPool;
 
 	///An object that exist in the game. Graphically and Potentially Physically
 	class AnnDllExport AnnGameObject : public AnnAbstractMovable
@@ -170,10 +174,28 @@ namespace Annwvyn
 		///Return the name of the object
 		std::string getName() const;
 
-		///Attach a script to this object
+		///Return the name of the mesh this object was created from
+		const std::string& getMeshName() const;
+
+		///Get a handle to this object. It becomes invalid once the object is removed from the game object manager
+		AnnGameObjectHandle getHandle() const;
+
+		///Put the object in or out of the game. An inactive object is invisible, it's body is out of the physics world,
+		///and it's scripts and behaviors are neither updated nor receive events
+		void setActive(bool state);
+
+		///Return true if the object is in the game
+		bool isActive() const;
+
+		///Attach a script to this object. If a native behavior is registered with that name, it is used instead of a ChaiScript file
 		/// \param scriptName name of a script
 		void attachScript(const std::string& scriptName);
 
+		///Attach a script to this object. The script runs inside a concurrent script domain, and is updated by it
+		/// \param scriptName name of a script
+		/// \param domainName name of the script domain, created if needed
+		void attachScript(const std::string& scriptName, const std::string& domainName);
+
 		///Return true if node is attached to the node owned by another AnnGameObject
 		bool hasParent() const;
 
@@ -182,7 +204,7 @@ namespace Annwvyn
 
 		///Attach an object to this object.
 		/// \param child The object you want to attach
-		void attachChildObject(std::shared_ptr<AnnGameObject> child) const;
+		void attachChildObject(const std::shared_ptr<AnnGameObject>& child) const;
 
 		///Make the node independent to any GameObject
 		void detachFromParent() const;
@@ -197,8 +219,12 @@ namespace Annwvyn
 		///The GameObjectManager populate the content of this object when it goes through it's initialization
 		friend class AnnEngine;
 		friend class AnnGameObjectManager;
+		friend class AnnPrefabPool;
 
 		//------------------ local utility
+		///Put the rigid body in the physics world, with the collision masks given to setupPhysics
+		void addBodyToWorld() const;
+
 		///Do the actual recursion of checkForBodyInParent
 		/// \param obj object to check (for recursion)
 		bool parentsHaveBody(AnnGameObject* obj) const;
@@ -247,12 +273,36 @@ namespace Annwvyn
 		///Name of the object
 		std::string name;
 
+		///Mesh the object was created from
+		std::string meshName;
+
+		///Pool that takes the node, item and audio source of this object when it's destroyed, if recycling is enabled
+		std::weak_ptr<AnnObjectRecycler> recycler;
+
+		///Slot of this object in the game object manager
+		AnnSlotHandle slot;
+
+		///False if the object has been taken out of the game by setActive
+		bool active;
+
+		///If the body collides with the player's body
+		bool bodyColideWithPlayer;
+
+		///Pool of the prefab this object is an instance of, if any
+		AnnPrefabPool* prefabPool;
+
 		///RigidBodyState of this object
 		BtOgre::RigidBodyState* state;
 
 		///list of script objects
 		std::vector<std::shared_ptr<AnnBehaviorScript>> scripts;
 
+		///list of script objects living in a concurrent script domain. They are updated by their domain, not by this object
+		std::vector<std::shared_ptr<AnnBehaviorScript>> domainScripts;
+
+		///list of native behaviors. They are updated by their pool, not by this object
+		std::vector<std::shared_ptr<AnnNativeBehavior>> nativeBehaviors;
+
 	public:
 		///Executed after object initialization
 		virtual void postInit() {}
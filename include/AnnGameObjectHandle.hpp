@@ -0,0 +1,58 @@
+/**
+* \file AnnGameObjectHandle.hpp
+* \brief Lightweight non owning reference to a game object
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <memory>
+
+#include "AnnSlotMap.hpp"
+
+namespace Annwvyn
+{
+	class AnnGameObject;
+
+	///Non owning reference to a game object, made of the index and generation of it's slot in the game object manager.
+	///Copying a handle doesn't touch any reference counter. A handle can be checked in constant time: once the object is removed
+	///from the manager, it resolves to nullptr, even if a new object takes the same slot.
+	///Use AnnGameObjectPtr only where the object needs to be kept alive.
+	class AnnDllExport AnnGameObjectHandle
+	{
+	public:
+		///Construct a handle that doesn't reference anything
+		AnnGameObjectHandle() = default;
+
+		///Construct a handle to a slot of the game object manager
+		explicit AnnGameObjectHandle(AnnSlotHandle slot);
+
+		///Get the object, or nullptr if it isn't in the game object manager anymore
+		AnnGameObject* get() const;
+
+		///Access the object. Throws AnnNullGameObjectError if it isn't in the game object manager anymore
+		AnnGameObject* operator->() const;
+
+		///Return true if the object is still in the game object manager
+		bool isValid() const;
+
+		///Return true if the object is still in the game object manager
+		explicit operator bool() const;
+
+		///Get an owning pointer to the object, or nullptr if it isn't in the game object manager anymore
+		std::shared_ptr<AnnGameObject> lock() const;
+
+		///Get the slot referenced by this handle
+		AnnSlotHandle getSlot() const;
+
+		///Compare two handles
+		bool operator==(const AnnGameObjectHandle& other) const;
+		///Compare two handles
+		bool operator!=(const AnnGameObjectHandle& other) const;
+
+	private:
+		///Slot of the object
+		AnnSlotHandle slot;
+	};
+}
@@ -3,11 +3,18 @@
 #include "systemMacro.h"
 #include "AnnSubsystem.hpp"
 #include "AnnTypes.h"
+#include "AnnObjectRecycler.hpp"
+#include "AnnSlotMap.hpp"
+#include "AnnGameObjectHandle.hpp"
+#include "AnnPrefab.hpp"
+#include "AnnInstancedMesh.hpp"
+#include "AnnMeshCache.hpp"
 
 #include <OgreMesh.h>
 #include <OgreMesh2.h>
 
 #include <memory>
+#include <vector>
 
 namespace Annwvyn
 {
@@ -20,11 +27,16 @@ namespace Annwvyn
 	public:
 		AnnGameObjectManager();
 
+		///Destroy the manager. Handles to game objects resolve to nullptr from now on
+		~AnnGameObjectManager();
+
 		///Update from the game engine
 		void update() override;
 
-		///Get a MeshPtr by loading a v1Mesh ptr, specify the name and where to put the 2 pointers
-		Ogre::MeshPtr getAndConvertFromV1Mesh(const char* meshName, Ogre::v1::MeshPtr& v1Mesh, Ogre::MeshPtr& v2Mesh) const;
+		///Get a MeshPtr by loading a v1Mesh ptr, specify the name and where to put the 2 pointers.
+		///The conversion is read from the mesh cache when possible. The v1 mesh is unloaded once converted, so v1Mesh is always null.
+		///If `source` is set, it is the content of the mesh file, already read, and the file is not opened again
+		Ogre::MeshPtr getAndConvertFromV1Mesh(const char* meshName, Ogre::v1::MeshPtr& v1Mesh, Ogre::MeshPtr& v2Mesh, Ogre::DataStreamPtr source = Ogre::DataStreamPtr()) const;
 
 		///Create a game object form the name of an entity.
 		/// \param mesh Name of an mesh loaded to the Ogre ResourceGroupManager
@@ -32,9 +44,20 @@ namespace Annwvyn
 		std::shared_ptr<AnnGameObject> createGameObject(const std::string& mesh, std::string identifier = "",
 														std::shared_ptr<AnnGameObject> object = std::make_shared<AnnGameObject>()); //object factory
 
-		///Remove object from the manager. Object will be destroyed when no more references are in scope
+		///Remove object from the manager in constant time. Object will be destroyed when no more references are in scope.
+		///If called while the objects are updated, the object is removed at the end of the update
 		/// \param object the object to remove
-		void removeGameObject(std::shared_ptr<AnnGameObject> object);
+		void removeGameObject(const std::shared_ptr<AnnGameObject>& object);
+
+		///Remove the object referenced by this handle from the manager, if it's still there
+		/// \param handle handle to the object to remove
+		void removeGameObject(AnnGameObjectHandle handle);
+
+		///Get the object referenced by a handle, or nullptr if it has been removed. Constant time, doesn't touch any reference counter
+		static AnnGameObject* resolve(AnnGameObjectHandle handle);
+
+		///Get an owning pointer to the object referenced by a handle, or nullptr if it has been removed
+		static std::shared_ptr<AnnGameObject> resolveShared(AnnGameObjectHandle handle);
 
 		///Search for an AnnGameObject that holds this node, returns it if found. Return nullptr if not found.
 		std::shared_ptr<AnnGameObject> getFromNode(Ogre::SceneNode* node);
@@ -56,7 +79,22 @@ namespace Annwvyn
 		std::shared_ptr<AnnGameObject> playerLookingAt(unsigned short limit = 5); //physics
 
 		///Get an AnnGameObject for the required string; return nullptr if object cannot be found
-		std::shared_ptr<AnnGameObject> getGameObject(std::string gameObjectName);
+		std::shared_ptr<AnnGameObject> getGameObject(const std::string& gameObjectName) const;
+
+		///Get a handle to the AnnGameObject with that name. The handle is invalid if the object cannot be found
+		AnnGameObjectHandle getGameObjectHandle(const std::string& gameObjectName) const;
+
+		///Create an empty set of instances of a mesh, drawn with hardware instancing.
+		/// \param mesh Name of an mesh loaded to the Ogre ResourceGroupManager
+		/// \param identifier Name of the set. Generated if empty
+		/// \param isStatic If true, the instances are in static scene memory, and cost nothing per frame while they don't move
+		std::shared_ptr<AnnInstancedMesh> createInstancedMesh(const std::string& mesh, std::string identifier = "", bool isStatic = true);
+
+		///Destroy a set of instances
+		void removeInstancedMesh(const std::shared_ptr<AnnInstancedMesh>& instancedMesh);
+
+		///Get a set of instances from it's name; return nullptr if not found
+		std::shared_ptr<AnnInstancedMesh> getInstancedMesh(const std::string& instancedMeshName) const;
 
 		///Get an AnnLightObject from it's name; return nullptr if object not found
 		std::shared_ptr<AnnLightObject> getLightObject(std::string lightObjectName);
@@ -67,18 +105,73 @@ namespace Annwvyn
 		///Set the options to pass while converting Ogre V1 meshes to Ogre V2 meshes
 		void setImportParameter(bool halfPosition, bool halfTextureCoord, bool qTangents);
 
+		///Store converted meshes in this directory. An empty path disables the cache.
+		///By default, the cache is in the "MeshCache" folder of the save directory
+		void setMeshCacheDirectory(const std::string& directory);
+
+		///Get the mesh cache, or nullptr if it is disabled
+		AnnMeshCache* getMeshCache() const;
+
+		///If enabled, destroyed game objects leave their node, item and audio source in a pool.
+		///Objects created later from the same mesh reuse them instead of creating new ones. Disabling it empties the pool
+		void setObjectRecycling(bool recycle);
+
+		///Return true if objects are recycled
+		bool getObjectRecycling() const;
+
+		///Destroy every recycled object that wasn't reused yet
+		void clearRecycledObjects() const;
+
+		///Number of recycled objects waiting to be reused
+		size_t getRecycledObjectCount() const;
+
+		///Register a prefab, and create `preallocate` instances of it now. Throws AnnInitializationError if the name is already taken
+		/// \param name Name used to spawn the prefab
+		/// \param prefab Description of the instances
+		/// \param preallocate Number of instances to create in advance
+		void registerPrefab(const std::string& name, const AnnPrefab& prefab, size_t preallocate = 16);
+
+		///Put an instance of a prefab in the game. Throws AnnInitializationError if the prefab isn't registered
+		std::shared_ptr<AnnGameObject> spawn(const std::string& prefabName, AnnVect3 position, AnnQuaternion orientation = AnnQuaternion::IDENTITY);
+
+		///Take an instance of a prefab out of the game. Objects that aren't instances of a prefab are removed
+		void despawn(const std::shared_ptr<AnnGameObject>& object);
+
+		///Get the pool of a prefab, or nullptr if the prefab isn't registered
+		AnnPrefabPool* getPrefabPool(const std::string& prefabName) const;
+
 	private:
 		friend class AnnEngine;
+		friend class AnnPrefabPool;
+
+		///Give an object a slot and a name in the manager
+		void track(const std::shared_ptr<AnnGameObject>& object);
+
+		///Take an object out of the manager without destroying it. Return false if it wasn't there
+		bool untrack(const std::shared_ptr<AnnGameObject>& object);
 
-		///Dynamic container for triggers objects present in engine.
-		AnnTriggerObjectList Triggers;
-		///Dynamic container for lights objects present in engine.
-		AnnLightList Lights;
-		///Dynamic container for Game objects present in engine
-		AnnGameObjectList Objects;
+		///Pool of recycled objects. Null if recycling is disabled. Declared first so the objects are destroyed before it
+		AnnObjectRecyclerPtr recycler;
 
-		///objects mapped to ID strings
-		std::unordered_map<std::string, std::shared_ptr<AnnGameObject>> identifiedObjects;
+		///Dynamic container for triggers objects present in engine. Removal is constant time
+		AnnSlotMap<AnnTriggerObject> Triggers;
+		///Dynamic container for lights objects present in engine. Removal is constant time
+		AnnSlotMap<AnnLightObject> Lights;
+		///Dynamic container for Game objects present in engine. Removal is constant time
+		AnnSlotMap<AnnGameObject> Objects;
+		///Dynamic container for sets of instanced meshes. Removal is constant time
+		AnnSlotMap<AnnInstancedMesh> InstancedMeshes;
+
+		///Set while update() goes through the objects
+		bool updatingObjects;
+		///Objects removed while updatingObjects was set
+		std::vector<std::shared_ptr<AnnGameObject>> pendingRemovals;
+
+		///objects mapped to ID strings. The map doesn't own them
+		std::unordered_map<std::string, AnnGameObjectHandle> identifiedObjects;
+
+		///Objects of the running manager, used to resolve handles
+		static AnnSlotMap<AnnGameObject>* liveObjects;
 
 		///lights mapped to ID strings
 		std::unordered_map<std::string, std::shared_ptr<AnnLightObject>> identifiedLights;
@@ -86,10 +179,23 @@ namespace Annwvyn
 		///triggers identified to ID string
 		std::unordered_map<std::string, std::shared_ptr<AnnTriggerObject>> identifiedTriggerObjects;
 
+		///sets of instanced meshes mapped to ID strings
+		std::unordered_map<std::string, std::shared_ptr<AnnInstancedMesh>> identifiedInstancedMeshes;
+
+		///Prefabs mapped to their name. Declared after the objects so the pools are destroyed first
+		std::unordered_map<std::string, std::unique_ptr<AnnPrefabPool>> prefabs;
+
 		uID autoID;
 		uID nextID();
 
 		bool halfPos, halfTexCoord, qTan;
+
+		///Cache of converted meshes. Created at the first conversion
+		mutable std::unique_ptr<AnnMeshCache> meshCache;
+		///Directory of the mesh cache. Empty if the cache is disabled
+		mutable std::string meshCacheDirectory;
+		///Set once the default cache directory has been chosen
+		mutable bool meshCacheConfigured;
 	};
 
 	using AnnGameObjectManagerPtr = std::shared_ptr<AnnGameObjectManager>;
@@ -0,0 +1,71 @@
+/**
+* \file AnnGlyphAtlas.hpp
+* \brief Copy of a font texture kept in main memory, with the position of every glyph
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <Overlay/OgreFont.h>
+
+namespace Annwvyn
+{
+	///Coverage of the glyphs of a font, read once from the font texture. Text is drawn from it without touching the GPU copy of the font.
+	///Atlases are built on first use and cached per font.
+	class AnnDllExport AnnGlyphAtlas
+	{
+	public:
+		///Position of a glyph in the atlas, in pixels
+		struct Glyph
+		{
+			///Left side
+			uint16_t left;
+			///Top side
+			uint16_t top;
+			///Width
+			uint16_t width;
+			///Height
+			uint16_t height;
+		};
+
+		///Read the font texture back once, and compute the glyph positions. Use get() to share atlases
+		AnnGlyphAtlas(Ogre::Font* font);
+
+		///Get the atlas of a font, build it if needed. Main thread only
+		static const AnnGlyphAtlas& get(Ogre::Font* font);
+
+		///Forget every cached atlas. Called when the engine stops
+		static void clearCache();
+
+		///Get the glyph of a character. Characters that are not in the font have an empty glyph
+		const Glyph& getGlyph(char c) const { return glyphs[uint8_t(c)]; }
+
+		///Coverage of the first pixel of a row of a glyph, between 0 and 255. The next pixels of the row follow it
+		const uint8_t* getCoverage(const Glyph& glyph, size_t row) const { return &coverage[(glyph.top + row) * width + glyph.left]; }
+
+		///Blend `count` pixels of `color` over `destination`, in proportion of their coverage multiplied by `alpha`.
+		///Works on any format with four 8 bits channels, where `color` is already packed. Uses SSE2 when available
+		static void blendRow(uint8_t* destination, const uint8_t* coverage, size_t count, uint32_t color, uint8_t alpha);
+
+		///Same as blendRow, one pixel at a time. Gives the exact same result
+		static void blendRowScalar(uint8_t* destination, const uint8_t* coverage, size_t count, uint32_t color, uint8_t alpha);
+
+	private:
+		///Handle of the font, to detect another font created at the same address
+		Ogre::ResourceHandle fontHandle;
+		///Width of the atlas
+		size_t width;
+		///Height of the atlas
+		size_t height;
+		///Alpha of the font texture, one byte per pixel
+		std::vector<uint8_t> coverage;
+		///Glyph of each 8 bits character
+		std::array<Glyph, 256> glyphs;
+	};
+}
@@ -14,6 +14,7 @@ namespace Annwvyn
 	class AnnOgreVRRenderer;
 	class AnnOgreOpenVRRenderer;
 	class AnnOgreOculusRenderer;
+	class AnnOgreReplayRenderer;
 
 	///ID of an hand controller is the index of an array. using size_t s
 	using AnnHandControllerID = size_t;
@@ -40,6 +41,7 @@ namespace Annwvyn
 		friend class AnnOgreVRRenderer;
 		friend class AnnOgreOpenVRRenderer;
 		friend class AnnOgreOculusRenderer;
+		friend class AnnOgreReplayRenderer;
 
 		///Change the value of the string.
 		void updateValue(float normalizedValue);
@@ -199,6 +201,7 @@ namespace Annwvyn
 		friend class AnnOgreVRRenderer;
 		friend class AnnOgreOpenVRRenderer;
 		friend class AnnOgreOculusRenderer;
+		friend class AnnOgreReplayRenderer;
 
 		///Type of the controller, Can be string like "Vive controller" or "Oculus Touch Controller"
 		std::string controllerTypeString;
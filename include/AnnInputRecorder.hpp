@@ -0,0 +1,95 @@
+/**
+* \file AnnInputRecorder.hpp
+* \brief Record the input and the tracking of each frame to a file, to replay them later
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+#include "AnnInputRecordingFormat.hpp"
+#include "AnnInputThread.hpp"
+#include "AnnOgreVRRenderer.hpp"
+
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Annwvyn
+{
+	///Write, frame by frame, everything a session gets from the outside : the frame time, the head pose, the hand controllers and the
+	///changes of the keyboard, the mouse and the sticks. The AnnOgreReplayRenderer plays the file back, so a run can be reproduced without the user.
+	///Owned by the event manager, that feeds it on the main thread
+	class AnnDllExport AnnInputRecorder
+	{
+	public:
+		///Construct a recorder that doesn't record
+		AnnInputRecorder();
+
+		///Write what is buffered and close the file
+		~AnnInputRecorder();
+
+		///Start writing a recording to a file. Stop the previous one. Return false if the file can't be opened
+		bool start(const std::string& fileName);
+
+		///Write what is buffered and close the file
+		void stop();
+
+		///Return true if a recording is being written
+		bool isRecording() const;
+
+		///An input changed. It will be written with the next frame
+		/// \param sample The change. Its time is ignored
+		/// \param time When the change happened, on the engine clock
+		void input(const AnnInputSample& sample, double time);
+
+		///A frame has been simulated with the given tracking state. Write it with the input changes received since the last frame
+		/// \param delta Time between this frame and the previous one
+		/// \param time Start of the frame, on the engine clock
+		/// \param head Tracked pose of the head
+		/// \param hands Hand controllers, indexed by side. Can be null
+		void frame(double delta, double time, const AnnPose& head, const std::array<AnnHandControllerPtr, MAX_CONTROLLER_NUMBER>& hands);
+
+	private:
+		///An input change waiting for its frame
+		struct PendingInput
+		{
+			///The change, age not set yet
+			AnnInputRecordingFormat::InputRecord record;
+			///When the change happened
+			double time;
+		};
+
+		///Write the type and the axis names of a hand controller
+		void describe(AnnHandController& hand);
+
+		///Write the state of a hand controller
+		void writeHand(AnnHandController& hand);
+
+		///Append a record to the buffer
+		void append(AnnInputRecordingFormat::RecordType type, const void* payload, size_t size, const void* extraPayload = nullptr, size_t extraSize = 0);
+
+		///Append a record of a type
+		template <class Record>
+		void append(AnnInputRecordingFormat::RecordType type, const Record& record)
+		{
+			append(type, &record, sizeof record);
+		}
+
+		///Write the buffer to the file
+		void writeBuffer();
+
+		///The recording file
+		std::ofstream file;
+		///Records not written yet
+		std::vector<char> buffer;
+		///Payload of the variable size records being built
+		std::vector<char> extra;
+		///Input changes of the frame in progress
+		std::vector<PendingInput> pendingInputs;
+		///Hand controller last described for each side
+		std::array<const AnnHandController*, MAX_CONTROLLER_NUMBER> describedHands;
+		///Number of frames written
+		uint32_t frameCount;
+	};
+}
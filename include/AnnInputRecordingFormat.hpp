@@ -0,0 +1,124 @@
+/**
+* \file AnnInputRecordingFormat.hpp
+* \brief Layout of input recording files. Shared by the recorder and the replay
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Annwvyn
+{
+	///Layout of an input recording file.
+	///A file is a Header, followed by one group of records per frame. Each record is a RecordHeader followed by `size` bytes of payload,
+	///so a reader can skip the types it doesn't know. A group starts with a FrameRecord, then the HandDescriptionRecord of any hand controller
+	///seen for the first time, the HandRecord of each hand controller, and the InputRecord of each input change of the frame, in order.
+	///Every value is little endian. Orientations are stored w, x, y, z
+	namespace AnnInputRecordingFormat
+	{
+		///First bytes of a recording
+		static constexpr char magic[4]{ 'A', 'N', 'I', 'R' };
+		///Version of the format written by the engine
+		static constexpr uint32_t version{ 2 };
+
+		///Header of the file
+		struct Header
+		{
+			///Should be equal to magic
+			char magic[4];
+			///Version of the format
+			uint32_t version;
+		};
+
+		///Type of a record
+		enum RecordType : uint16_t {
+			frame,
+			handDescription,
+			hand,
+			input
+		};
+
+		///Put in front of every record
+		struct RecordHeader
+		{
+			///Type of the record, as a RecordType
+			uint16_t type;
+			///Size of the payload following this header
+			uint16_t size;
+		};
+
+		///Start of a frame, with the tracking state the frame was simulated with
+		struct FrameRecord
+		{
+			///Time between this frame and the previous one, in seconds
+			double delta;
+			///Number of the frame, counted from the start of the recording
+			uint32_t frame;
+			///Position of the head
+			float headPosition[3];
+			///Orientation of the head
+			float headOrientation[4];
+			///Engine clock during the frame, in seconds. Added in version 2, a reader sums the deltas for older files
+			double time;
+		};
+
+		///Kind of a hand controller. Followed by the type string, then the name of each axis, all null terminated
+		struct HandDescriptionRecord
+		{
+			///Side of the controller, as a AnnHandController::AnnHandControllerSide
+			uint8_t side;
+			///Number of axis names
+			uint8_t axisCount;
+			///Unused
+			uint16_t reserved;
+		};
+
+		///State of a hand controller. Followed by `axisCount` floats, then `buttonCount` bytes
+		struct HandRecord
+		{
+			///Side of the controller, as a AnnHandController::AnnHandControllerSide
+			uint8_t side;
+			///1 if the controller is tracked
+			uint8_t tracked;
+			///Number of button states
+			uint8_t buttonCount;
+			///Number of axis values
+			uint8_t axisCount;
+			///Position in world space
+			float position[3];
+			///Orientation in world space
+			float orientation[4];
+			///Tracked linear speed
+			float linearSpeed[3];
+			///Tracked angular speed
+			float angularSpeed[3];
+		};
+
+		///A change of the keyboard, the mouse or a stick. Same fields as an AnnInputSample
+		struct InputRecord
+		{
+			///What changed, as a AnnInputSample::Kind
+			uint8_t kind;
+			///Key or button pressed state
+			uint8_t pressed;
+			///Index of the stick
+			uint16_t stick;
+			///Key code, or index of the button, axis or PoV. For the mouse, bit n is set if button n is down
+			uint32_t index;
+			///Text of a key
+			uint32_t text;
+			///See AnnInputSample::values
+			int32_t values[6];
+			///Seconds between the change and the start of the frame
+			float age;
+		};
+
+		static_assert(std::is_trivially_copyable<Header>::value && sizeof(Header) == 8, "Header layout changed");
+		static_assert(sizeof(RecordHeader) == 4, "RecordHeader layout changed");
+		static_assert(sizeof(FrameRecord) == 48, "FrameRecord layout changed");
+		static_assert(sizeof(HandDescriptionRecord) == 4, "HandDescriptionRecord layout changed");
+		static_assert(sizeof(HandRecord) == 56, "HandRecord layout changed");
+		static_assert(sizeof(InputRecord) == 40, "InputRecord layout changed");
+	}
+}
@@ -0,0 +1,94 @@
+/**
+* \file AnnInputReplay.hpp
+* \brief Read back, frame by frame, a file written by AnnInputRecorder
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+#include "AnnInputRecordingFormat.hpp"
+#include "AnnInputThread.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Annwvyn
+{
+	///Reader of an input recording. The whole file is loaded when opened, so playing it back doesn't touch the disk.
+	///Used by the AnnOgreReplayRenderer for the tracking, and by the event manager for the input changes
+	class AnnDllExport AnnInputReplay
+	{
+	public:
+		///State of a hand controller during a frame
+		struct Hand
+		{
+			///Pose and counts
+			AnnInputRecordingFormat::HandRecord record;
+			///Value of each axis
+			std::vector<float> axes;
+			///State of each button
+			std::vector<uint8_t> buttons;
+		};
+
+		///Kind of a hand controller
+		struct HandDescription
+		{
+			///Type string of the controller
+			std::string type;
+			///Name of each axis
+			std::vector<std::string> axisNames;
+		};
+
+		///An input change of a frame
+		struct Input
+		{
+			///The change. Its time is not set
+			AnnInputSample sample;
+			///Seconds between the change and the start of the frame
+			float age;
+		};
+
+		///Construct a replay with nothing to play
+		AnnInputReplay();
+
+		///Load a recording. Return false if the file can't be read or isn't a recording
+		bool open(const std::string& fileName);
+
+		///Read the next frame. Return false when there is none left
+		bool nextFrame();
+
+		///Return true if every frame has been read
+		bool isFinished() const;
+
+		///The current frame. Files written before the clock was recorded get the sum of the frame deltas as time
+		const AnnInputRecordingFormat::FrameRecord& getFrame() const;
+
+		///Hand controllers of the current frame
+		const std::vector<Hand>& getHands() const;
+
+		///Last known kind of hand controller of a side
+		const HandDescription& getHandDescription(size_t side) const;
+
+		///Input changes of the current frame, in order
+		const std::vector<Input>& getInputs() const;
+
+	private:
+		///Content of the file
+		std::vector<char> file;
+		///Position of the next record
+		size_t offset;
+		///Version of the format the file was written with
+		uint32_t version;
+		///Set when every frame has been read
+		bool finished;
+		///The current frame
+		AnnInputRecordingFormat::FrameRecord frame;
+		///Hand controllers of the current frame
+		std::vector<Hand> hands;
+		///Kind of hand controller of each side
+		std::array<HandDescription, 2> handDescriptions;
+		///Input changes of the current frame
+		std::vector<Input> inputs;
+	};
+}
@@ -0,0 +1,177 @@
+/**
+* \file AnnInputThread.hpp
+* \brief Capture the input devices at a fixed rate on a separate thread
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <OIS.h>
+
+namespace Annwvyn
+{
+	///A change of an input device, with the time it was captured at
+	struct AnnInputSample
+	{
+		///What changed
+		enum Kind : uint8_t {
+			key,
+			mouse,
+			stickButton,
+			stickAxis,
+			stickPov
+		};
+
+		///What changed
+		Kind kind;
+		///Key or button pressed state
+		bool pressed;
+		///Index of the stick
+		uint16_t stick;
+		///Key code, or index of the button, axis or PoV. For the mouse, bit n is set if button n is down
+		uint32_t index;
+		///Text of a key
+		uint32_t text;
+		///Axis : absolute then relative value. PoV : direction. Mouse : relative then absolute value of X, Y and Z
+		std::array<int32_t, 6> values;
+		///When the change was captured
+		std::chrono::steady_clock::time_point time;
+	};
+
+	///Lock-free queue of fixed capacity for one producer thread and one consumer thread
+	template <class T, size_t Capacity>
+	class AnnSpscQueue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		///Construct an empty queue
+		AnnSpscQueue() :
+		 head(0), tail(0) {}
+
+		///Add an element. Producer thread only. Return false if the queue is full
+		bool push(const T& value)
+		{
+			const auto position = head.load(std::memory_order_relaxed);
+			if(position - tail.load(std::memory_order_acquire) == Capacity) return false;
+
+			elements[position & (Capacity - 1)] = value;
+			head.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		///Take the oldest element. Consumer thread only. Return false if the queue is empty
+		bool pop(T& value)
+		{
+			const auto position = tail.load(std::memory_order_relaxed);
+			if(position == head.load(std::memory_order_acquire)) return false;
+
+			value = elements[position & (Capacity - 1)];
+			tail.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		///Size of a cache line. The counters are kept this far apart with padding bytes, as the queue is heap allocated and C++14 doesn't honor alignas there
+		static constexpr size_t cacheLineSize{ 64 };
+
+		///Storage of the ring
+		std::array<T, Capacity> elements;
+		///Keep the end of the ring off the cache line of head
+		char elementsPadding[cacheLineSize];
+		///Number of elements pushed. Written by the producer
+		std::atomic<size_t> head;
+		///Keep tail off the cache line of head
+		char headPadding[cacheLineSize];
+		///Number of elements popped. Written by the consumer
+		std::atomic<size_t> tail;
+		///Keep whatever follows the queue off the cache line of tail
+		char tailPadding[cacheLineSize];
+	};
+
+	///Thread that captures the keyboard, the mouse and the sticks at a fixed rate, and queues what changed.
+	///While it runs, it is the keyboard listener, and nothing else should capture the devices. The event manager drains the queue every frame
+	class AnnDllExport AnnInputThread : public OIS::KeyListener
+	{
+	public:
+		///Start capturing
+		/// \param keyboard The keyboard. Its event callback is set to this object until it's destroyed
+		/// \param mouse The mouse
+		/// \param sticks The sticks. A sample refers to a stick by its index in this list
+		/// \param frequency Captures per second
+		AnnInputThread(OIS::Keyboard* keyboard, OIS::Mouse* mouse, std::vector<OIS::JoyStick*> sticks, double frequency);
+
+		///Stop the thread, and give the keyboard back to the listener it had
+		~AnnInputThread();
+
+		///This class own a thread, it cannot be copied
+		AnnInputThread(const AnnInputThread&) = delete;
+		///This class own a thread, it cannot be copied
+		AnnInputThread& operator=(const AnnInputThread&) = delete;
+
+		///Take the oldest sample. Return false if there is none
+		bool pop(AnnInputSample& sample);
+
+		///Captures per second
+		double getFrequency() const;
+
+		///Number of samples lost because the queue was full
+		size_t getDroppedCount() const;
+
+		///Keyboard callback, called on the input thread
+		bool keyPressed(const OIS::KeyEvent& arg) override;
+		///Keyboard callback, called on the input thread
+		bool keyReleased(const OIS::KeyEvent& arg) override;
+
+	private:
+		///Capture until stopped
+		void run();
+
+		///Queue the changes of the mouse state
+		void sampleMouse(std::chrono::steady_clock::time_point now);
+
+		///Queue the changes of the stick states
+		void sampleSticks(std::chrono::steady_clock::time_point now);
+
+		///Queue a sample, count it if the queue is full
+		void push(const AnnInputSample& sample);
+
+		///The keyboard
+		OIS::Keyboard* keyboard;
+		///The keyboard listener to restore
+		OIS::KeyListener* previousKeyListener;
+		///The mouse
+		OIS::Mouse* mouse;
+		///The sticks
+		std::vector<OIS::JoyStick*> sticks;
+
+		///Last mouse buttons sent
+		uint32_t mouseButtons;
+		///Last mouse absolute position sent
+		std::array<int32_t, 3> mouseAbs;
+		///Last state sent of each stick
+		std::vector<OIS::JoyStickState> stickStates;
+
+		///Time between two captures
+		std::chrono::steady_clock::duration period;
+		///Time of the capture in progress
+		std::chrono::steady_clock::time_point captureTime;
+
+		///Samples not taken by the event manager yet
+		AnnSpscQueue<AnnInputSample, 4096> samples;
+		///Number of samples lost
+		std::atomic<size_t> droppedCount;
+		///Cleared to stop the thread
+		std::atomic<bool> running;
+		///The thread
+		std::thread thread;
+	};
+}
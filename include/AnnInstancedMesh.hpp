@@ -0,0 +1,126 @@
+/**
+* \file AnnInstancedMesh.hpp
+* \brief Many copies of the same mesh, drawn together
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OgreMesh2.h>
+
+#include "AnnTypes.h"
+#include "AnnSlotMap.hpp"
+
+namespace Annwvyn
+{
+	///Placement of one instance of an AnnInstancedMesh
+	struct AnnDllExport AnnInstanceTransform
+	{
+		///Position
+		AnnVect3 position{ AnnVect3::ZERO };
+		///Orientation
+		AnnQuaternion orientation{ AnnQuaternion::IDENTITY };
+		///Scale
+		AnnVect3 scale{ AnnVect3::UNIT_SCALE };
+	};
+
+	///Set of identical props : one mesh, placed many times. Instances have no physics, no scripts, no sound, and are never updated by the engine.
+	///Every item shares the same mesh and datablock, so Ogre's HLMS draws them with automatic instancing, a few draw calls for the whole set.
+	///Transforms are kept in a contiguous array. Edit them in place and call markDirty(), or use setTransforms(). Changes are sent to the scene once per frame.
+	///Static instances live in Ogre's static scene memory : their transforms cost nothing per frame until one of them changes
+	class AnnDllExport AnnInstancedMesh
+	{
+	public:
+		///Create an empty set of instances of this mesh. Use AnnGameObjectManager::createInstancedMesh()
+		AnnInstancedMesh(Ogre::MeshPtr mesh, const std::string& name, bool isStatic);
+
+		///Destroy every instance
+		~AnnInstancedMesh();
+
+		///This class own Ogre objects, it cannot be copied
+		AnnInstancedMesh(const AnnInstancedMesh&) = delete;
+		///This class own Ogre objects, it cannot be copied
+		AnnInstancedMesh& operator=(const AnnInstancedMesh&) = delete;
+
+		///Add an instance, and return it's index
+		size_t addInstance(const AnnInstanceTransform& transform);
+
+		///Remove an instance. The last instance takes it's index
+		void removeInstance(size_t index);
+
+		///Remove every instance
+		void clear();
+
+		///Number of instances
+		size_t size() const;
+
+		///Transform of an instance
+		const AnnInstanceTransform& getTransform(size_t index) const;
+
+		///Change the transform of an instance
+		void setTransform(size_t index, const AnnInstanceTransform& transform);
+
+		///Copy `count` transforms to the instances starting at `first`
+		void setTransforms(size_t first, const AnnInstanceTransform* transforms, size_t count);
+
+		///The transforms of every instance, contiguous. Call markDirty() after changing them
+		AnnInstanceTransform* getTransforms();
+
+		///Send the transforms of the instances [first, first + count[ to the scene at the next update
+		void markDirty(size_t first, size_t count);
+
+		///Use this datablock for every instance, including the ones added later. They keep sharing it, so they are still instanced
+		void setDatablock(const std::string& datablockName);
+
+		///Make every instance visible or not
+		void setVisible(bool visible) const;
+
+		///Return true if the instances are in static scene memory
+		bool isStatic() const;
+
+		///Name of the set
+		const std::string& getName() const;
+
+		///Apply the changed transforms to the scene nodes. Called by the game object manager
+		void update();
+
+	private:
+		friend class AnnGameObjectManager;
+
+		///Put a transform on a node
+		void apply(size_t index) const;
+
+		///Mesh of every instance
+		Ogre::MeshPtr mesh;
+		///Name of the set
+		const std::string name;
+		///Scene memory the nodes and items are created in
+		const Ogre::SceneMemoryMgrTypes memoryType;
+		///Scene manager owning the nodes and items
+		Ogre::SceneManager* const sceneManager;
+		///Datablock set by setDatablock(). Empty to keep the one of the mesh
+		std::string datablockName;
+
+		///Transform of each instance
+		std::vector<AnnInstanceTransform> transforms;
+		///Node of each instance
+		std::vector<Ogre::SceneNode*> nodes;
+		///Item of each instance
+		std::vector<Ogre::Item*> items;
+
+		///First instance to update
+		size_t dirtyBegin;
+		///One past the last instance to update
+		size_t dirtyEnd;
+
+		///Slot of this set in the game object manager
+		AnnSlotHandle slot;
+	};
+
+	using AnnInstancedMeshPtr = std::shared_ptr<AnnInstancedMesh>;
+}
@@ -2,10 +2,13 @@
 
 #include <systemMacro.h>
 #include <AnnLevel.hpp>
+#include <AnnLightObject.hpp>
 #include <memory>
 
 namespace Annwvyn
 {
+	class AnnResourcePreload;
+
 	///Level object loaded from a JSON file
 	class AnnDllExport AnnJsonLevel : LEVEL
 	{
@@ -15,9 +18,9 @@ namespace Annwvyn
 		using AnnJsonOpaquePtr = std::unique_ptr<AnnJson>;
 
 	public:
-		///Construct a JSON level from a file
+		///Construct a JSON level from a file. The file is read by prepare()
 		AnnJsonLevel(std::string path, const bool preload = true);
-		///Construct a json level from code. First boolean is thrown away
+		///Construct a json level from code. First boolean is thrown away. The code is parsed by prepare()
 		AnnJsonLevel(bool, std::string jsonCode, const bool preload = true);
 		///Dtor
 		virtual ~AnnJsonLevel();
@@ -25,13 +28,38 @@ namespace Annwvyn
 		void load() override;
 		///Run logic, actually empty here
 		void runLogic() override;
+		///Read and parse the JSON. Called on a worker thread by AnnLevelManager::switchToLevelAsync(), or by the loading methods if it wasn't
+		void prepare() override;
+		///Create objects and lights for about `budget` milliseconds, then place the player once everything exists
+		bool loadIncrementally(double budget) override;
+		///Fraction of the objects, lights and sets of instances already created
+		float getLoadingProgress() const override;
+		///Unload the level, and restart incremental loading from the first object
+		void unload() override;
+
+		///Physics shape of a level file by its name. Return error if the name is unknown. Also used by the level compiler
+		static phyShapeType shapeFromString(const std::string& shape);
+		///Light type of a level file by its name. Return ANN_LIGHT_ERROR if the name is unknown. Also used by the level compiler
+		static AnnLightObject::LightTypes lightTypeFromString(const std::string& type);
 
 	private:
 		///Pimpl
 		AnnJsonOpaquePtr jsonFile;
-		///Do initial processing on JSON
-		void processJson();
+		///Declare the resources of the level and start loading their groups, the first time it's called. Main thread only
+		void declareResources();
+		///Put the player at the start position of the level
+		void placePlayer();
 		///If set to false, resource group will not be initialized
 		const bool preloadResources;
+		///Path of the level file. Empty if the level was constructed from code
+		const std::string path;
+		///Set once the JSON is parsed
+		bool prepared;
+		///Set once the resources are declared
+		bool resourcesDeclared;
+		///Loading of the resource groups of the level
+		std::shared_ptr<AnnResourcePreload> resourcePreload;
+		///Number of entries (objects, lights, then sets of instances) already created by loadIncrementally()
+		size_t createdEntries;
 	};
 }
@@ -13,6 +13,8 @@ This class also provide a 'simple, stupid' random string generator to set IDs to
 
 #include "AnnTypes.h"
 
+#include <functional>
+
 #define LEVEL \
 public        \
 	Annwvyn::AnnLevel
@@ -41,6 +43,17 @@ namespace Annwvyn
 		///Run logic code from the level
 		virtual void runLogic() = 0;
 
+		///Do the part of the loading that doesn't touch the scene, like reading files.
+		///Called from a worker thread by AnnLevelManager::switchToLevelAsync(). Does nothing by default
+		virtual void prepare();
+
+		///Create part of the level content, for about `budget` milliseconds. Return true once the level is fully loaded.
+		///Called once per frame by AnnLevelManager::switchToLevelAsync(). By default, the whole level is loaded at once by load()
+		virtual bool loadIncrementally(double budget);
+
+		///Fraction of the level content created by loadIncrementally(), between 0 and 1
+		virtual float getLoadingProgress() const;
+
 		///Get the list of objects
 		AnnGameObjectList& getContent();
 
@@ -50,6 +63,9 @@ namespace Annwvyn
 		///Get the list of triggers
 		AnnTriggerObjectList& getTriggers();
 
+		///Get the list of instanced meshes
+		AnnInstancedMeshList& getInstancedMeshes();
+
 	protected:
 		friend class AnnLevelManager;
 
@@ -62,6 +78,9 @@ namespace Annwvyn
 		//Spatial trigger volumes in the level
 		AnnTriggerObjectList levelTrigger;
 
+		//Sets of identical props in the level
+		AnnInstancedMeshList levelInstances;
+
 		///List of movable on the level
 		std::vector<std::shared_ptr<AnnAbstractMovable>> levelMovable;
 
@@ -74,6 +93,9 @@ namespace Annwvyn
 		///Add a Game object to the level
 		std::shared_ptr<AnnGameObject> addGameObject(std::string entityName, std::string name = "");
 
+		///Add a set of instances of a mesh to the level
+		std::shared_ptr<AnnInstancedMesh> addInstancedMesh(std::string meshName, std::string name = "", bool isStatic = true);
+
 		///Add a manual movable object
 		void addManualMovableObject(std::shared_ptr<AnnAbstractMovable> movable);
 
@@ -86,6 +108,10 @@ namespace Annwvyn
 			return movable;
 		}
 
+		///Call step until it returns true or until `budget` milliseconds are spent. step is always called at least once.
+		///Return true if step returned true
+		static bool runTimeSliced(double budget, const std::function<bool()>& step);
+
 		///Name of the level
 		std::string name;
 	};
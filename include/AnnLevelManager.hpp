@@ -8,6 +8,7 @@
 #pragma once
 
 #include <vector>
+#include <future>
 #include "AnnLevel.hpp"
 #include "AnnSubsystem.hpp"
 #include "AnnGameObject.hpp"
@@ -34,6 +35,31 @@ namespace Annwvyn
 		///\param level address of a subclass instance of AnnLevel
 		void switchToLevel(AnnLevelPtr level);
 
+		///Jump to an index referenced level without stopping the rendering.
+		///The level is prepared on a worker thread while the current level keeps running, then it's content is created over several frames
+		///\param levelId Index of the level in the order they have been declared
+		void switchToLevelAsync(AnnLevelID levelId);
+
+		///Jump to a pointer referenced level without stopping the rendering
+		///\param level address of a subclass instance of AnnLevel
+		void switchToLevelAsync(AnnLevelPtr level);
+
+		///Return true while a level is being loaded by switchToLevelAsync()
+		bool isLoading() const;
+
+		///Progress of the level loaded by switchToLevelAsync(), between 0 and 1. Preparation counts for the first half
+		float getLoadingProgress() const;
+
+		///Set the time spent creating level content at each frame during an asynchronous load, in milliseconds
+		void setLoadingBudget(double milliseconds);
+
+		///Get the time spent creating level content at each frame during an asynchronous load, in milliseconds
+		double getLoadingBudget() const;
+
+		///Keep the parts of the objects of the unloaded level, and reuse them for the objects of the next level made from the same meshes.
+		///What the next level doesn't reuse is destroyed once it's loaded. Switching between similar levels is then much faster
+		void setReuseObjectsBetweenLevels(bool reuse);
+
 		///Add a level to the level manager
 		///\param level address of a subclass instance of AnnLevel
 		void addLevel(AnnLevelPtr level);
@@ -72,12 +98,28 @@ namespace Annwvyn
 		AnnLevelPtr getCurrentLevel() const;
 
 		///Add an orphan object to the current level
-		void addToCurrentLevel(AnnGameObjectPtr obj) const;
+		void addToCurrentLevel(const AnnGameObjectPtr& obj) const;
+
+		///Add an orphan object to the current level
+		void addToCurrentLevel(AnnGameObjectHandle obj) const;
+
+		///Remove an object from the current level (make it orphan)
+		void removeFromCurrentLevel(const AnnGameObjectPtr& obj) const;
 
 		///Remove an object from the current level (make it orphan)
-		void removeFromCurrentLevel(AnnGameObjectPtr obj) const;
+		void removeFromCurrentLevel(AnnGameObjectHandle obj) const;
 
 	private:
+		///Wait for the worker thread and forget the level being loaded asynchronously
+		void cancelAsyncLoad();
+
+		///Step of an asynchronous level load
+		enum class LoadingState {
+			idle,
+			preparing,
+			instantiating
+		};
+
 		///List of levels
 		std::vector<AnnLevelPtr> loadedLevels;
 
@@ -89,6 +131,21 @@ namespace Annwvyn
 
 		///Level to switchToLevel to at next update
 		AnnLevelID jumpTo;
+
+		///Current step of the asynchronous load
+		LoadingState loadingState;
+
+		///Level loaded by switchToLevelAsync()
+		AnnLevelPtr loading;
+
+		///Result of AnnLevel::prepare() running on the worker thread
+		std::future<void> preparation;
+
+		///Milliseconds spent creating level content at each frame
+		double loadingBudget;
+
+		///Number of frames spent creating the content of the level
+		size_t loadingFrames;
 	};
 
 	using AnnLevelManagerPtr = std::shared_ptr<AnnLevelManager>;
@@ -9,6 +9,7 @@
 
 #include "AnnAbstractMovable.hpp"
 #include "AnnTypes.h"
+#include "AnnSlotMap.hpp"
 
 #include <OgreLight.h>
 
@@ -77,6 +78,8 @@ namespace Annwvyn
 		Ogre::Light* light;
 		Ogre::SceneNode* node;
 		const std::string name;
+		///Slot of this light in the game object manager
+		AnnSlotHandle slot;
 	};
 
 	using AnnLightObjectPtr = std::shared_ptr<AnnLightObject>;
@@ -1,6 +1,6 @@
 /**
 * \file AnnLogger.hpp
-* \brief Create a ostream to the Ogre logger
+* \brief Create a ostream to the engine log, and the asynchronous logger behind it
 * \author A. Brainville (Ybalrid)
 */
 #pragma once
@@ -10,8 +10,159 @@
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <fstream>
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <OgreLog.h>
+
+///Log levels lower than this one are removed at compile time. 0 : debug, 1 : info, 2 : warning, 3 : error
+#ifndef ANN_LOG_MIN_LEVEL
+#define ANN_LOG_MIN_LEVEL 0
+#endif
+
+///Log a message at a level, as in `ANN_LOG(debug) << "Player life is now " << playerLife;`.
+///If the level is disabled, at compile time or at run time, the message isn't formatted and its arguments aren't evaluated
+#define ANN_LOG(level)                                                          \
+	if(!Annwvyn::AnnLogger::isEnabled(Annwvyn::AnnLogLevel::level)) {} \
+	else                                                                        \
+		Annwvyn::AnnDebug(Annwvyn::AnnLogLevel::level)
+
 namespace Annwvyn
 {
+	///Importance of a log message
+	enum class AnnLogLevel {
+		debug,
+		info,
+		warning,
+		error
+	};
+
+	///Background writer of the engine log. Messages are pushed on a lock-free queue by any thread,
+	///and a worker thread writes them to the log file and the terminal. Lines for the on screen console are handed back to the main thread.
+	///Ogre's own messages go through the same queue, so only the worker thread touches the log file.
+	///Created by AnnEngine. Without it, messages are written right away to the terminal
+	class AnnDllExport AnnLogger : public Ogre::LogListener
+	{
+	public:
+		///Create the Ogre log manager if needed and start the writer thread
+		AnnLogger(const std::string& logFileName);
+
+		///Write every pending message and stop the writer thread
+		~AnnLogger();
+
+		///This class own a thread, it cannot be copied
+		AnnLogger(const AnnLogger&) = delete;
+		///This class own a thread, it cannot be copied
+		AnnLogger& operator=(const AnnLogger&) = delete;
+
+		///Return true if messages of this level are written
+		static bool isEnabled(AnnLogLevel level) { return int(level) >= ANN_LOG_MIN_LEVEL && level >= runtimeLevel.load(std::memory_order_relaxed); }
+
+		///Set the lowest level written. Can't go below ANN_LOG_MIN_LEVEL
+		static void setLevel(AnnLogLevel level);
+
+		///Get the lowest level written
+		static AnnLogLevel getLevel();
+
+		///Queue a message. Can be called from any thread
+		/// \param message Text of the message
+		/// \param level Level of the message
+		/// \param flag If true, "Annwvyn - " is put in front of the message
+		/// \param toConsole If true, the message will also be displayed by the on screen console
+		static void push(std::string message, AnnLogLevel level, bool flag = true, bool toConsole = true);
+
+		///Wait until every message pushed before this call is written
+		static void flush();
+
+		///Get the messages written since the last call that should go to the on screen console
+		static std::vector<std::string> takeConsoleMessages();
+
+		///Number of messages written since the logger started
+		static size_t getWrittenCount();
+
+		///Receive Ogre's messages. They are queued like the others
+		void messageLogged(const Ogre::String& message, Ogre::LogMessageLevel lml, bool maskDebug, const Ogre::String& logName, bool& skipThisMessage) override;
+
+	private:
+		///A queued message, also a node of the queue
+		struct Message
+		{
+			///Next message in the queue
+			std::atomic<Message*> next;
+			///Text of the message
+			std::string text;
+			///Level of the message
+			AnnLogLevel level;
+			///If true, "Annwvyn - " is put in front of the message
+			bool flag;
+			///If true, the message also goes to the on screen console
+			bool toConsole;
+			///When the message was pushed
+			std::time_t time;
+		};
+
+		///Count a message, put it at the end of the queue and wake the writer up. Any thread
+		void enqueue(Message* message);
+
+		///Put a message at the end of the queue. Wait-free, any thread
+		void link(Message* message);
+
+		///Take the message at the front of the queue. Writer thread only. Returns nullptr if there's none
+		Message* dequeue();
+
+		///Write queued messages until stopped
+		void writerLoop();
+
+		///Write a message to the file and the terminal
+		void write(const Message& message);
+
+		///Write a message to the terminal, with colors
+		static void writeToTerminal(const Message& message);
+
+		///The running logger
+		static AnnLogger* instance;
+		///Lowest level written
+		static std::atomic<AnnLogLevel> runtimeLevel;
+
+		///Last message pushed
+		std::atomic<Message*> head;
+		///First message not written yet, or the stub
+		Message* tail;
+		///Placeholder that keeps the queue from being empty
+		Message stub;
+
+		///Number of messages pushed
+		std::atomic<size_t> pushedCount;
+		///Number of messages written
+		std::atomic<size_t> writtenCount;
+
+		///Cleared to stop the writer
+		std::atomic<bool> running;
+		///Set while the writer waits for messages
+		std::atomic<bool> sleeping;
+		///Only used to put the writer to sleep
+		std::mutex sleepMutex;
+		///Wakes the writer up
+		std::condition_variable wakeUp;
+		///The writer thread
+		std::thread writer;
+
+		///The log file
+		std::ofstream file;
+		///True if the Ogre log manager was created by this object. If not, messages are forwarded to its log instead of a file
+		bool ownLogManager;
+
+		///Protects consoleMessages
+		std::mutex consoleMutex;
+		///Messages written that should be displayed by the console
+		std::vector<std::string> consoleMessages;
+	};
+
 	///Open an output stream to the engine log
 	class AnnDllExport AnnDebug : public std::ostream
 	{
@@ -20,28 +171,36 @@ namespace Annwvyn
 		{
 		public:
 			///Construct an AnnDebug buffer
-			AnnDebugBuff(){};
+			AnnDebugBuff();
 
-			///Will sync the buffer
-			~AnnDebugBuff();
-			;
-
-			///Sync the buffer by performing an AnnEngine::log, clear it and return success.
+			///Sync the buffer by queuing its content to the logger, clear it and return success.
 			int sync() override;
-			;
+
+			///Level of the message being written
+			AnnLogLevel level;
 		};
 
+		///Get a buffer from the ones owned by this thread
+		static AnnDebugBuff* acquireBuffer(AnnLogLevel level);
+
+		///Give an acquired buffer back to the pool of this thread
+		static void releaseBuffer(AnnDebugBuff* buffer);
+
 	public:
 		///Create an AnnDebug object that offer you a output stream to the AnnEngine logger
 		///This permit you to write messages to the log using C++ style ostream
 		/// example : AnnDebug() << "Player life is now " << playerLife;
 		/// where playerLife is a variable. Everything that works with an std::ostream works here.
-		AnnDebug();
+		///If the level is disabled, nothing is formatted. Use ANN_LOG to also skip evaluating the arguments
+		AnnDebug(AnnLogLevel level = AnnLogLevel::debug);
 
 		///Permit to log a static string via the debug stream
 		/// \copydoc Annwvyn::AnnDebug()
 		AnnDebug(const std::string& message);
 
+		///Permit to log a static string via the debug stream, at a level
+		AnnDebug(AnnLogLevel level, const std::string& message);
+
 		///Destroy the debug outputer object
 		~AnnDebug();
 	};
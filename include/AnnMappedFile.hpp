@@ -0,0 +1,57 @@
+/**
+* \file AnnMappedFile.hpp
+* \brief Read-only view of a whole file mapped in memory
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <string>
+#include <cstddef>
+
+namespace Annwvyn
+{
+	///Map a file in memory in read only mode. The pages are loaded by the OS when they are accessed.
+	class AnnDllExport AnnMappedFile
+	{
+	public:
+		///Map the given file. Throws AnnInitializationError if it cannot be done
+		AnnMappedFile(const std::string& path);
+
+		///Unmap the file
+		~AnnMappedFile();
+
+		///This class holds OS handles, it cannot be copied
+		AnnMappedFile(const AnnMappedFile&) = delete;
+		///This class holds OS handles, it cannot be copied
+		AnnMappedFile& operator=(const AnnMappedFile&) = delete;
+
+		///Start of the file content
+		const char* data() const;
+
+		///Size of the file in bytes
+		size_t size() const;
+
+		///Path of the mapped file
+		const std::string& getPath() const;
+
+		///Load every page of the file now. Blocks until the whole file is in memory
+		void prefetch() const;
+
+	private:
+		///Path of the file
+		const std::string path;
+		///Address where the file is mapped
+		const char* address;
+		///Size of the mapping
+		size_t length;
+
+#ifdef _WIN32
+		///File handle
+		void* fileHandle;
+		///File mapping handle
+		void* mappingHandle;
+#endif
+	};
+}
@@ -0,0 +1,79 @@
+/**
+* \file AnnMeshCache.hpp
+* \brief On disk cache of meshes converted from Ogre v1 to Ogre v2
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <cstdint>
+#include <string>
+
+#include <OgreMesh.h>
+#include <OgreMesh2.h>
+
+namespace Annwvyn
+{
+	///Keep the v2 meshes converted from v1 .mesh files on disk, to load them directly the next time.
+	///Cached files are named after the hash of the source file and of the conversion parameters.
+	///A source file that changes, or different conversion parameters, gives a new cache file. Old files are never removed.
+	class AnnDllExport AnnMeshCache
+	{
+	public:
+		///Parameters of the v1 to v2 conversion. Part of the cache key
+		struct ImportFlags
+		{
+			///Store positions as half floats
+			bool halfPosition;
+			///Store texture coordinates as half floats
+			bool halfTextureCoords;
+			///Store the tangent frame as QTangents
+			bool qTangents;
+		};
+
+		///Start value of the FNV-1a hash
+		static constexpr uint64_t hashSeed{ 0xcbf29ce484222325ull };
+
+		///Use this directory for the cache. It is created if it doesn't exist
+		AnnMeshCache(const std::string& directory);
+
+		///Get the v2 version of the v1 mesh `meshName`, named `v2MeshName`. It is read from the cache if it is there.
+		///Otherwise, the v1 mesh is loaded, converted, written to the cache and unloaded.
+		///If `source` is set, it is the content of the v1 mesh file, already read, and the file is not opened again
+		Ogre::MeshPtr load(const std::string& meshName, const std::string& v2MeshName, const std::string& group, ImportFlags flags,
+						   Ogre::DataStreamPtr source = Ogre::DataStreamPtr());
+
+		///Load a v1 mesh from it's file, or from `source` if it is set. Static vertex and index buffers
+		static Ogre::v1::MeshPtr loadV1(const std::string& meshName, Ogre::DataStreamPtr source);
+
+		///FNV-1a hash of a buffer. Give the result of a previous call as seed to hash multiple buffers
+		static uint64_t hash(const void* data, size_t size, uint64_t seed = hashSeed);
+
+		///Path of the cache file for this mesh and key
+		std::string getCachePath(const std::string& meshName, uint64_t key) const;
+
+		///Directory of the cache
+		const std::string& getDirectory() const;
+
+		///Number of meshes read from the cache
+		size_t getHitCount() const;
+
+		///Number of meshes that had to be converted
+		size_t getMissCount() const;
+
+	private:
+		///Read a cached mesh into the v2 mesh. Return false if the file doesn't exist or is invalid
+		bool readCache(const std::string& path, Ogre::Mesh* mesh) const;
+
+		///Write the v2 mesh in the cache. Failing to write only loose the cache
+		void writeCache(const std::string& path, const Ogre::Mesh* mesh) const;
+
+		///Where the cache files are
+		const std::string directory;
+		///Number of meshes read from the cache
+		size_t hits;
+		///Number of meshes that had to be converted
+		size_t misses;
+	};
+}
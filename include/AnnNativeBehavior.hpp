@@ -0,0 +1,145 @@
+/**
+* \file AnnNativeBehavior.hpp
+* \brief Behaviors written in C++ that can be attached to objects like a script
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <memory>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+
+#include "AnnEventManager.hpp"
+
+namespace Annwvyn
+{
+	class AnnGameObject;
+
+	template <class BehaviorType>
+	class AnnNativeBehaviorPool;
+
+	///Base class of a behavior implemented in C++.
+	///Subclasses need a constructor that takes the owner as it's only argument, and can define their own
+	///`void update()` method. It is called each frame through the concrete type, so it doesn't need to be virtual.
+	///A native behavior is also an event listener, override the event methods to get events.
+	class AnnDllExport AnnNativeBehavior : LISTENER
+	{
+	public:
+		///Construct the behavior for the given object
+		AnnNativeBehavior(AnnGameObject* owner);
+
+		///Destruct the behavior
+		virtual ~AnnNativeBehavior();
+
+		///Default update. Does nothing. Hide it in your behavior with your own update method
+		void update() {}
+
+		///Get the object this behavior is attached to
+		AnnGameObject* getOwner() const;
+
+		///register this object as an event listener
+		void registerAsListener();
+
+		///unregister this object as an event listener
+		void unregisterAsListener();
+
+		///Disabled behaviors are not updated
+		void setEnabled(bool state);
+
+		///Return true if the behavior is updated
+		bool isEnabled() const;
+
+	protected:
+		///Object that owns this behavior
+		AnnGameObject* const owner;
+
+	private:
+		template <class BehaviorType>
+		friend class AnnNativeBehaviorPool;
+
+		///Position of this behavior in the pool of it's type
+		size_t poolIndex;
+
+		///If false, the pool skips this behavior
+		bool enabled;
+	};
+
+	using AnnNativeBehaviorPtr = std::shared_ptr<AnnNativeBehavior>;
+
+	///Non templated interface to the pools of native behaviors
+	class AnnDllExport AnnNativeBehaviorPoolBase
+	{
+	public:
+		///Destruct the pool
+		virtual ~AnnNativeBehaviorPoolBase() = default;
+
+		///Create a behavior for this object
+		virtual AnnNativeBehaviorPtr create(AnnGameObject* owner) = 0;
+
+		///Call update on every behavior in the pool
+		virtual void updateAll() = 0;
+
+		///Number of behaviors living in this pool
+		virtual size_t size() const = 0;
+	};
+
+	///Hold all the living behaviors of one type in a contiguous array, and update them without virtual dispatch
+	template <class BehaviorType>
+	class AnnNativeBehaviorPool : public AnnNativeBehaviorPoolBase, public std::enable_shared_from_this<AnnNativeBehaviorPool<BehaviorType>>
+	{
+		static_assert(std::is_base_of<AnnNativeBehavior, BehaviorType>::value, "Native behaviors needs to inherit from AnnNativeBehavior");
+
+	public:
+		///Create a behavior for this object. The behavior leaves the pool when the last reference to it is released
+		AnnNativeBehaviorPtr create(AnnGameObject* owner) override
+		{
+			std::weak_ptr<AnnNativeBehaviorPool> pool = this->shared_from_this();
+			std::shared_ptr<BehaviorType> behavior(new BehaviorType(owner), [pool](BehaviorType* behavior) {
+				if(auto livingPool = pool.lock()) livingPool->release(behavior);
+				delete behavior;
+			});
+
+			behavior->poolIndex = behaviors.size();
+			behaviors.push_back(behavior.get());
+			return behavior;
+		}
+
+		///Call the update of every behavior through it's concrete type
+		void updateAll() override
+		{
+			//Behaviors may be released while we iterate
+			for(size_t i{ 0 }; i < behaviors.size(); ++i)
+				if(behaviors[i] && behaviors[i]->enabled) behaviors[i]->BehaviorType::update();
+
+			if(holes) compact();
+		}
+
+		///Number of behaviors living in this pool
+		size_t size() const override { return behaviors.size() - holes; }
+
+	private:
+		///Remove a behavior from the array. Leave a hole that is cleaned up after the next update
+		void release(BehaviorType* behavior)
+		{
+			behaviors[behavior->poolIndex] = nullptr;
+			++holes;
+		}
+
+		///Remove the holes left by released behaviors
+		void compact()
+		{
+			behaviors.erase(std::remove(behaviors.begin(), behaviors.end(), nullptr), behaviors.end());
+			for(size_t i{ 0 }; i < behaviors.size(); ++i) behaviors[i]->poolIndex = i;
+			holes = 0;
+		}
+
+		///The behaviors
+		std::vector<BehaviorType*> behaviors;
+
+		///Number of released behaviors still in the array
+		size_t holes{ 0 };
+	};
+}
@@ -0,0 +1,79 @@
+/**
+* \file AnnObjectRecycler.hpp
+* \brief Pool of scene nodes, items and audio sources left by destroyed game objects
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <OgrePrerequisites.h>
+
+namespace Annwvyn
+{
+	class AnnAudioSource;
+
+	///Keep the parts of destroyed game objects, to give them to the next objects created from the same mesh.
+	///Creating an object from recycled parts skip loading the mesh, creating the Ogre item, the scene node and the OpenAL source.
+	class AnnDllExport AnnObjectRecycler
+	{
+	public:
+		///Create an empty pool for objects of this scene manager
+		AnnObjectRecycler(Ogre::SceneManager* sceneManager);
+
+		///Destroy every part still in the pool
+		~AnnObjectRecycler();
+
+		///This class own Ogre objects, it cannot be copied
+		AnnObjectRecycler(const AnnObjectRecycler&) = delete;
+		///This class own Ogre objects, it cannot be copied
+		AnnObjectRecycler& operator=(const AnnObjectRecycler&) = delete;
+
+		///Take the parts of an object made from `mesh`, and remove them from the scene.
+		///Return false if they cannot be reused, for example when other objects are attached to the node
+		bool recycle(const std::string& mesh, Ogre::SceneNode* node, Ogre::Item* item, std::shared_ptr<AnnAudioSource> audioSource);
+
+		///Get the parts of an object previously made from `mesh`, back in the scene with default state. Return false if there are none
+		bool reuse(const std::string& mesh, Ogre::SceneNode*& node, Ogre::Item*& item, std::shared_ptr<AnnAudioSource>& audioSource);
+
+		///Destroy every part in the pool
+		void clear();
+
+		///Number of objects in the pool
+		size_t size() const;
+
+		///Number of objects created from recycled parts since the last clear()
+		size_t getReuseCount() const;
+
+	private:
+		///What is kept from an object
+		struct Parts
+		{
+			///Scene node, detached from the scene
+			Ogre::SceneNode* node;
+			///Item attached to the node
+			Ogre::Item* item;
+			///OpenAL source
+			std::shared_ptr<AnnAudioSource> audioSource;
+		};
+
+		///Destroy the parts of an object
+		void destroy(Parts& parts) const;
+
+		///Scene manager that created the nodes and items
+		Ogre::SceneManager* sceneManager;
+		///Pooled parts for each mesh
+		std::unordered_map<std::string, std::vector<Parts>> pool;
+		///Number of objects in the pool
+		size_t count;
+		///Number of objects reused
+		size_t reuseCount;
+	};
+
+	using AnnObjectRecyclerPtr = std::shared_ptr<AnnObjectRecycler>;
+}
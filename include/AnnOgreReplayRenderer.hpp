@@ -0,0 +1,46 @@
+/**
+* \file AnnOgreReplayRenderer.hpp
+* \brief Renderer that plays back the tracking of an input recording
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include "AnnOgreNoVRRenderer.hpp"
+#include "AnnInputReplay.hpp"
+
+namespace Annwvyn
+{
+	///Renderer that doesn't need any VR hardware, and takes the frame time, the head pose and the hand controllers from a file written by
+	///AnnInputRecorder. The event manager takes the keyboard, mouse and stick input from the same file. Select it with the "Replay" renderer
+	///name, after calling setReplayFile(). The engine quits after the last recorded frame, so a run can be timed and compared to the previous ones
+	class AnnDllExport AnnOgreReplayRenderer : public AnnOgreNoVRRenderer
+	{
+	public:
+		///Create the replay renderer. Throws if the replay file can't be read
+		AnnOgreReplayRenderer(std::string winName = "OgreVRReplayRender");
+
+		///Public static parameter : recording to play back. Please set it before AnnInit or creating an AnnEngine object
+		static void setReplayFile(const std::string& fileName);
+
+		///Return true after the last recorded frame, or if the window is closed
+		bool shouldQuit() override;
+
+		///Take the frame time, the head pose and the hand controllers from the next recorded frame
+		void getTrackingPoseAndVRTiming() override;
+
+		///The recording being played
+		AnnInputReplay* getInputReplay();
+
+	private:
+		///Create or update the hand controller of a side
+		void updateHandController(const AnnInputReplay::Hand& hand);
+
+		///Recording to play back
+		static std::string replayFile;
+
+		///The recording being played
+		AnnInputReplay replay;
+	};
+}
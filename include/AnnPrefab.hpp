@@ -0,0 +1,84 @@
+/**
+* \file AnnPrefab.hpp
+* \brief Template of game object, and pool of preallocated instances of it
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AnnTypes.h"
+
+namespace Annwvyn
+{
+	class AnnGameObject;
+
+	///Description of a game object that is spawned many times : mesh, physics and scripts
+	struct AnnDllExport AnnPrefab
+	{
+		///Mesh the instances are created from
+		std::string mesh;
+		///Scale of the instances
+		AnnVect3 scale{ 1, 1, 1 };
+		///If set to true, instances get a rigid body
+		bool hasPhysics = false;
+		///Mass of the rigid body
+		float mass = 0;
+		///Shape of the rigid body
+		phyShapeType shape = staticShape;
+		///If the rigid body collides with the player
+		bool colideWithPlayer = true;
+		///Scripts attached to every instance
+		std::vector<std::string> scripts;
+	};
+
+	///Game objects made from a prefab, created once and reused.
+	///Spawning an instance only moves it, shows it, and puts it's body back in the physics world. Despawning does the opposite.
+	///Nothing is loaded or allocated unless every instance is already in use, then the pool grows.
+	class AnnDllExport AnnPrefabPool
+	{
+	public:
+		///Create `preallocate` instances of the prefab, out of the game
+		AnnPrefabPool(const std::string& name, const AnnPrefab& prefab, size_t preallocate);
+
+		///Forget the instances. Those still in the game stay there as normal objects
+		~AnnPrefabPool();
+
+		///This class is referenced by it's instances, it cannot be copied
+		AnnPrefabPool(const AnnPrefabPool&) = delete;
+		///This class is referenced by it's instances, it cannot be copied
+		AnnPrefabPool& operator=(const AnnPrefabPool&) = delete;
+
+		///Put an instance in the game at this position and orientation
+		std::shared_ptr<AnnGameObject> spawn(AnnVect3 position, AnnQuaternion orientation);
+
+		///Take the instance out of the game, and make it available for spawn(). Return false if it isn't an active instance of this pool
+		bool despawn(const std::shared_ptr<AnnGameObject>& instance);
+
+		///Number of instances in the game
+		size_t getActiveCount() const;
+
+		///Number of instances waiting to be spawned
+		size_t getAvailableCount() const;
+
+		///Name of the prefab
+		const std::string& getName() const;
+
+	private:
+		///Create a new instance, out of the game
+		std::shared_ptr<AnnGameObject> createInstance();
+
+		///Name of the prefab
+		const std::string name;
+		///Description of the instances
+		const AnnPrefab prefab;
+		///Every instance this pool created
+		std::vector<std::shared_ptr<AnnGameObject>> instances;
+		///Instances out of the game
+		std::vector<std::shared_ptr<AnnGameObject>> available;
+	};
+}
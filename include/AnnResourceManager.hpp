@@ -3,6 +3,7 @@
 #include "systemMacro.h"
 #include "OgreResourceGroupManager.h"
 #include "AnnSubsystem.hpp"
+#include "AnnResourcePreloader.hpp"
 
 namespace Annwvyn
 {
@@ -30,12 +31,32 @@ namespace Annwvyn
 		///Load in memory the content of the specified group
 		void loadGroup(const std::string& groupName) const;
 
+		///Load the content of the group in the background. Files are read and decoded by worker threads, then uploaded a bit at each frame
+		/// \param groupName name of the resource group
+		/// \return Handle to poll the progress of the load
+		AnnResourcePreloadPtr loadGroupAsync(const std::string& groupName);
+
+		///Load the content of multiple groups in the background. Files of every group are read in parallel
+		/// \param groupNames names of the resource groups
+		/// \return Handle to poll the progress of the load
+		AnnResourcePreloadPtr loadGroupsAsync(const std::vector<std::string>& groupNames);
+
+		///Set the time spent uploading preloaded resources at each frame, in milliseconds
+		void setUploadBudget(double milliseconds) const;
+
 		///Return the default resource group name
 		static const char* getDefaultResourceGroupName();
 
 		///Return the reserved resource group name
 		static const char* getReservedResourceGroupName();
 
+	protected:
+		///Upload the resources loaded in the background
+		void update() override;
+
+		///Return true while resources are loaded in the background
+		bool needUpdate() override;
+
 	private:
 		///Log the fact that resource location creation as been rejected
 		static void refuseResource(const std::string& name, const std::string& group);
@@ -45,6 +66,9 @@ namespace Annwvyn
 
 		///Pointer to the resource group manager. We cache the address to prevent calling a static method all the time
 		Ogre::ResourceGroupManager* ResourceGroupManager;
+
+		///Worker threads and upload queue of the background loads
+		std::unique_ptr<AnnResourcePreloader> preloader;
 	};
 
 	using AnnResourceManagerPtr = std::shared_ptr<AnnResourceManager>;
@@ -0,0 +1,183 @@
+/**
+* \file AnnResourcePreloader.hpp
+* \brief Load resource groups in the background : read and decode on worker threads, upload on the main thread
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <OgreArchive.h>
+#include <OgreDataStream.h>
+#include <OgreImage.h>
+
+namespace Annwvyn
+{
+	class AnnResourcePreloader;
+
+	///Progress of resource groups loaded by AnnResourceManager::loadGroupsAsync(). Poll it, or wait() for it
+	class AnnDllExport AnnResourcePreload
+	{
+	public:
+		///Created by the preloader
+		AnnResourcePreload(AnnResourcePreloader* preloader, std::vector<std::string> groups);
+
+		///Fraction of the work done, between 0 and 1. Reading and uploading count for half each
+		float getProgress() const;
+
+		///Return true once every resource is uploaded and the groups are loaded
+		bool isDone() const;
+
+		///Number of resources handled by the preloader
+		size_t getResourceCount() const;
+
+		///Number of resources uploaded
+		size_t getUploadedCount() const;
+
+		///Number of resources that couldn't be read or decoded
+		size_t getFailedCount() const;
+
+		///The loaded groups
+		const std::vector<std::string>& getGroups() const;
+
+		///Upload resources on this thread until everything is loaded. Only call it from the main thread
+		void wait();
+
+	private:
+		friend class AnnResourcePreloader;
+
+		///Preloader doing the work
+		AnnResourcePreloader* const preloader;
+		///The loaded groups
+		const std::vector<std::string> groups;
+		///Number of resources handled by the preloader
+		size_t resourceCount;
+		///Number of resources read and decoded by the workers
+		std::atomic<size_t> readCount;
+		///Number of resources uploaded
+		size_t uploadedCount;
+		///Number of resources that couldn't be read or decoded
+		size_t failedCount;
+		///Set once the groups are loaded
+		bool done;
+	};
+
+	using AnnResourcePreloadPtr = std::shared_ptr<AnnResourcePreload>;
+
+	///Load the files of resource groups in parallel. Worker threads read the files in memory and decode images.
+	///Creating Ogre and OpenAL objects from them needs to happen on the main thread : the upload queue is processed at each frame, for a limited time.
+	///Textures are uploaded with Ogre's TextureManager, meshes are converted to v2 meshes, and sounds are loaded in OpenAL buffers.
+	///Meshes and sounds are created from the bytes the workers read, the main thread doesn't open their files again.
+	///Once every file is handled, the groups are loaded by Ogre's ResourceGroupManager, that only has the remaining resources to load.
+	class AnnDllExport AnnResourcePreloader
+	{
+	public:
+		///Start the worker threads. 0 means one less than the number of hardware threads
+		AnnResourcePreloader(size_t workerCount = 0);
+
+		///Stop the worker threads. Unfinished loads are abandoned
+		~AnnResourcePreloader();
+
+		///This class own threads, it cannot be copied
+		AnnResourcePreloader(const AnnResourcePreloader&) = delete;
+		///This class own threads, it cannot be copied
+		AnnResourcePreloader& operator=(const AnnResourcePreloader&) = delete;
+
+		///Initialize the groups, and queue their files. Groups already loaded are skipped
+		AnnResourcePreloadPtr load(const std::vector<std::string>& groups);
+
+		///Upload resources for about `budget` milliseconds. Always upload at least one. Main thread only
+		void upload(double budget);
+
+		///Return true if some loads are not done yet
+		bool hasWork() const;
+
+		///Set the time spent uploading resources at each frame, in milliseconds
+		void setUploadBudget(double milliseconds);
+
+		///Get the time spent uploading resources at each frame, in milliseconds
+		double getUploadBudget() const;
+
+		///Number of worker threads
+		size_t getWorkerCount() const;
+
+	private:
+		///What the main thread does with a file
+		enum class ResourceKind {
+			texture,
+			mesh,
+			sound
+		};
+
+		///A file to load
+		struct Job
+		{
+			///Load this file belongs to
+			AnnResourcePreloadPtr preload;
+			///Name of the resource
+			std::string name;
+			///Group of the resource
+			std::string group;
+			///Archive containing the file
+			Ogre::Archive* archive;
+			///Serialize access to archives that can't be read concurrently
+			std::mutex* archiveMutex;
+			///What the main thread does with it
+			ResourceKind kind;
+			///Content of the file
+			Ogre::DataStreamPtr data;
+			///Decoded texture
+			Ogre::Image image;
+			///Set if the file couldn't be read or decoded
+			bool failed = false;
+		};
+
+		///Return true and set kind if the preloader knows what to do with this file
+		static bool getResourceKind(const std::string& fileName, ResourceKind& kind);
+
+		///Read and decode queued files until stopped
+		void workerLoop();
+
+		///Read the file, and decode it if it's an image
+		static void read(Job& job);
+
+		///Give the resource to the engine. Return false if it failed
+		static bool uploadResource(Job& job);
+
+		///Load the groups with Ogre once every file is uploaded
+		static void finish(AnnResourcePreload& preload);
+
+		///The worker threads
+		std::vector<std::thread> workers;
+		///Protects readQueue and running
+		std::mutex readMutex;
+		///Wakes the workers up
+		std::condition_variable readCondition;
+		///Files to read
+		std::deque<std::unique_ptr<Job>> readQueue;
+		///Cleared to stop the workers
+		bool running;
+
+		///Protects uploadQueue
+		mutable std::mutex uploadMutex;
+		///Files read, waiting for the main thread
+		std::deque<std::unique_ptr<Job>> uploadQueue;
+
+		///Loads that are not done yet
+		std::vector<AnnResourcePreloadPtr> inProgress;
+		///One mutex per archive that isn't a plain directory
+		std::unordered_map<Ogre::Archive*, std::mutex> archiveMutexes;
+		///Time spent uploading at each frame
+		double uploadBudget;
+	};
+}
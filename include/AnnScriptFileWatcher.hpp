@@ -0,0 +1,64 @@
+/**
+* \file AnnScriptFileWatcher.hpp
+* \brief Watch script files on disk and report when they are modified
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <ctime>
+
+namespace Annwvyn
+{
+	///Non-blocking watcher for a set of files. Uses inotify on Linux, and polls the modification time of the files elsewhere.
+	class AnnDllExport AnnScriptFileWatcher
+	{
+	public:
+		///Create a watcher that doesn't watch anything yet
+		AnnScriptFileWatcher();
+
+		///Release the OS resources used to watch the files
+		~AnnScriptFileWatcher();
+
+		///This class holds OS handles, it cannot be copied
+		AnnScriptFileWatcher(const AnnScriptFileWatcher&) = delete;
+		///This class holds OS handles, it cannot be copied
+		AnnScriptFileWatcher& operator=(const AnnScriptFileWatcher&) = delete;
+
+		///Start watching a file
+		/// \param path Path to the file, including its directory
+		void watch(const std::string& path);
+
+		///Return the path of every watched file that has been written to since the last call. Never blocks
+		std::vector<std::string> getModifiedFiles();
+
+	private:
+		///Split a path into the directory and the file name
+		static std::pair<std::string, std::string> splitPath(const std::string& path);
+
+#ifdef __linux__
+		///inotify instance
+		int inotifyDescriptor;
+		///Directory watched by each inotify watch descriptor
+		std::unordered_map<int, std::string> watchedDirectories;
+		///Full path of the watched files
+		std::unordered_set<std::string> watchedFiles;
+#else
+		///Last known modification time of each watched file
+		std::unordered_map<std::string, time_t> watchedFiles;
+		///Last time the modification time of the files has been checked
+		std::chrono::steady_clock::time_point lastPoll;
+		///Minimal delay between two checks of the modification times
+		static constexpr const std::chrono::milliseconds pollInterval{ 500 };
+
+		///Get the modification time of a file, 0 if it cannot be stat'ed
+		static time_t getModificationTime(const std::string& path);
+#endif
+	};
+}
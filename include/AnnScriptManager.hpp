@@ -2,14 +2,24 @@
 
 #include <systemMacro.h>
 #include <AnnScriptFile.hpp>
+#include <AnnScriptFileWatcher.hpp>
+#include <AnnNativeBehavior.hpp>
 #include <AnnSubsystem.hpp>
 #include <AnnEventManager.hpp>
 #include <AnnLightObject.hpp>
+#include <AnnLogger.hpp>
 
 #include <chaiscript.hpp>
 #include <chaiscript_stdlib.hpp>
 #include <AnnTypes.h>
 
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_set>
+
 namespace Annwvyn
 {
 	class AnnGameObject;
@@ -35,6 +45,25 @@ namespace Annwvyn
 		PlayerCollisionHook
 	};
 
+	///Time spent in the update and the event hooks of a script
+	struct AnnDllExport AnnScriptProfile
+	{
+		///Name of the script. For a single instance, followed by the name of the owner
+		std::string name;
+		///Number of living instances measured
+		size_t instances{ 0 };
+		///Time spent during the last frame, in milliseconds
+		double lastFrameTime{ 0 };
+		///Longest frame since the creation of the script, in milliseconds
+		double peakFrameTime{ 0 };
+		///Time spent since the creation of the script, in milliseconds
+		double totalTime{ 0 };
+		///Number of calls to update
+		size_t updateCalls{ 0 };
+		///Number of calls to the event hooks
+		size_t eventCalls{ 0 };
+	};
+
 	///Object that reprenset a script defining an object "behavior"
 	class AnnDllExport AnnBehaviorScript : LISTENER
 	{
@@ -63,24 +92,61 @@ namespace Annwvyn
 		///unregister this object as an event listener
 		void unregisterAsListener();
 
+		///Disabled scripts are not updated
+		void setEnabled(bool state);
+
+		///Return true if the script is updated
+		bool isEnabled() const;
+
 		///Event from the keyboard
-		void KeyEvent(AnnKeyEvent e) override;
+		void KeyEvent(const AnnKeyEvent& e) override;
 		///Event from the mouse
-		void MouseEvent(AnnMouseEvent e) override;
+		void MouseEvent(const AnnMouseEvent& e) override;
 		///Event for a Joystick
-		void ControllerEvent(AnnControllerEvent e) override;
+		void ControllerEvent(const AnnControllerEvent& e) override;
 		///Event from a timer
-		void TimeEvent(AnnTimeEvent e) override;
+		void TimeEvent(const AnnTimeEvent& e) override;
 		///Event from a trigger
-		void TriggerEvent(AnnTriggerEvent e) override;
+		void TriggerEvent(const AnnTriggerEvent& e) override;
 		///Event from an HandController
-		void HandControllerEvent(AnnHandControllerEvent e) override;
+		void HandControllerEvent(const AnnHandControllerEvent& e) override;
 		///Event from the collision between 2 game objects
-		void CollisionEvent(AnnCollisionEvent e) override;
+		void CollisionEvent(const AnnCollisionEvent& e) override;
 		///Event from the collision between the player and a game object
-		void PlayerCollisionEvent(AnnPlayerCollisionEvent e) override;
+		void PlayerCollisionEvent(const AnnPlayerCollisionEvent& e) override;
+
+		///Replace the script definition used by this object. Used by the script manager when a script is hot-reloaded
+		void _hotSwap(std::function<void(chaiscript::Boxed_Value&)> updateHook,
+					  AnnBehaviorScriptHooks hooks,
+					  chaiscript::Boxed_Value scriptObjectInstance);
+
+		///Get the ChaiScript instance of the class. Used by the script manager when a script is hot-reloaded
+		chaiscript::Boxed_Value _getScriptObjectInstance() const;
+
+		///Get the time spent in this instance
+		const AnnScriptProfile& getProfile() const;
+
+		///Close the current profiling frame. Return what have been measured during it. Called once per frame by the script domain
+		AnnScriptProfile _endProfilingFrame();
 
 	private:
+		///Add the time spent in a scope to the current profiling frame of a script
+		class ProfileScope
+		{
+		public:
+			///Start measuring
+			ProfileScope(std::chrono::steady_clock::duration& time, size_t& calls) :
+			 time(time), start(std::chrono::steady_clock::now()) { ++calls; }
+			///Stop measuring
+			~ProfileScope() { time += std::chrono::steady_clock::now() - start; }
+
+		private:
+			///Counter to add the time to
+			std::chrono::steady_clock::duration& time;
+			///Start of the measure
+			const std::chrono::steady_clock::time_point start;
+		};
+
 		///Validity state of this object. Cannot change.
 		const bool valid;
 
@@ -114,62 +180,128 @@ namespace Annwvyn
 
 		///Just call the update on the instance
 		void callUpdateOnScript() { callUpdateOnScriptInstance(ScriptObjectInstance); }
+
+		///Time spent in this script since the start of the current frame
+		std::chrono::steady_clock::duration frameTime;
+		///Calls to update since the start of the current frame
+		size_t frameUpdateCalls;
+		///Calls to the event hooks since the start of the current frame
+		size_t frameEventCalls;
+		///Accumulated timings of the previous frames
+		AnnScriptProfile profile;
+		///If false, update does nothing. Can be changed while a script domain runs the script
+		std::atomic<bool> enabled{ true };
 	};
 
-	///Script Manager, serve as an interface between ChaiScript and the rest of the engine
-	class AnnDllExport AnnScriptManager : public AnnSubSystem
+	///List of commands recorded by a script domain, to be applied later on the main thread
+	class AnnDllExport AnnScriptCommandBuffer
+	{
+	public:
+		///Record a command
+		void push(std::function<void()> command);
+
+		///Run all the recorded commands in order, and clear the buffer
+		void apply();
+
+	private:
+		///The commands
+		std::vector<std::function<void()>> commands;
+	};
+
+	///A ChaiScript interpreter with the Annwvyn API, and the behavior scripts evaluated in it.
+	///A concurrent domain update it's scripts on it's own thread, in parallel with the other domains. While that happen, everything
+	///a script does that modify the scene is recorded and applied later by the main thread.
+	class AnnDllExport AnnScriptDomain
 	{
 	public:
 		using AnnScriptID = uID;
 
-		///Construct the script manager, initialize ChaiScript and add global functions. Will initialize the AnnScriptFileManager
-		AnnScriptManager();
+		///Construct a domain.
+		/// \param name Name of the domain
+		/// \param concurrent If true, the domain start a thread to update it's scripts.
+		AnnScriptDomain(const std::string& name, bool concurrent);
 
-		///Destruct the Script Manager. will destroy the AnnScriptFileManager
-		~AnnScriptManager();
+		///Stop the domain's thread
+		~AnnScriptDomain();
 
-		///This subsystem doesn't need to be updated
-		bool needUpdate() override { return false; }
+		///Get the name of this domain
+		std::string getName() const;
 
-		///This method does nothing
-		void update() override {}
+		///Return true if this domain update it's script on it's own thread
+		bool isConcurrent() const;
 
 		///Evaluate a file. Exceptions internally catches with messages in the log. Return true or false depending on errors
 		bool evalFile(const std::string& file);
 
-		///Create a instance to the script. Return a shared pointer.
-		std::shared_ptr<AnnBehaviorScript> getBehaviorScript(const std::string& scriptName, AnnGameObject* owner = nullptr);
-
 		///Evaluate one line of chaiCode
 		void evalString(const std::string& chaiCode);
 
 		///GetAccess to the chaiscript engine. Only use for special cases.
 		chaiscript::ChaiScript* _getEngine();
 
+		///Create an instance of the class defined in the script file. Evaluate the file first if needed
+		std::shared_ptr<AnnBehaviorScript> getBehaviorScript(const AnnScriptFilePtr& scriptFile, const std::string& scriptName, AnnGameObject* owner);
+
+		///Return true if the given script has been evaluated by this domain
+		bool hasLoaded(const std::string& scriptName) const;
+
+		///Evaluate a new version of a script class, and migrate every instance of it to the new definition
+		bool reloadScript(const std::string& scriptName, const std::string& sourceCode);
+
+		///Ask the domain's thread to update the scripts. Only for concurrent domains
+		void beginUpdate();
+
+		///Wait for the update started by beginUpdate() to finish
+		void waitUpdate();
+
+		///Apply the commands recorded during the last update
+		void applyCommands();
+
+		///Close the profiling frame of every living script, and accumulate their timings per script class
+		void endProfilingFrame();
+
+		///Get the accumulated timings of each script class evaluated in this domain
+		const std::unordered_map<std::string, AnnScriptProfile>& getScriptProfiles() const;
+
+		///Get the timings of each living script instance of this domain
+		std::vector<AnnScriptProfile> getScriptInstanceProfiles() const;
+
+		///Run the command now if called from the main thread. If called while a concurrent domain is updating, record it to run it later on the main thread.
+		static void runOnMainThread(std::function<void()> command);
+
+		///Return true if called from the thread of a concurrent domain that is updating it's scripts
+		static bool isRecordingCommands();
+
+		///Prefix for error regarding loading script files
+		static constexpr const char* const fileErrorPrefix{ "Script File ERROR - " };
+
 	private:
+		///Name of the domain
+		const std::string name;
+
 		///ChaiScript engine
 		chaiscript::ChaiScript chai;
 
-		///Pointer to the script manager
-		AnnScriptFileResourceManager* scriptFileManager;
+		///Hook the event listener's "methdod" to the script ones, if possible...
+		void tryAndGetEventHooks();
 
-		///Register to the script engine all the things that are possible to do. Called by the constructor
-		void registerApi();
+		///Return the hooks found by the last call to tryAndGetEventHooks()
+		AnnBehaviorScriptHooks getEventHooks() const;
 
-		///Register the scriptFileManager
-		void registerResourceManager();
+		///Evaluate the template that create an instance of the given class, and call it
+		chaiscript::Boxed_Value createScriptInstance(const std::string& className, const std::string& ownerTag);
 
-		///Unregister the scriptFileManager
-		void unregisterResourceManager();
+		///Copy the attributes of a script instance to a new one
+		static void migrateScriptState(const chaiscript::Boxed_Value& from, chaiscript::Boxed_Value& to);
 
-		///The extension of script files
-		static constexpr const char* const scriptExtension{ ".chai" };
+		///Rename every use of a class name in a piece of source code. String literals are left alone
+		static std::string renameScriptClass(const std::string& source, const std::string& from, const std::string& to);
 
-		///Prefix for error regarding loading script files
-		static constexpr const char* const fileErrorPrefix{ "Script File ERROR - " };
+		///Call update on every living script of this domain
+		void updateScripts();
 
-		///Prefix for debug print called from a script
-		static constexpr const char* const logFromScript{ "Script - " };
+		///Body of the domain's thread
+		void workerLoop();
 
 		///String constant for script loading and class initialization. This is a bit of ChaiScript code to bootstrap a behavior script
 		static constexpr const char* const scriptTemplate{
@@ -190,6 +322,8 @@ namespace Annwvyn
 		static constexpr const char* const scriptInstanceMarker{ "ScriptInstance" };
 		///Prefix for the owner of a script
 		static constexpr const char* const scriptOwnerPrefix{ "ScriptOwner" };
+		///Separator between the name of the class and the revision number of a reloaded script class
+		static constexpr const char* const scriptRevisionMarker{ "__rev" };
 
 		///Static lengths of constant string of the same name
 		static constexpr const size_t nameMarkerLen{ 15 };
@@ -198,8 +332,8 @@ namespace Annwvyn
 		///Static lengths of constant string of the same name
 		static constexpr const size_t scriptOwnerMarkerLen{ 16 };
 
-		///Static counter that will be incremented at each script creation
-		static AnnScriptID ID;
+		///Static counter that will be incremented at each script creation. Shared by all domains
+		static std::atomic<AnnScriptID> ID;
 
 		///To create the event hooks for the scripts :
 		std::function<void(chaiscript::Boxed_Value&, AnnKeyEvent)> callKeyEventOnScriptInstance;
@@ -211,8 +345,168 @@ namespace Annwvyn
 		std::function<void(chaiscript::Boxed_Value&, AnnCollisionEvent)> callCollisionEventOnScriptInstance;
 		std::function<void(chaiscript::Boxed_Value&, AnnPlayerCollisionEvent)> callPlayerCollisionEventOnScriptInstance;
 
-		///Hook the event listener's "methdod" to the script ones, if possible...
-		void tryAndGetEventHooks();
+		///A living behavior script, and the tag needed to construct it again
+		struct AnnLiveBehaviorScript
+		{
+			///The script object
+			std::weak_ptr<AnnBehaviorScript> script;
+			///Name of the owner passed to the script constructor
+			std::string ownerTag;
+		};
+
+		///Living instances of each script
+		std::unordered_map<std::string, std::vector<AnnLiveBehaviorScript>> liveScripts;
+
+		///Scripts evaluated by this domain
+		std::unordered_set<std::string> loadedScripts;
+
+		///Name of the ChaiScript class currently defining each script. Only contains reloaded scripts
+		std::unordered_map<std::string, std::string> scriptClassNames;
+
+		///Number of times each script has been reloaded
+		std::unordered_map<std::string, size_t> scriptRevisions;
+
+		///Commands recorded by the scripts during a concurrent update
+		AnnScriptCommandBuffer commands;
+
+		///Accumulated timings of each script class
+		std::unordered_map<std::string, AnnScriptProfile> scriptProfiles;
+
+		///Thread of a concurrent domain
+		std::thread worker;
+		///Protect the state of the worker
+		std::mutex workerMutex;
+		///Signal the worker's state changes
+		std::condition_variable workerCondition;
+		///Set by beginUpdate(), cleared by the worker when the update is done
+		bool updateRequested;
+		///Set by the destructor to stop the worker
+		bool stopRequested;
+	};
+
+	using AnnScriptDomainPtr = std::shared_ptr<AnnScriptDomain>;
+
+	///Script Manager, serve as an interface between ChaiScript and the rest of the engine
+	class AnnDllExport AnnScriptManager : public AnnSubSystem
+	{
+	public:
+		using AnnScriptID = AnnScriptDomain::AnnScriptID;
+
+		///Construct the script manager, initialize ChaiScript and add global functions. Will initialize the AnnScriptFileManager
+		AnnScriptManager();
+
+		///Destruct the Script Manager. will destroy the AnnScriptFileManager
+		~AnnScriptManager();
+
+		///This subsystem is updated every frame to close the profiling frame of the scripts
+		bool needUpdate() override { return true; }
+
+		///Reload the scripts that have been modified on disk, update the script domains, and accumulate the script timings
+		void update() override;
+
+		///Evaluate a file. Exceptions internally catches with messages in the log. Return true or false depending on errors
+		bool evalFile(const std::string& file);
+
+		///Create a instance to the script. Return a shared pointer.
+		std::shared_ptr<AnnBehaviorScript> getBehaviorScript(const std::string& scriptName, AnnGameObject* owner = nullptr);
+
+		///Create a instance to the script inside a script domain. The script will be updated by the domain, not by the owner
+		std::shared_ptr<AnnBehaviorScript> getBehaviorScript(const std::string& scriptName, AnnGameObject* owner, const std::string& domainName);
+
+		///Evaluate one line of chaiCode
+		void evalString(const std::string& chaiCode);
+
+		///GetAccess to the chaiscript engine. Only use for special cases.
+		chaiscript::ChaiScript* _getEngine();
+
+		///Get a concurrent script domain. The domain is created with the Annwvyn API if it doesn't exist yet
+		AnnScriptDomainPtr getScriptDomain(const std::string& domainName);
+
+		///Get the timings of every script class, merged across all domains. Sorted by decreasing time spent in the last frame
+		std::vector<AnnScriptProfile> getScriptProfiles() const;
+
+		///Get the timings of every living script instance. Sorted by decreasing time spent in the last frame
+		std::vector<AnnScriptProfile> getScriptInstanceProfiles() const;
+
+		///Watch the script files on disk, and reload them when they are modified. Disabled by default
+		void setHotReload(bool state = true);
+
+		///Return true if the script files are watched for modifications
+		bool isHotReloadEnabled() const;
+
+		///Evaluate again the class defined in a script file, and migrate every object using it to the new definition.
+		///The attributes of the living script instances are kept.
+		/// \param scriptName Name of the script (without the .chai extension)
+		/// \return false if the script was not loaded or if the new code doesn't evaluate. The old definition stays in use in that case
+		bool reloadScript(const std::string& scriptName);
+
+		///Register a behavior written in C++. Objects can attach it by name, like a script. A native behavior takes precedence over a script of the same name
+		/// \tparam BehaviorType A class inheriting from AnnNativeBehavior
+		/// \param name Name used to attach the behavior to an object
+		template <class BehaviorType>
+		void registerNativeBehavior(const std::string& name)
+		{
+			if(isNativeBehavior(name)) AnnDebug() << "Warning: replacing native behavior " << name << ". Living instances will not be updated anymore";
+			nativeBehaviors[name] = std::make_shared<AnnNativeBehaviorPool<BehaviorType>>();
+		}
+
+		///Return true if a native behavior is registered under this name
+		bool isNativeBehavior(const std::string& name) const;
+
+		///Create a native behavior for this object. Return nullptr if there's no native behavior with that name
+		AnnNativeBehaviorPtr createNativeBehavior(const std::string& name, AnnGameObject* owner);
+
+		///Update every living native behavior, one type at a time
+		void updateNativeBehaviors();
+
+	private:
+		///The domain running on the main thread
+		AnnScriptDomainPtr mainDomain;
+
+		///Concurrent domains, by name
+		std::unordered_map<std::string, AnnScriptDomainPtr> domains;
+
+		///Pointer to the script manager
+		AnnScriptFileResourceManager* scriptFileManager;
+
+		///Import the script API module in a script engine. Called for each domain
+		static void registerApi(chaiscript::ChaiScript& chai);
+
+		///Get the module containing all the things that are possible to do from a script. Built on first call only
+		static chaiscript::ModulePtr getApiModule();
+
+		///Create the module containing the bindings of the engine API
+		static chaiscript::ModulePtr buildApiModule();
+
+		///Register the scriptFileManager
+		void registerResourceManager();
+
+		///Unregister the scriptFileManager
+		void unregisterResourceManager();
+
+		///Get the file containing a script. Load it and watch it if needed
+		AnnScriptFilePtr getScriptFile(const std::string& scriptName);
+
+		///The extension of script files
+		static constexpr const char* const scriptExtension{ ".chai" };
+
+		///Prefix for debug print called from a script
+		static constexpr const char* const logFromScript{ "Script - " };
+
+		///Return the path on disk of a script file. Empty if the file doesn't come from the file-system
+		static std::string getScriptFilePath(const AnnScriptFilePtr& scriptFile);
+
+		///Start watching a script file for modifications
+		void watchScriptFile(const std::string& scriptName, const std::string& path);
+
+		///Path on disk of every loaded script file, and the script it contains
+		std::unordered_map<std::string, std::string> scriptFilePaths;
+
+		///Watcher on the script files. Only exist if hot reload is enabled
+		std::unique_ptr<AnnScriptFileWatcher> fileWatcher;
+
+		///Pools of native behaviors, by name
+		std::unordered_map<std::string, std::shared_ptr<AnnNativeBehaviorPoolBase>> nativeBehaviors;
 	};
 
 	using AnnScriptManagerPtr = std::shared_ptr<AnnScriptManager>;
@@ -0,0 +1,166 @@
+/**
+* \file AnnSlotMap.hpp
+* \brief Dense container with constant time removal and stable generational handles
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Annwvyn
+{
+	///Stable reference to an element of an AnnSlotMap.
+	///The generation changes each time the slot is freed, so a handle to a removed element never points to the element that reuses it's slot
+	struct AnnSlotHandle
+	{
+		///Value of index for a handle that doesn't point to anything
+		static constexpr uint32_t invalidIndex{ 0xFFFFFFFF };
+
+		///Index of the slot
+		uint32_t index;
+		///Generation of the slot when the handle was made
+		uint32_t generation;
+
+		///Construct an invalid handle
+		AnnSlotHandle() :
+		 index(invalidIndex), generation(0) {}
+
+		///Construct a handle to a slot
+		AnnSlotHandle(uint32_t index, uint32_t generation) :
+		 index(index), generation(generation) {}
+
+		///Return true if this handle was made by a slot map. It may still be stale
+		bool isSet() const { return index != invalidIndex; }
+
+		///Compare two handles
+		bool operator==(const AnnSlotHandle& other) const { return index == other.index && generation == other.generation; }
+		///Compare two handles
+		bool operator!=(const AnnSlotHandle& other) const { return !(*this == other); }
+	};
+
+	///Store shared pointers contiguously, for fast iteration, and give each of them a handle.
+	///Insertion, lookup by handle and removal are constant time. Removal moves the last element in the hole, so the order isn't kept.
+	template <class T>
+	class AnnSlotMap
+	{
+	public:
+		///Type of the stored pointers
+		using ElementPtr = std::shared_ptr<T>;
+		///Iterator over the elements
+		using const_iterator = typename std::vector<ElementPtr>::const_iterator;
+
+		///Add an element, and return it's handle
+		AnnSlotHandle insert(ElementPtr element)
+		{
+			uint32_t index;
+			if(freeSlots.empty())
+			{
+				index = uint32_t(slots.size());
+				slots.push_back({ 0, 0 });
+			}
+			else
+			{
+				index = freeSlots.back();
+				freeSlots.pop_back();
+			}
+
+			slots[index].element = uint32_t(elements.size());
+			elements.push_back(std::move(element));
+			elementSlots.push_back(index);
+			return { index, slots[index].generation };
+		}
+
+		///Remove the element referenced by the handle. Return false if the handle is stale
+		bool erase(const AnnSlotHandle& handle)
+		{
+			if(!contains(handle)) return false;
+
+			//Swap and pop
+			const auto hole = slots[handle.index].element;
+			const auto last = uint32_t(elements.size() - 1);
+			if(hole != last)
+			{
+				elements[hole]					 = std::move(elements[last]);
+				elementSlots[hole]				 = elementSlots[last];
+				slots[elementSlots[hole]].element = hole;
+			}
+			elements.pop_back();
+			elementSlots.pop_back();
+
+			release(handle.index);
+			return true;
+		}
+
+		///Remove every element. Every handle becomes stale
+		void clear()
+		{
+			for(const auto index : elementSlots)
+				release(index);
+			elements.clear();
+			elementSlots.clear();
+		}
+
+		///Return true if the handle points to an element of this map
+		bool contains(const AnnSlotHandle& handle) const
+		{
+			return handle.index < slots.size() && slots[handle.index].generation == handle.generation && slots[handle.index].element != AnnSlotHandle::invalidIndex;
+		}
+
+		///Get the element referenced by the handle, or nullptr if the handle is stale
+		T* get(const AnnSlotHandle& handle) const
+		{
+			if(!contains(handle)) return nullptr;
+			return elements[slots[handle.index].element].get();
+		}
+
+		///Get the shared pointer referenced by the handle, or nullptr if the handle is stale
+		ElementPtr getShared(const AnnSlotHandle& handle) const
+		{
+			if(!contains(handle)) return nullptr;
+			return elements[slots[handle.index].element];
+		}
+
+		///Element at a position in the dense array. Positions change when elements are removed
+		const ElementPtr& operator[](size_t position) const { return elements[position]; }
+
+		///Number of elements
+		size_t size() const { return elements.size(); }
+		///Return true if there are no elements
+		bool empty() const { return elements.empty(); }
+		///Start of the elements
+		const_iterator begin() const { return elements.begin(); }
+		///End of the elements
+		const_iterator end() const { return elements.end(); }
+
+	private:
+		///Make a slot available again, with a new generation
+		void release(uint32_t index)
+		{
+			slots[index].element = AnnSlotHandle::invalidIndex;
+			++slots[index].generation;
+			freeSlots.push_back(index);
+		}
+
+		///Indirection from a handle to the element
+		struct Slot
+		{
+			///Position of the element in the dense array, or invalidIndex if the slot is free
+			uint32_t element;
+			///Incremented each time the slot is freed
+			uint32_t generation;
+		};
+
+		///The elements, without holes
+		std::vector<ElementPtr> elements;
+		///Slot of each element
+		std::vector<uint32_t> elementSlots;
+		///Slots, referenced by the handles
+		std::vector<Slot> slots;
+		///Slots that can be reused
+		std::vector<uint32_t> freeSlots;
+	};
+}
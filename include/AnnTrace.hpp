@@ -0,0 +1,111 @@
+/**
+* \file AnnTrace.hpp
+* \brief Record typed performance events to a binary trace file
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include "systemMacro.h"
+#include "AnnTraceFormat.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Annwvyn
+{
+	///Binary trace of what the engine does each frame : frames, subsystem updates, level switches, resource uploads and script errors.
+	///Records are small and fixed size, strings are written once. Convert a trace to CSV or JSON with the AnnTraceReader tool.
+	///When no trace is recording, each hook costs a single atomic load. Can be called from any thread
+	class AnnDllExport AnnTrace
+	{
+	public:
+		///Time point used by the hooks
+		using TimePoint = std::chrono::steady_clock::time_point;
+
+		///Start writing a trace to a file. Stop the previous one. Return false if the file can't be opened
+		static bool start(const std::string& fileName);
+
+		///Write what is buffered and close the file
+		static void stop();
+
+		///Return true if a trace is being written
+		static bool isRecording() { return recording.load(std::memory_order_relaxed); }
+
+		///Current time, to pass to the hooks that take a start time
+		static TimePoint now() { return std::chrono::steady_clock::now(); }
+
+		///A frame starts
+		static void frameBegin();
+
+		///The frame ends
+		static void frameEnd();
+
+		///A subsystem was updated
+		/// \param name Name of the subsystem
+		/// \param start When the update started
+		/// \param end When the update finished
+		static void subsystem(const std::string& name, TimePoint start, TimePoint end);
+
+		///A level switch reached a step
+		/// \param level Name of the level
+		/// \param phase The step
+		static void levelPhase(const std::string& level, AnnTraceFormat::LevelPhase phase);
+
+		///A resource was uploaded
+		/// \param name Name of the resource
+		/// \param group Resource group
+		/// \param kind Kind of resource, as a AnnResourcePreloader::ResourceKind
+		/// \param bytes Size of the resource data
+		/// \param start When the upload started
+		/// \param end When the upload finished
+		static void resourceLoad(const std::string& name, const std::string& group, uint32_t kind, uint64_t bytes, TimePoint start, TimePoint end);
+
+		///A script raised an evaluation error
+		/// \param script Name of the script
+		/// \param message Message of the error
+		static void scriptError(const std::string& script, const std::string& message);
+
+	private:
+		///Microseconds from the start of the trace to a time point
+		static uint64_t toTraceTime(TimePoint time);
+
+		///Microseconds between two time points, clamped to 32 bits
+		static uint32_t toDuration(TimePoint start, TimePoint end);
+
+		///Get the id of a string, define it in the trace if it's new. Lock held
+		static uint32_t intern(const std::string& text);
+
+		///Append a record to the buffer. Lock held
+		static void append(AnnTraceFormat::RecordType type, const void* payload, size_t size, const void* extra = nullptr, size_t extraSize = 0);
+
+		///Append a record of a type
+		template <class Record>
+		static void append(AnnTraceFormat::RecordType type, const Record& record)
+		{
+			append(type, &record, sizeof record);
+		}
+
+		///Write the buffer to the file. Lock held
+		static void writeBuffer();
+
+		///Set while a trace is being written
+		static std::atomic<bool> recording;
+		///Protects everything below
+		static std::mutex mutex;
+		///The trace file
+		static std::ofstream file;
+		///Records not written yet
+		static std::vector<char> buffer;
+		///Id of each string already defined
+		static std::unordered_map<std::string, uint32_t> strings;
+		///When the trace started
+		static TimePoint startTime;
+		///Number of frames started
+		static uint64_t frameCount;
+	};
+}
@@ -0,0 +1,140 @@
+/**
+* \file AnnTraceFormat.hpp
+* \brief Layout of performance trace files. Shared by the engine and the trace reader
+* \author A. Brainville (Ybalrid)
+*/
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Annwvyn
+{
+	///Layout of a performance trace file.
+	///A file is a Header, followed by records written in the order they happened. Each record is a RecordHeader followed by
+	///`size` bytes of payload, so a reader can skip the types it doesn't know. A string is defined once by a StringRecord
+	///before the first record that refers to it by its id. Every value is little endian. Times are in microseconds since the start of the trace.
+	namespace AnnTraceFormat
+	{
+		///First bytes of a trace
+		static constexpr char magic[4]{ 'A', 'N', 'T', 'R' };
+		///Version of the format written by the engine
+		static constexpr uint32_t version{ 1 };
+
+		///Header of the file
+		struct Header
+		{
+			///Should be equal to magic
+			char magic[4];
+			///Version of the format
+			uint32_t version;
+			///When the trace started, in microseconds since the UNIX epoch
+			uint64_t startTime;
+		};
+
+		///Type of a record
+		enum RecordType : uint16_t {
+			string,
+			frameBegin,
+			frameEnd,
+			subsystem,
+			levelPhase,
+			resourceLoad,
+			scriptError
+		};
+
+		///Put in front of every record
+		struct RecordHeader
+		{
+			///Type of the record, as a RecordType
+			uint16_t type;
+			///Size of the payload following this header
+			uint16_t size;
+		};
+
+		///Define a string. Followed by `size - sizeof(StringRecord)` characters, not null terminated
+		struct StringRecord
+		{
+			///Id used by the other records to refer to this string
+			uint32_t id;
+		};
+
+		///Start or end of a frame
+		struct FrameRecord
+		{
+			///When it happened
+			uint64_t time;
+			///Number of the frame, counted from the start of the trace
+			uint64_t frame;
+		};
+
+		///Update of a subsystem
+		struct SubsystemRecord
+		{
+			///When the update started
+			uint64_t time;
+			///Duration of the update
+			uint32_t duration;
+			///Name of the subsystem
+			uint32_t name;
+		};
+
+		///Steps of a level switch
+		enum LevelPhase : uint32_t {
+			prepareBegin,
+			prepareEnd,
+			unloadBegin,
+			unloadEnd,
+			loadBegin,
+			loadEnd
+		};
+
+		///A level switch reached a step
+		struct LevelPhaseRecord
+		{
+			///When it happened
+			uint64_t time;
+			///Name of the level
+			uint32_t level;
+			///The step, as a LevelPhase
+			uint32_t phase;
+		};
+
+		///A resource was uploaded to the renderer or the audio engine
+		struct ResourceLoadRecord
+		{
+			///When the upload started
+			uint64_t time;
+			///Size of the resource data
+			uint64_t bytes;
+			///Duration of the upload
+			uint32_t duration;
+			///Name of the resource
+			uint32_t name;
+			///Resource group
+			uint32_t group;
+			///Kind of resource, as a AnnResourcePreloader::ResourceKind
+			uint32_t kind;
+		};
+
+		///A script raised an evaluation error
+		struct ScriptErrorRecord
+		{
+			///When it happened
+			uint64_t time;
+			///Name of the script
+			uint32_t script;
+			///Message of the error
+			uint32_t message;
+		};
+
+		static_assert(std::is_trivially_copyable<Header>::value && sizeof(Header) == 16, "Header layout changed");
+		static_assert(sizeof(RecordHeader) == 4, "RecordHeader layout changed");
+		static_assert(sizeof(StringRecord) == 4, "StringRecord layout changed");
+		static_assert(sizeof(FrameRecord) == 16, "FrameRecord layout changed");
+		static_assert(sizeof(SubsystemRecord) == 16, "SubsystemRecord layout changed");
+		static_assert(sizeof(LevelPhaseRecord) == 16, "LevelPhaseRecord layout changed");
+		static_assert(sizeof(ResourceLoadRecord) == 32, "ResourceLoadRecord layout changed");
+		static_assert(sizeof(ScriptErrorRecord) == 16, "ScriptErrorRecord layout changed");
+	}
+}
@@ -9,6 +9,7 @@
 #include "systemMacro.h"
 #include <AnnTypes.h>
 #include "AnnAbstractMovable.hpp"
+#include "AnnSlotMap.hpp"
 
 namespace Annwvyn
 {
@@ -83,5 +84,8 @@ namespace Annwvyn
 
 		///Pointer to the shape
 		std::unique_ptr<btCollisionShape> shape;
+
+		///Slot of this trigger in the game object manager
+		AnnSlotHandle slot;
 	};
 }
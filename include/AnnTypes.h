@@ -23,6 +23,7 @@ namespace Annwvyn
 	class AnnGameObject;
 	class AnnTriggerObject;
 	class AnnLightObject;
+	class AnnInstancedMesh;
 
 	//Harmonize names :
 	using AnnVect2   = Ogre::Vector2;
@@ -33,6 +34,7 @@ namespace Annwvyn
 	using AnnTriggerObjectList = std::vector<std::shared_ptr<AnnTriggerObject>>;
 	using AnnGameObjectList	= std::vector<std::shared_ptr<AnnGameObject>>;
 	using AnnLightList		   = std::vector<std::shared_ptr<AnnLightObject>>;
+	using AnnInstancedMeshList = std::vector<std::shared_ptr<AnnInstancedMesh>>;
 
 	//Because sometimes, after one byte you're full...
 	using byte = uint8_t;
@@ -95,6 +95,7 @@
 #include <AnnException.hpp>
 #include <AnnStringUtility.hpp>
 #include <AnnScriptManager.hpp>
+#include <AnnNativeBehavior.hpp>
 
 //Other Annwvyn
 #include <AnnTypes.h>
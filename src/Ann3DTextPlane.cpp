@@ -3,12 +3,15 @@
 #include "stdafx.h"
 
 #include <OgreVector2.h>
+#include <OgreBitwise.h>
+#include <Hlms/Unlit/OgreHlmsUnlit.h>
 
 #include "Ann3DTextPlane.hpp"
 #include "AnnTypes.h"
 #include "AnnLogger.hpp"
 #include "AnnGetter.hpp"
 #include "AnnException.hpp"
+#include "AnnDistanceFieldFont.hpp"
 
 using namespace Annwvyn;
 using namespace std;
@@ -30,6 +33,14 @@ void Ann3DTextPlane::createPlane()
 	auto smgr(AnnGetEngine()->getSceneManager());
 	node		= smgr->getRootSceneNode()->createChildSceneNode();
 	renderPlane = smgr->createManualObject();
+	node->attachObject(renderPlane);
+
+	if(renderMode == RENDER_DISTANCE_FIELD)
+	{
+		createDistanceFieldDatablocks();
+		createDistanceFieldPlane(16);
+		return;
+	}
 
 	createMaterial();
 
@@ -45,11 +56,80 @@ void Ann3DTextPlane::createPlane()
 	}
 
 	renderPlane->end();
+}
 
-	node->attachObject(renderPlane);
+void Ann3DTextPlane::createDistanceFieldDatablocks()
+{
+	generateMaterialName();
+	const auto textDatablockName = materialName + "_text";
+	auto unlit					 = static_cast<Ogre::HlmsUnlit*>(AnnGetVRRenderer()->getRoot()->getHlmsManager()->getHlms(Ogre::HLMS_UNLIT));
+
+	auto macroblock		 = Ogre::HlmsMacroblock();
+	auto blendblock		 = Ogre::HlmsBlendblock();
+	macroblock.mCullMode = Ogre::CULL_NONE;
+
+	//Glyphs are opaque : the alpha test on the distance field cuts them along their outline
+	textDatablock = static_cast<Ogre::HlmsUnlitDatablock*>(unlit->createDatablock(textDatablockName, textDatablockName, macroblock, blendblock, Ogre::HlmsParamVec()));
+	textDatablock->setUseColour(true);
+	textDatablock->setAlphaTest(Ogre::CMPF_GREATER_EQUAL);
+	textDatablock->setAlphaTestThreshold(0.5f);
+	textDatablock->setTexture(Ogre::HlmsTextureManager::TEXTURE_TYPE_DIFFUSE, 0, AnnDistanceFieldFont::get(font.getPointer()).getTexture());
+
+	auto sampler = Ogre::HlmsSamplerblock();
+	sampler.setAddressingMode(Ogre::TAM_CLAMP);
+	textDatablock->setSamplerblock(Ogre::HlmsTextureManager::TEXTURE_TYPE_DIFFUSE, sampler);
+
+	//The background is blended behind the glyphs
+	macroblock.mDepthWrite = false;
+	blendblock.setBlendType(Ogre::SBT_TRANSPARENT_ALPHA);
+	backgroundDatablock = static_cast<Ogre::HlmsUnlitDatablock*>(unlit->createDatablock(materialName, materialName, macroblock, blendblock, Ogre::HlmsParamVec()));
+	backgroundDatablock->setUseColour(true);
+}
+
+void Ann3DTextPlane::createDistanceFieldPlane(size_t capacity)
+{
+	renderPlane->clear();
+	glyphCapacity = capacity;
+
+	renderPlane->begin(materialName, Ogre::OT_TRIANGLE_STRIP);
+	for(char i(0); i < 4; i++)
+	{
+		renderPlane->position(vertices[i]);
+		renderPlane->textureCoord(textureCoords[i]);
+		renderPlane->index(i);
+	}
+	renderPlane->end();
+
+	//Every quad is degenerated until the text is laid out
+	renderPlane->begin(materialName + "_text", Ogre::OT_TRIANGLE_LIST);
+	writeGlyphQuads({});
+	renderPlane->end();
 }
 
-Ann3DTextPlane::Ann3DTextPlane(const float& w, const float& h, const string& str, const int& size, const float& resolution, const string& fName, const string& TTF) :
+void Ann3DTextPlane::writeGlyphQuads(const std::vector<GlyphQuad>& quads)
+{
+	//Slightly in front of the background, to not fight with it in the depth buffer
+	const auto z = 0.001f;
+
+	for(size_t i(0); i < glyphCapacity; i++)
+	{
+		const auto quad = i < quads.size() ? quads[i] : GlyphQuad{};
+
+		renderPlane->position(quad.left, quad.top, z);
+		renderPlane->textureCoord(quad.u0, quad.v0);
+		renderPlane->position(quad.left, quad.bottom, z);
+		renderPlane->textureCoord(quad.u0, quad.v1);
+		renderPlane->position(quad.right, quad.bottom, z);
+		renderPlane->textureCoord(quad.u1, quad.v1);
+		renderPlane->position(quad.right, quad.top, z);
+		renderPlane->textureCoord(quad.u1, quad.v0);
+
+		const auto first = Ogre::uint32(i * 4);
+		renderPlane->quad(first, first + 1, first + 2, first + 3);
+	}
+}
+
+Ann3DTextPlane::Ann3DTextPlane(const float& w, const float& h, const string& str, const int& size, const float& resolution, const string& fName, const string& TTF, RenderMode mode) :
  fontName(fName),
  fontTTF(TTF),
  caption(str),
@@ -58,12 +138,17 @@ Ann3DTextPlane::Ann3DTextPlane(const float& w, const float& h, const string& str
  resolutionFactor(resolution),
  textColor(AnnColor(1, 0, 0)),
  bgColor(AnnColor(0, 0, 0, 0)),
+ align(ALIGN_LEFT),
  autoUpdate(false),
  fontSize(size),
  dpi(resolution),
  pixelMargin(0),
  margin(0),
- useImageAsBackground(false)
+ useImageAsBackground(false),
+ renderMode(mode),
+ glyphCapacity(0),
+ textDatablock(nullptr),
+ backgroundDatablock(nullptr)
 {
 	AnnDebug() << width << "x" << height << " " << dpi << "dpi 3D Text plane created";
 	if(caption.empty())
@@ -79,7 +164,6 @@ Ann3DTextPlane::Ann3DTextPlane(const float& w, const float& h, const string& str
 	resolutionFactor /= dpi2dpm;
 
 	calculateVerticesForPlaneSize();
-	createPlane();
 
 	//Create or retrieve the font from the font manager. Will also create the font manager if not available yet (unlikely since the font manager is initialized by the on screen console)
 	if(!fontName.empty())
@@ -96,6 +180,8 @@ Ann3DTextPlane::Ann3DTextPlane(const float& w, const float& h, const string& str
 			createFont(size);
 	}
 
+	createPlane();
+
 	//If there's text to draw, draw it
 	if(!caption.empty()) update();
 }
@@ -107,9 +193,19 @@ Ann3DTextPlane::~Ann3DTextPlane()
 
 	node->detachObject(renderPlane);
 	smgr->destroyManualObject(renderPlane);
-	Ogre::MaterialManager::getSingleton().remove(materialName);
-	Ogre::TextureManager::getSingleton().remove(texture->getName());
-	texture.setNull();
+
+	if(renderMode == RENDER_DISTANCE_FIELD)
+	{
+		auto unlit = AnnGetVRRenderer()->getRoot()->getHlmsManager()->getHlms(Ogre::HLMS_UNLIT);
+		unlit->destroyDatablock(textDatablock->getName());
+		unlit->destroyDatablock(backgroundDatablock->getName());
+	}
+	else
+	{
+		Ogre::MaterialManager::getSingleton().remove(materialName);
+		Ogre::TextureManager::getSingleton().remove(texture->getName());
+		texture.setNull();
+	}
 
 	if(!bgTexture.isNull())
 	{
@@ -265,8 +361,25 @@ void Ann3DTextPlane::setBackgroundImage(const string& imgName)
 	useImageAsBackground = true;
 }
 
+Ann3DTextPlane::RenderMode Ann3DTextPlane::getRenderMode() const
+{
+	return renderMode;
+}
+
+size_t Ann3DTextPlane::getGlyphCapacity() const
+{
+	return glyphCapacity;
+}
+
 void Ann3DTextPlane::renderText()
 {
+	if(renderMode == RENDER_DISTANCE_FIELD)
+	{
+		renderDistanceFieldText();
+		needUpdating = false;
+		return;
+	}
+
 	clearTexture();
 	AnnConsole::WriteToTexture(caption,
 							   texture,
@@ -306,3 +419,128 @@ void Ann3DTextPlane::clearTexture()
 		textureBuffer->unlock();
 	}
 }
+
+std::vector<Ann3DTextPlane::GlyphQuad> Ann3DTextPlane::layoutText() const
+{
+	const auto& field = AnnDistanceFieldFont::get(font.getPointer());
+	const auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n'; };
+
+	//Same metrics as AnnConsole::WriteToTexture, in pixels of the font
+	float charWidth{ 0 }, charHeight{ 0 };
+	for(auto c : caption)
+		if(!isSpace(c))
+		{
+			charWidth  = std::max(charWidth, float(field.getGlyph(c).width));
+			charHeight = std::max(charHeight, float(field.getGlyph(c).height));
+		}
+	if(charHeight == 0) return {};
+
+	auto spaceWidth = float(field.getGlyph('0').width);
+	if(spaceWidth != charWidth) spaceWidth *= 0.5f;
+
+	const auto advance = [&](char c) {
+		switch(c)
+		{
+			case ' ': return spaceWidth;
+			case '\t': return charWidth * 3;
+			default: return float(field.getGlyph(c).width);
+		}
+	};
+
+	const auto lineWidth = (width - 2 * margin) * resolutionFactor;
+	const auto maxLines  = size_t((height - 2 * margin) * resolutionFactor / charHeight);
+
+	//Break the caption in lines : at new lines, and at the last whitespace when a line is full
+	std::vector<std::pair<size_t, size_t>> lines;
+	size_t lineBegin{ 0 }, lastBreak{ string::npos };
+	float cursor{ 0 };
+	for(size_t i{ 0 }; i < caption.size(); ++i)
+	{
+		const auto c = caption[i];
+		if(c == '\n')
+		{
+			lines.emplace_back(lineBegin, i);
+			lineBegin = i + 1;
+			lastBreak = string::npos;
+			cursor	= 0;
+			continue;
+		}
+
+		if(isSpace(c)) lastBreak = i;
+		cursor += advance(c);
+		if(cursor <= lineWidth || i == lineBegin) continue;
+
+		const auto lineEnd = lastBreak != string::npos ? lastBreak : i;
+		lines.emplace_back(lineBegin, lineEnd);
+		lineBegin = lastBreak != string::npos ? lastBreak + 1 : i;
+		lastBreak = string::npos;
+		cursor	= 0;
+		for(auto j = lineBegin; j <= i; ++j) cursor += advance(caption[j]);
+	}
+	lines.emplace_back(lineBegin, caption.size());
+
+	//Place the glyphs, with the spread of the distance field around them
+	const auto spread = float(field.getSpread());
+	std::vector<GlyphQuad> quads;
+	for(size_t line{ 0 }; line < std::min(lines.size(), maxLines); ++line)
+	{
+		auto begin = lines[line].first, end = lines[line].second;
+		while(end > begin && isSpace(caption[end - 1])) --end;
+
+		float textWidth{ 0 };
+		for(auto i = begin; i < end; ++i) textWidth += advance(caption[i]);
+
+		float x{ 0 };
+		switch(align)
+		{
+			case ALIGN_CENTER: x = (lineWidth - textWidth) / 2; break;
+			case ALIGN_RIGHT: x = lineWidth - textWidth; break;
+			default: break;
+		}
+
+		const auto y = line * charHeight;
+		for(auto i = begin; i < end; ++i)
+		{
+			const auto& glyph = field.getGlyph(caption[i]);
+			if(!isSpace(caption[i]) && glyph.width > 0)
+				quads.push_back({ -xOffset + margin + (x - spread) / resolutionFactor,
+								  yOffset - margin - (y - spread) / resolutionFactor,
+								  -xOffset + margin + (x + glyph.width + spread) / resolutionFactor,
+								  yOffset - margin - (y + glyph.height + spread) / resolutionFactor,
+								  glyph.u0,
+								  glyph.v0,
+								  glyph.u1,
+								  glyph.v1 });
+			x += advance(caption[i]);
+		}
+	}
+
+	return quads;
+}
+
+void Ann3DTextPlane::renderDistanceFieldText()
+{
+	//The alpha of the text is used by the alpha test, keep it opaque
+	auto color = textColor.getOgreColor();
+	color.a	= 1;
+	textDatablock->setColour(color);
+
+	if(useImageAsBackground)
+	{
+		backgroundDatablock->setColour(Ogre::ColourValue::White);
+		backgroundDatablock->setTexture(Ogre::HlmsTextureManager::TEXTURE_TYPE_DIFFUSE, 0, bgTexture);
+	}
+	else
+	{
+		backgroundDatablock->setColour(bgColor.getOgreColor());
+	}
+
+	const auto quads = layoutText();
+	if(quads.size() > glyphCapacity)
+		createDistanceFieldPlane(Ogre::Bitwise::firstPO2From(Ogre::uint32(quads.size())));
+
+	//Same number of vertices as before : the buffers are rewritten in place
+	renderPlane->beginUpdate(1);
+	writeGlyphQuads(quads);
+	renderPlane->end();
+}
@@ -172,6 +172,15 @@ void AnnAudioEngine::preLoadBuffer(const std::string& filename)
 	loadBuffer(filename);
 }
 
+void AnnAudioEngine::preLoadBuffer(const std::string& filename, const std::string& group, Ogre::DataStreamPtr data)
+{
+	if(isBufferLoader(filename)) return;
+
+	//loadBuffer() finds the audio file resource already loaded
+	audioFileManager->load(filename, group, data);
+	loadBuffer(filename);
+}
+
 ALuint AnnAudioEngine::isBufferLoader(const std::string& filename)
 {
 	auto query = buffers.find(filename);
@@ -184,7 +193,7 @@ ALuint AnnAudioEngine::loadBuffer(const std::string& filename)
 {
 	if(auto buffer = isBufferLoader(filename)) return buffer;
 
-	AnnDebug() << filename << " Not loaded on an OpenAL buffer, loading from file...";
+	ANN_LOG(debug) << filename << " Not loaded on an OpenAL buffer, loading from file...";
 
 	//Attempt to retrieve the resource...
 	auto audioFileResource = audioFileManager->getResourceByName(filename).staticCast<AnnAudioFile>();
@@ -193,7 +202,7 @@ ALuint AnnAudioEngine::loadBuffer(const std::string& filename)
 		audioFileResource = audioFileManager->load(filename, AnnGetResourceManager()->getDefaultResourceGroupName());
 		if(!audioFileResource) //Okay, that file doesn't exist or something.
 		{
-			AnnDebug() << "Error, cannot load file " << filename << " as a recognized audio file";
+			ANN_LOG(error) << "Cannot load file " << filename << " as a recognized audio file";
 			return 0;
 		}
 	}
@@ -206,7 +215,7 @@ ALuint AnnAudioEngine::loadBuffer(const std::string& filename)
 	auto nbSamples  = static_cast<ALsizei>(fileInfos.channels * fileInfos.frames);
 	auto sampleRate = static_cast<ALsizei>(fileInfos.samplerate);
 
-	AnnDebug() << "Loading " << nbSamples << " samples. Playback sample-rate : " << sampleRate << "Hz";
+	ANN_LOG(debug) << "Loading " << nbSamples << " samples. Playback sample-rate : " << sampleRate << "Hz";
 
 	//Read samples in 16bits signed
 	std::vector<float> samplesBuffer(nbSamples);
@@ -241,11 +250,11 @@ ALuint AnnAudioEngine::loadBuffer(const std::string& filename)
 	switch(fileInfos.channels)
 	{
 		case 1:
-			AnnEngine::writeToLog("Mono 16bits sound loaded");
+			ANN_LOG(debug) << "Mono 16bits sound loaded";
 			Format = AL_FORMAT_MONO16;
 			break;
 		case 2:
-			AnnEngine::writeToLog("Stereo 16bits sound loaded");
+			ANN_LOG(debug) << "Stereo 16bits sound loaded";
 			Format = AL_FORMAT_STEREO16;
 			break;
 
@@ -21,6 +21,13 @@ void AnnAudioFile::readFromStream(DataStreamPtr& stream)
 void AnnAudioFile::loadImpl()
 {
 	AnnDebug() << "AnnAudioFile::loadImpl for resource (" << mName << ", " << mGroup << ")";
+	if(!preloadedData.isNull())
+	{
+		readFromStream(preloadedData);
+		preloadedData.setNull();
+		return;
+	}
+
 	auto stream = ResourceGroupManager::getSingleton().openResource(mName, mGroup, true, this);
 	readFromStream(stream);
 }
@@ -52,6 +59,11 @@ const byte* AnnAudioFile::getData() const
 	return data.data();
 }
 
+void AnnAudioFile::setPreloadedData(DataStreamPtr stream)
+{
+	preloadedData = stream;
+}
+
 Resource* AnnAudioFileManager::createImpl(const String& name, ResourceHandle handle, const String& group, bool isManual, ManualResourceLoader* loader, const NameValuePairList* createParams)
 {
 	return OGRE_NEW AnnAudioFile(this, name, handle, group, isManual, loader);
@@ -80,6 +92,14 @@ AnnAudioFilePtr AnnAudioFileManager::load(const String& name, const String& grou
 	return file;
 }
 
+AnnAudioFilePtr AnnAudioFileManager::load(const String& name, const String& group, DataStreamPtr data)
+{
+	auto file = createOrRetrieve(name, group).first.staticCast<AnnAudioFile>();
+	if(!file->isLoaded()) file->setPreloadedData(data);
+	file->load();
+	return file;
+}
+
 AnnAudioFileManager& AnnAudioFileManager::getSingleton()
 {
 	return *msSingleton;
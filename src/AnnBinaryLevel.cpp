@@ -0,0 +1,486 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnBinaryLevel.hpp"
+#include "AnnLogger.hpp"
+#include "AnnGetter.hpp"
+#include "AnnException.hpp"
+#include "AnnJsonLevel.hpp"
+#include <json.hpp>
+
+#include <fstream>
+
+using namespace Annwvyn;
+using namespace AnnBinaryLevelFormat;
+using json_t = nlohmann::json;
+
+AnnBinaryLevel::AnnBinaryLevel(const std::string& path, const bool preload) :
+ constructLevel(),
+ file(path),
+ header(reinterpret_cast<const Header*>(file.data())),
+ preloadResources(preload),
+ instantiatedRecords(0)
+{
+	validate();
+	name = getString(header->name);
+	AnnDebug() << "Opened compiled level " << name << " : " << header->objects.count << " objects, " << header->lights.count << " lights";
+
+	auto resourceManager = AnnGetResourceManager();
+	std::vector<std::string> groups;
+	for(const auto& resource : getTable<ResourceRecord>(header->resources))
+	{
+		const std::string group{ resource.group != noString ? getString(resource.group) : AnnResourceManager::getDefaultResourceGroupName() };
+		if(std::string(getString(resource.type)) == "Zip")
+			resourceManager->addZipLocation(getString(resource.path), group);
+
+		if(preloadResources && group != resourceManager->getDefaultResourceGroupName()
+		   && std::find(groups.begin(), groups.end(), group) == groups.end())
+			groups.push_back(group);
+	}
+
+	//Read the files of every group in parallel
+	if(!groups.empty())
+		resourceManager->loadGroupsAsync(groups)->wait();
+}
+
+AnnBinaryLevel::~AnnBinaryLevel() = default;
+
+void AnnBinaryLevel::validate() const
+{
+	const auto fail = [&](const std::string& reason) {
+		throw AnnInitializationError(ANN_ERR_INFILE, "Invalid compiled level " + file.getPath() + " : " + reason);
+	};
+
+	if(file.size() < sizeof(Header)) fail("file is too small");
+	if(std::memcmp(header->magic, magic, sizeof magic) != 0) fail("not a compiled level");
+	if(header->version != version) fail("compiled for format version " + std::to_string(header->version) + ", expected " + std::to_string(version));
+	if(header->fileSize != file.size()) fail("truncated file");
+
+	const auto checkTable = [&](const Table& table, size_t recordSize, const char* tableName) {
+		if(table.offset % 4 != 0 || table.offset > file.size() || uint64_t(table.count) * recordSize > file.size() - table.offset)
+			fail(std::string(tableName) + " table is out of the file");
+	};
+
+	checkTable(header->strings, 1, "string");
+	checkTable(header->resources, sizeof(ResourceRecord), "resource");
+	checkTable(header->objects, sizeof(ObjectRecord), "object");
+	checkTable(header->scripts, sizeof(ScriptRecord), "script");
+	checkTable(header->lights, sizeof(LightRecord), "light");
+	checkTable(header->cells, sizeof(CellRecord), "cell");
+	checkTable(header->instanceSets, sizeof(InstanceSetRecord), "instance set");
+	checkTable(header->instances, sizeof(InstanceRecord), "instance");
+
+	//Every string is null terminated as long as the table ends by a null character
+	if(header->strings.count == 0 || file.data()[header->strings.offset + header->strings.count - 1] != '\0')
+		fail("string table is not terminated");
+
+	const auto checkString = [&](uint32_t reference) {
+		if(reference != noString && reference >= header->strings.count) fail("string reference out of the string table");
+	};
+
+	checkString(header->name);
+	for(const auto& resource : getTable<ResourceRecord>(header->resources))
+	{
+		checkString(resource.group);
+		checkString(resource.path);
+		checkString(resource.type);
+	}
+	for(const auto& object : getTable<ObjectRecord>(header->objects))
+	{
+		checkString(object.name);
+		checkString(object.mesh);
+		if(uint64_t(object.firstScript) + object.scriptCount > header->scripts.count) fail("script range out of the script table");
+	}
+	for(const auto& script : getTable<ScriptRecord>(header->scripts))
+	{
+		checkString(script.name);
+		checkString(script.domain);
+	}
+	for(const auto& light : getTable<LightRecord>(header->lights))
+		checkString(light.name);
+	for(const auto& instanceSet : getTable<InstanceSetRecord>(header->instanceSets))
+	{
+		checkString(instanceSet.name);
+		checkString(instanceSet.mesh);
+		if(uint64_t(instanceSet.firstInstance) + instanceSet.instanceCount > header->instances.count) fail("instance range out of the instance table");
+	}
+
+	if(header->cells.count > 0 && !(header->cellSize > 0)) fail("invalid cell size");
+	for(const auto& cell : getTable<CellRecord>(header->cells))
+		if(uint64_t(cell.firstObject) + cell.objectCount > header->objects.count) fail("cell object range out of the object table");
+}
+
+const char* AnnBinaryLevel::getString(uint32_t reference) const
+{
+	if(reference == noString) return "";
+	return file.data() + header->strings.offset + reference;
+}
+
+const Header& AnnBinaryLevel::getHeader() const
+{
+	return *header;
+}
+
+AnnGameObjectPtr AnnBinaryLevel::instantiate(const ObjectRecord& object)
+{
+	auto obj = addGameObject(getString(object.mesh), getString(object.name));
+	if(!obj) throw AnnNullGameObjectError();
+
+	obj->setPosition(AnnVect3(object.position));
+	obj->setOrientation({ object.orientation[3], object.orientation[0], object.orientation[1], object.orientation[2] });
+	obj->setScale(AnnVect3(object.scale));
+
+	if(object.flags & hasPhysics)
+		obj->setupPhysics(object.mass, phyShapeType(object.shape), (object.flags & colideWithPlayer) != 0);
+
+	const auto scripts = getTable<ScriptRecord>(header->scripts);
+	for(auto i = object.firstScript; i < object.firstScript + object.scriptCount; ++i)
+	{
+		if(scripts[i].domain != noString)
+			obj->attachScript(getString(scripts[i].name), getString(scripts[i].domain));
+		else
+			obj->attachScript(getString(scripts[i].name));
+	}
+
+	return obj;
+}
+
+AnnLightObjectPtr AnnBinaryLevel::instantiate(const LightRecord& light)
+{
+	auto obj = addLightObject(getString(light.name));
+
+	if(light.type != AnnLightObject::ANN_LIGHT_ERROR)
+		obj->setType(AnnLightObject::LightTypes(light.type));
+
+	obj->setPower(light.power);
+	if(light.flags & hasPosition)
+		obj->setPosition(AnnVect3(light.position));
+	if(light.flags & hasDirection)
+		obj->setDirection(AnnVect3(light.direction));
+
+	return obj;
+}
+
+AnnInstancedMeshPtr AnnBinaryLevel::instantiate(const InstanceSetRecord& instanceSet)
+{
+	auto instancedMesh = addInstancedMesh(getString(instanceSet.mesh), getString(instanceSet.name), (instanceSet.flags & staticInstances) != 0);
+
+	const auto instances = getTable<InstanceRecord>(header->instances);
+	for(auto i = instanceSet.firstInstance; i < instanceSet.firstInstance + instanceSet.instanceCount; ++i)
+	{
+		AnnInstanceTransform transform;
+		transform.position	  = AnnVect3(instances[i].position);
+		transform.orientation = { instances[i].orientation[3], instances[i].orientation[0], instances[i].orientation[1], instances[i].orientation[2] };
+		transform.scale		  = AnnVect3(instances[i].scale);
+		instancedMesh->addInstance(transform);
+	}
+
+	return instancedMesh;
+}
+
+void AnnBinaryLevel::placePlayer() const
+{
+	auto player = AnnGetPlayer();
+	player->setPosition(AnnVect3(header->playerPosition));
+	player->setOrientation(AnnQuaternion{ header->playerOrientation[3], header->playerOrientation[0], header->playerOrientation[1], header->playerOrientation[2] });
+	AnnDebug() << "Player position reset";
+	AnnDebug() << player->getPosition();
+	AnnDebug() << player->getOrientation();
+}
+
+void AnnBinaryLevel::load()
+{
+	for(const auto& object : getTable<ObjectRecord>(header->objects))
+		instantiate(object);
+
+	for(const auto& light : getTable<LightRecord>(header->lights))
+		instantiate(light);
+
+	for(const auto& instanceSet : getTable<InstanceSetRecord>(header->instanceSets))
+		instantiate(instanceSet);
+
+	placePlayer();
+	instantiatedRecords = header->objects.count + header->lights.count + header->instanceSets.count;
+}
+
+void AnnBinaryLevel::prepare()
+{
+	file.prefetch();
+}
+
+bool AnnBinaryLevel::loadIncrementally(double budget)
+{
+	const auto objects = getTable<ObjectRecord>(header->objects);
+	const auto lights		= getTable<LightRecord>(header->lights);
+	const auto instanceSets = getTable<InstanceSetRecord>(header->instanceSets);
+
+	return runTimeSliced(budget, [&] {
+		if(instantiatedRecords < objects.size())
+			instantiate(objects[instantiatedRecords]);
+		else if(instantiatedRecords < objects.size() + lights.size())
+			instantiate(lights[instantiatedRecords - objects.size()]);
+		else if(instantiatedRecords < objects.size() + lights.size() + instanceSets.size())
+			instantiate(instanceSets[instantiatedRecords - objects.size() - lights.size()]);
+		else
+		{
+			placePlayer();
+			return true;
+		}
+
+		++instantiatedRecords;
+		return false;
+	});
+}
+
+float AnnBinaryLevel::getLoadingProgress() const
+{
+	const auto total = header->objects.count + header->lights.count + header->instanceSets.count;
+	if(total == 0) return 1;
+	return float(instantiatedRecords) / float(total);
+}
+
+void AnnBinaryLevel::unload()
+{
+	AnnLevel::unload();
+	instantiatedRecords = 0;
+}
+
+void AnnBinaryLevel::runLogic()
+{
+}
+
+namespace
+{
+	///Build the tables of a compiled level
+	class AnnBinaryLevelWriter
+	{
+	public:
+		///Add a string to the string table, once
+		uint32_t addString(const std::string& string)
+		{
+			const auto known = stringReferences.find(string);
+			if(known != stringReferences.end()) return known->second;
+
+			const auto reference = uint32_t(strings.size());
+			strings.insert(strings.end(), string.begin(), string.end());
+			strings.push_back('\0');
+			stringReferences[string] = reference;
+			return reference;
+		}
+
+		///Append a table to the output, 4 bytes aligned
+		template <class Record>
+		Table writeTable(std::vector<char>& output, const std::vector<Record>& records) const
+		{
+			output.resize((output.size() + 3) & ~size_t(3), '\0');
+			const Table table{ uint32_t(output.size()), uint32_t(records.size()) };
+			const auto bytes = reinterpret_cast<const char*>(records.data());
+			output.insert(output.end(), bytes, bytes + records.size() * sizeof(Record));
+			return table;
+		}
+
+		///The string table
+		std::vector<char> strings;
+		///Position of each string in the table
+		std::unordered_map<std::string, uint32_t> stringReferences;
+	};
+
+	///Throw the error of an invalid JSON level
+	[[noreturn]] void invalidLevel(const std::string& reason)
+	{
+		throw AnnInitializationError(ANN_ERR_INFILE, "Cannot compile level : " + reason);
+	}
+
+	///Return true if the JSON object has a non null value for this key
+	bool has(const json_t& j, const char* key)
+	{
+		const auto value = j.find(key);
+		return value != j.end() && !value->is_null();
+	}
+
+	///Copy a JSON array of numbers into a float array
+	template <size_t size>
+	void readFloats(const json_t& j, float (&output)[size], const char* field)
+	{
+		if(!j.is_array() || j.size() != size) invalidLevel(std::string(field) + " should be an array of " + std::to_string(size) + " numbers");
+		for(size_t i{ 0 }; i < size; ++i) output[i] = j[i].get<float>();
+	}
+}
+
+std::vector<char> AnnBinaryLevel::compile(const std::string& jsonCode)
+{
+	json_t json;
+	try
+	{
+		json = json_t::parse(jsonCode);
+	}
+	catch(const std::exception& e)
+	{
+		invalidLevel(e.what());
+	}
+
+	AnnBinaryLevelWriter writer;
+	Header header{};
+	std::copy(std::begin(magic), std::end(magic), header.magic);
+	header.version = version;
+
+	std::vector<ResourceRecord> resources;
+	std::vector<ObjectRecord> objects;
+	std::vector<ScriptRecord> scripts;
+	std::vector<LightRecord> lights;
+	std::vector<InstanceSetRecord> instanceSets;
+	std::vector<InstanceRecord> instances;
+	std::vector<CellRecord> cells;
+
+	try
+	{
+		header.name = writer.addString(json.at("name").get<std::string>());
+
+		if(has(json, "resources"))
+			for(const auto& resource : json.at("resources"))
+			{
+				ResourceRecord record;
+				record.group = has(resource, "group") ? writer.addString(resource.at("group").get<std::string>()) : noString;
+				record.path	 = writer.addString(resource.at("path").get<std::string>());
+				record.type	 = writer.addString(resource.at("type").get<std::string>());
+				resources.push_back(record);
+			}
+
+		if(has(json, "content"))
+			for(const auto& object : json.at("content"))
+			{
+				ObjectRecord record{};
+				record.name = writer.addString(object.at("name").get<std::string>());
+				record.mesh = writer.addString(object.at("mesh").get<std::string>());
+				readFloats(object.at("position"), record.position, "position");
+				readFloats(object.at("orientation"), record.orientation, "orientation");
+				readFloats(object.at("scale"), record.scale, "scale");
+
+				if(object.at("hasPhysics").get<bool>())
+				{
+					const auto& physics = object.at("physics");
+					const auto shape	= AnnJsonLevel::shapeFromString(physics.at("shape").get<std::string>());
+					if(shape == error) invalidLevel("object " + object.at("name").get<std::string>() + " has an invalid physics shape");
+
+					record.flags |= hasPhysics;
+					if(physics.at("playerColide").get<bool>()) record.flags |= colideWithPlayer;
+					record.mass	 = physics.at("mass").get<float>();
+					record.shape = uint8_t(shape);
+				}
+
+				record.firstScript = uint32_t(scripts.size());
+				if(has(object, "scripts"))
+					for(const auto& script : object.at("scripts"))
+					{
+						//A script is either it's name, or an object with a "name" and the "domain" to run it into
+						if(script.is_object())
+							scripts.push_back({ writer.addString(script.at("name").get<std::string>()), writer.addString(script.at("domain").get<std::string>()) });
+						else
+							scripts.push_back({ writer.addString(script.get<std::string>()), noString });
+					}
+				record.scriptCount = uint32_t(scripts.size()) - record.firstScript;
+
+				objects.push_back(record);
+			}
+
+		if(has(json, "lighting"))
+			for(const auto& light : json.at("lighting"))
+			{
+				LightRecord record{};
+				record.name	 = writer.addString(light.at("name").get<std::string>());
+				record.type	 = AnnJsonLevel::lightTypeFromString(light.at("type").get<std::string>());
+				record.power = light.at("power").get<float>();
+				if(has(light, "position"))
+				{
+					readFloats(light.at("position"), record.position, "position");
+					record.flags |= hasPosition;
+				}
+				if(has(light, "direction"))
+				{
+					readFloats(light.at("direction"), record.direction, "direction");
+					record.flags |= hasDirection;
+				}
+				lights.push_back(record);
+			}
+
+		if(has(json, "instances"))
+			for(const auto& instanceSet : json.at("instances"))
+			{
+				InstanceSetRecord record{};
+				record.name			 = writer.addString(instanceSet.value("name", std::string{}));
+				record.mesh			 = writer.addString(instanceSet.at("mesh").get<std::string>());
+				record.firstInstance = uint32_t(instances.size());
+				if(!has(instanceSet, "static") || instanceSet.at("static").get<bool>()) record.flags |= staticInstances;
+
+				//Orientation and scale are optional, like in AnnJsonLevel
+				for(const auto& transform : instanceSet.at("transforms"))
+				{
+					InstanceRecord instance{ { 0, 0, 0 }, { 0, 0, 0, 1 }, { 1, 1, 1 } };
+					readFloats(transform.at("position"), instance.position, "position");
+					if(has(transform, "orientation")) readFloats(transform.at("orientation"), instance.orientation, "orientation");
+					if(has(transform, "scale")) readFloats(transform.at("scale"), instance.scale, "scale");
+					instances.push_back(instance);
+				}
+				record.instanceCount = uint32_t(instances.size()) - record.firstInstance;
+
+				instanceSets.push_back(record);
+			}
+
+		//Group the objects by cell, so each cell is a contiguous range of the object table
+		if(has(json, "cellSize"))
+		{
+			header.cellSize = json.at("cellSize").get<float>();
+			if(!(header.cellSize > 0)) invalidLevel("cellSize should be positive");
+
+			const auto cellOf = [&](const ObjectRecord& object) {
+				return std::make_pair(int32_t(std::floor(object.position[0] / header.cellSize)), int32_t(std::floor(object.position[2] / header.cellSize)));
+			};
+
+			std::stable_sort(objects.begin(), objects.end(), [&](const ObjectRecord& a, const ObjectRecord& b) { return cellOf(a) < cellOf(b); });
+
+			for(uint32_t i{ 0 }; i < objects.size(); ++i)
+			{
+				const auto cell = cellOf(objects[i]);
+				if(cells.empty() || cells.back().x != cell.first || cells.back().z != cell.second)
+					cells.push_back({ cell.first, cell.second, i, 0 });
+				cells.back().objectCount++;
+			}
+		}
+
+		readFloats(json.at("player").at("startPosition"), header.playerPosition, "startPosition");
+		readFloats(json.at("player").at("startOrientation"), header.playerOrientation, "startOrientation");
+	}
+	catch(const nlohmann::detail::exception& e)
+	{
+		invalidLevel(e.what());
+	}
+
+	//Header first, then the tables
+	std::vector<char> output(sizeof(Header));
+	header.strings	 = writer.writeTable(output, writer.strings);
+	header.resources = writer.writeTable(output, resources);
+	header.objects	 = writer.writeTable(output, objects);
+	header.scripts	 = writer.writeTable(output, scripts);
+	header.lights	 = writer.writeTable(output, lights);
+	header.cells	 = writer.writeTable(output, cells);
+
+	header.instanceSets = writer.writeTable(output, instanceSets);
+	header.instances	= writer.writeTable(output, instances);
+	header.fileSize		= uint32_t(output.size());
+	std::memcpy(output.data(), &header, sizeof header);
+
+	return output;
+}
+
+void AnnBinaryLevel::compileFile(const std::string& jsonPath, const std::string& binaryPath)
+{
+	std::ifstream input(jsonPath);
+	if(!input) throw AnnInitializationError(ANN_ERR_INFILE, "Could not load content of JSON level file " + jsonPath);
+	const std::string jsonCode{ std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>() };
+
+	const auto compiled = compile(jsonCode);
+
+	std::ofstream output(binaryPath, std::ios::binary | std::ios::trunc);
+	if(!output.write(compiled.data(), compiled.size()))
+		throw AnnInitializationError(ANN_ERR_INFILE, "Could not write compiled level " + binaryPath);
+}
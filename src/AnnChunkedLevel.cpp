@@ -0,0 +1,199 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnChunkedLevel.hpp"
+#include "AnnLogger.hpp"
+#include "AnnGetter.hpp"
+#include "AnnException.hpp"
+
+#include <unordered_set>
+
+using namespace Annwvyn;
+using namespace AnnBinaryLevelFormat;
+
+AnnChunkedLevel::AnnChunkedLevel(const std::string& path, float loadRadius, float unloadRadius, size_t maxLoadedCells, const bool preload) :
+ AnnBinaryLevel(path, preload),
+ loadRadius(loadRadius),
+ unloadRadius(std::max(loadRadius, unloadRadius)),
+ maxLoadedCells(std::max<size_t>(1, maxLoadedCells)),
+ streamingBudget(2),
+ cells(getHeader().cells.count),
+ loadedCellCount(0),
+ cellsDirty(true),
+ staticContentLoaded(false)
+{
+	if(getHeader().cells.count == 0)
+		throw AnnInitializationError(ANN_ERR_INFILE, "Compiled level " + path + " isn't divided in cells. Compile it with a \"cellSize\"");
+
+	AnnDebug() << "Level " << name << " has " << cells.size() << " cells of " << getHeader().cellSize << "m";
+}
+
+AnnChunkedLevel::~AnnChunkedLevel() = default;
+
+void AnnChunkedLevel::load()
+{
+	while(!loadIncrementally(0))
+		;
+}
+
+bool AnnChunkedLevel::loadIncrementally(double budget)
+{
+	return runTimeSliced(budget, [&] {
+		if(!staticContentLoaded)
+		{
+			for(const auto& light : getTable<LightRecord>(getHeader().lights))
+				instantiate(light);
+			for(const auto& instanceSet : getTable<InstanceSetRecord>(getHeader().instanceSets))
+				instantiate(instanceSet);
+			placePlayer();
+			staticContentLoaded = true;
+			updateCells();
+			return false;
+		}
+
+		return streamStep();
+	});
+}
+
+float AnnChunkedLevel::getLoadingProgress() const
+{
+	if(!staticContentLoaded) return 0;
+	if(loadedCellCount == 0) return 1;
+	return float(loadedCellCount - loadQueue.size()) / float(loadedCellCount);
+}
+
+void AnnChunkedLevel::unload()
+{
+	//Every cell object is in levelContent
+	AnnBinaryLevel::unload();
+
+	for(auto& cell : cells)
+		cell = {};
+	loadQueue.clear();
+	loadedCellCount		= 0;
+	cellsDirty			= true;
+	staticContentLoaded = false;
+}
+
+void AnnChunkedLevel::runLogic()
+{
+	updateCells();
+	runTimeSliced(streamingBudget, [&] { return streamStep(); });
+}
+
+void AnnChunkedLevel::setStreamingBudget(double milliseconds)
+{
+	streamingBudget = milliseconds;
+}
+
+size_t AnnChunkedLevel::getLoadedCellCount() const
+{
+	return loadedCellCount;
+}
+
+size_t AnnChunkedLevel::getPendingCellCount() const
+{
+	return loadQueue.size();
+}
+
+float AnnChunkedLevel::distanceToPlayer(const CellRecord& cell, const AnnVect3& player) const
+{
+	const auto size = getHeader().cellSize;
+	const auto minX = cell.x * size, minZ = cell.z * size;
+
+	//Distance to the closest point of the square, zero inside it
+	const auto dx = std::max({ minX - player.x, 0.0f, player.x - (minX + size) });
+	const auto dz = std::max({ minZ - player.z, 0.0f, player.z - (minZ + size) });
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+void AnnChunkedLevel::updateCells()
+{
+	const auto player = AnnGetPlayer()->getPosition();
+
+	//Distances only change significantly when the player moves by a fraction of a cell
+	if(!cellsDirty && player.squaredDistance(lastUpdatePosition) < Ogre::Math::Sqr(getHeader().cellSize / 4))
+		return;
+	lastUpdatePosition = player;
+	cellsDirty		   = false;
+
+	const auto records = getTable<CellRecord>(getHeader().cells);
+	std::vector<float> distances(records.size());
+	std::vector<size_t> entering;
+
+	for(size_t i{ 0 }; i < records.size(); ++i)
+	{
+		distances[i] = distanceToPlayer(records[i], player);
+		if(cells[i].state != CellState::unloaded && distances[i] > unloadRadius)
+			unloadCell(i);
+		else if(cells[i].state == CellState::unloaded && distances[i] < loadRadius)
+			entering.push_back(i);
+	}
+
+	const auto closer = [&](size_t a, size_t b) { return distances[a] < distances[b]; };
+	std::sort(entering.begin(), entering.end(), closer);
+
+	for(const auto index : entering)
+	{
+		if(loadedCellCount >= maxLoadedCells)
+		{
+			//Make room by evicting the farthest cell that is only kept by the hysteresis
+			size_t farthest{ records.size() };
+			for(size_t i{ 0 }; i < records.size(); ++i)
+				if(cells[i].state != CellState::unloaded && distances[i] >= loadRadius && (farthest == records.size() || distances[i] > distances[farthest]))
+					farthest = i;
+
+			if(farthest == records.size()) break;
+			unloadCell(farthest);
+		}
+
+		cells[index].state = CellState::queued;
+		loadQueue.push_back(index);
+		++loadedCellCount;
+	}
+
+	std::stable_sort(loadQueue.begin(), loadQueue.end(), closer);
+}
+
+void AnnChunkedLevel::unloadCell(size_t index)
+{
+	auto& cell = cells[index];
+	if(cell.state == CellState::unloaded) return;
+
+	if(cell.state == CellState::queued)
+		loadQueue.erase(std::remove(loadQueue.begin(), loadQueue.end(), index), loadQueue.end());
+
+	if(!cell.objects.empty())
+	{
+		const std::unordered_set<AnnGameObjectPtr> removed(cell.objects.begin(), cell.objects.end());
+		levelContent.erase(std::remove_if(levelContent.begin(), levelContent.end(), [&](const AnnGameObjectPtr& object) { return removed.count(object) != 0; }),
+						   levelContent.end());
+
+		auto gameObjectManager = AnnGetGameObjectManager();
+		for(auto& object : cell.objects)
+			gameObjectManager->removeGameObject(object);
+	}
+
+	cell = {};
+	--loadedCellCount;
+}
+
+bool AnnChunkedLevel::streamStep()
+{
+	if(loadQueue.empty()) return true;
+
+	const auto index  = loadQueue.front();
+	const auto record = getTable<CellRecord>(getHeader().cells)[index];
+	auto& cell		  = cells[index];
+
+	if(cell.createdObjects < record.objectCount)
+		cell.objects.push_back(instantiate(getTable<ObjectRecord>(getHeader().objects)[record.firstObject + cell.createdObjects++]));
+
+	if(cell.createdObjects == record.objectCount)
+	{
+		cell.state = CellState::loaded;
+		loadQueue.pop_front();
+	}
+
+	return false;
+}
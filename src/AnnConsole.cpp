@@ -5,11 +5,13 @@
 #include "AnnEngine.hpp"
 #include "AnnGetter.hpp"
 #include "AnnLogger.hpp"
+#include "AnnGlyphAtlas.hpp"
 
 #include <Ogre.h>
 #include <Overlay/OgreFont.h>
 #include <Overlay/OgreFontManager.h>
 #include <OgreRenderOperation.h>
+#include <Hlms/Unlit/OgreHlmsUnlit.h>
 #include <Hlms/Unlit/OgreHlmsUnlitDatablock.h>
 #include <OgreHardwarePixelBuffer.h>
 
@@ -24,47 +26,44 @@ AnnConsole::AnnConsole() :
  lastUpdate{ 0 },
  refreshRate{ 1.0 / 15.0 },
  historyStatus{ -1 },
- cursorPos{ 0 }
+ cursorPos{ 0 },
+ ringHead{ 0 },
+ pendingScroll{ 0 },
+ lineHeight{ 0 },
+ charAdvance{ 0 },
+ cursorColumn{ std::numeric_limits<size_t>::max() }
 {
 	/*
-	* The displaySurface is a perfect rectangle drawn by 2 polygons (triangles). The position in object-space are defined as following
-	* on the "points" array :
-	*  0 +---------------+ 2
-	*    |           /   |
-	*    |        /      |
-	*    |     /         |
-	*    |  /            |
-	*  1 +---------------+ 3
-	* Texture coordinates are also mapped. To display properly, the texture should respect the same aspect ratio (2:1)
+	* The displaySurface is a 1x0.5 rectangle made of 4 horizontal bands, 2 triangles each. From top to bottom :
+	*  +---------------+  top margin
+	*  +---------------+  log lines, from the head of the ring to the end of the texture
+	*  +---------------+  log lines, from the start of the texture to the head of the ring
+	*  +---------------+  separator, command line and bottom margin
+	* The texture should respect the same aspect ratio (2:1). Until the font is measured, the bands map the texture as is
 	*/
 
-	//Define vertex data
-	points[0] = AnnVect3(-0.5, .25, 0);
-	points[1] = AnnVect3(-0.5, -.25, 0);
-	points[2] = AnnVect3(0.5, .25, 0);
-	points[3] = AnnVect3(0.5, -.25, 0);
-
-	//Define texture coordinates
-	textCoord[0] = AnnVect2(0, 0);
-	textCoord[1] = AnnVect2(0, 1);
-	textCoord[2] = AnnVect2(1, 0);
-	textCoord[3] = AnnVect2(1, 1);
-
-	//create the quad itself
+	//create the surface itself
 	displaySurface = AnnGetEngine()->getSceneManager()->createManualObject();
-	displaySurface->begin("Console", Ogre::OT_TRIANGLE_STRIP); //Strip of triangle : Define a triangle then add them by points
+	displaySurface->begin("Console", Ogre::OT_TRIANGLE_LIST);
+	writeSurfaceBand(0, 0, MARGIN, 0);
+	writeSurfaceBand(1, MARGIN, MARGIN, MARGIN);
+	writeSurfaceBand(2, MARGIN, MARGIN, MARGIN);
+	writeSurfaceBand(3, MARGIN, BASE, MARGIN);
+	displaySurface->end();
 
-	//Add the four vertices. This will directly describe two Triangles
-	for(char i(0); i < 4; i++)
+	//The cursor is a separate quad drawn over the surface
+	auto unlit			 = static_cast<Ogre::HlmsUnlit*>(AnnGetVRRenderer()->getRoot()->getHlmsManager()->getHlms(Ogre::HLMS_UNLIT));
+	auto cursorDatablock = static_cast<Ogre::HlmsUnlitDatablock*>(unlit->getDatablock("ConsoleCursor"));
+	if(!cursorDatablock)
 	{
-		displaySurface->position(points[i]);
-		displaySurface->normal(0, 0, 1);
-		displaySurface->tangent(1, 0, 0);
-		displaySurface->textureCoord(textCoord[i]);
-		displaySurface->index(i);
+		cursorDatablock = static_cast<Ogre::HlmsUnlitDatablock*>(unlit->createDatablock("ConsoleCursor", "ConsoleCursor", Ogre::HlmsMacroblock(), Ogre::HlmsBlendblock(), Ogre::HlmsParamVec()));
+		cursorDatablock->setUseColour(true);
+		cursorDatablock->setColour(Ogre::ColourValue::Blue);
 	}
 
-	//Object complete
+	displaySurface->begin("ConsoleCursor", Ogre::OT_TRIANGLE_LIST);
+	for(auto i{ 0 }; i < 4; i++) displaySurface->position(0, 0, 0);
+	displaySurface->quad(0, 1, 2, 3);
 	displaySurface->end();
 
 	displaySurface->setCastShadows(false);
@@ -130,6 +129,9 @@ AnnConsole::AnnConsole() :
 	{
 		background->getCustomAttribute("GLID", &backgroundID);
 		texture->getCustomAttribute("GLID", &textureID);
+
+		//Draw the background once, rows only erase their own region after that
+		glCopyImageSubData(backgroundID, GL_TEXTURE_2D, 0, 0, 0, 0, textureID, GL_TEXTURE_2D, 0, 0, 0, 0, texture->getSrcWidth(), texture->getSrcHeight(), 1);
 	}
 }
 
@@ -137,6 +139,7 @@ void AnnConsole::append(const std::string& str)
 {
 	rotate(begin(buffer), begin(buffer) + 1, end(buffer));
 	buffer[CONSOLE_BUFFER - 1] = str;
+	pendingScroll			   = (pendingScroll + 1) % CONSOLE_BUFFER;
 
 	//The console will be redrawn next frame
 	modified = true;
@@ -165,28 +168,36 @@ void AnnConsole::update()
 	modified   = false;
 	lastUpdate = AnnGetEngine()->getTimeFromStartupSeconds();
 
-	//Get the content of the buffer into a static string
-	std::stringstream content;
+	if(lineHeight == 0)
+	{
+		measureFont();
+		updateSurface();
+	}
+
+	//Lines that scrolled stay where they are in the texture, only the surface showing them changes
+	if(pendingScroll > 0)
+	{
+		ringHead	  = (ringHead + pendingScroll) % CONSOLE_BUFFER;
+		pendingScroll = 0;
+		updateSurface();
+	}
 
 	//For each line
-	for(auto i{ 0 }; i < CONSOLE_BUFFER; i++)
+	for(size_t i{ 0 }; i < CONSOLE_BUFFER; i++)
 	{
 		//Make the len fit the screen
 		auto logLine = buffer[i].substr(0, MAX_CONSOLE_LOG_WIDTH);
 
 		//No newline char
-		for(auto j{ 0 }; j < logLine.size(); j++)
-			if(logLine[j] == '\n') logLine[j] = '|';
+		std::replace(logLine.begin(), logLine.end(), '\n', '|');
 
-		//Append to display content
-		content << logLine << '\n';
+		drawRow((ringHead + i) % CONSOLE_BUFFER, logLine);
 	}
 
 	//horizontal separator
-	for(auto i{ 0 }; i < MAX_CONSOLE_LOG_WIDTH; ++i) content << "-";
+	drawRow(CONSOLE_BUFFER, std::string(MAX_CONSOLE_LOG_WIDTH, '-'));
 
 	//Command Invite
-	content << "\n%> ";
 	auto textInputer = AnnGetEventManager()->getTextInputer();
 	auto command	 = textInputer->getInput();
 	cursorPos		 = textInputer->getCursorOffset();
@@ -201,7 +212,6 @@ void AnnConsole::update()
 	if(!command.empty())
 	{
 		strippedCommand = command.substr(std::max(0, int(command.size()) - (MAX_CONSOLE_LOG_WIDTH - 5)), command.size());
-		content << strippedCommand;
 		if(command[command.size() - 1] == '\r')
 		{
 			//Execute command code here
@@ -211,35 +221,105 @@ void AnnConsole::update()
 		}
 	}
 
-	//Append blinking cursor
-	//if (static_cast<int>(4 * AnnGetEngine()->getTimeFromStartupSeconds()) % 2) content << "_";
-	const auto textToDisplay = content.str();
+	drawRow(CONSOLE_BUFFER + 1, "%> " + strippedCommand);
+	updateCursor(3 + std::max(0, int(strippedCommand.size()) - cursorPos));
+}
 
-	//Erase plane (draw background)
-	glCopyImageSubData(backgroundID, GL_TEXTURE_2D, 0, 0, 0, 0, textureID, GL_TEXTURE_2D, 0, 0, 0, 0, texture->getSrcWidth(), texture->getSrcHeight(), 1);
+void AnnConsole::measureFont()
+{
+	//Every glyph of a TrueType font has the same height in the atlas
+	const auto& atlas = AnnGlyphAtlas::get(font.get());
+	for(auto c{ '!' }; c <= '~'; ++c)
+		lineHeight = std::max<size_t>(lineHeight, atlas.getGlyph(c).height);
+	charAdvance = atlas.getGlyph('0').width;
+}
+
+Ogre::Image::Box AnnConsole::getRowBox(size_t row) const
+{
+	const auto top = Ogre::uint32(MARGIN + row * lineHeight);
+	return Ogre::Image::Box(MARGIN, top, 2 * BASE - MARGIN, Ogre::uint32(std::min<size_t>(top + lineHeight, BASE - MARGIN)));
+}
+
+void AnnConsole::drawRow(size_t row, const std::string& text)
+{
+	if(drawnRows[row] == text) return;
+	drawnRows[row] = text;
+
+	//Erase the row (draw background)
+	const auto box = getRowBox(row);
+	glCopyImageSubData(backgroundID, GL_TEXTURE_2D, 0, 0, box.top, 0, textureID, GL_TEXTURE_2D, 0, 0, box.top, 0, texture->getSrcWidth(), box.getHeight(), 1);
 
 	//Write text to texture
-	WriteToTexture(textToDisplay,															   //Text
-				   texture,																	   //Texture
-				   Ogre::Image::Box(0 + MARGIN, 0 + MARGIN, 2 * BASE - MARGIN, BASE - MARGIN), //Part of the pixel buffer to write to
-				   font.get(),
-				   Ogre::ColourValue::Black, //Color
-				   'l',
-				   true); //Alignment
-
-	std::string cursor;
-	for(auto i = 0; i < CONSOLE_BUFFER + 1; ++i) cursor += '\n';
-	cursor += ".  ";
-	for(auto i = 0; i < std::max(0, int(strippedCommand.size()) - cursorPos); ++i) cursor += ' ';
-	cursor += '_';
-
-	WriteToTexture(cursor,
-				   texture,
-				   Ogre::Image::Box(0 + MARGIN, 0 + MARGIN, 2 * BASE - MARGIN, BASE - MARGIN), //Part of the pixel buffer to write to
-				   font.get(),
-				   Ogre::ColourValue::Blue,
-				   'l',
-				   true);
+	if(!text.empty())
+		WriteToTexture(text, texture, box, font.get(), Ogre::ColourValue::Black, 'l', true);
+}
+
+void AnnConsole::updateSurface()
+{
+	const auto ringTop	= float(MARGIN);
+	const auto ringBottom = float(MARGIN + CONSOLE_BUFFER * lineHeight);
+	const auto headTop	= float(MARGIN + ringHead * lineHeight);
+	const auto split	  = ringTop + ringBottom - headTop;
+
+	//From the top of the ring to it's head, then the rest of the ring, then the command line
+	displaySurface->beginUpdate(0);
+	writeSurfaceBand(0, 0, ringTop, 0);
+	writeSurfaceBand(1, ringTop, split, headTop);
+	writeSurfaceBand(2, split, ringBottom, ringTop);
+	writeSurfaceBand(3, ringBottom, BASE, ringBottom);
+	displaySurface->end();
+}
+
+void AnnConsole::writeSurfaceBand(size_t index, float top, float bottom, float textureTop)
+{
+	//The surface is 1 meter wide for 2 * BASE pixels, and centered on it's node
+	const auto scale		 = 1.f / (2 * BASE);
+	const auto textureBottom = textureTop + bottom - top;
+
+	displaySurface->position(-0.5f, 0.25f - top * scale, 0);
+	displaySurface->normal(0, 0, 1);
+	displaySurface->tangent(1, 0, 0);
+	displaySurface->textureCoord(0, textureTop / BASE);
+
+	displaySurface->position(-0.5f, 0.25f - bottom * scale, 0);
+	displaySurface->normal(0, 0, 1);
+	displaySurface->tangent(1, 0, 0);
+	displaySurface->textureCoord(0, textureBottom / BASE);
+
+	displaySurface->position(0.5f, 0.25f - bottom * scale, 0);
+	displaySurface->normal(0, 0, 1);
+	displaySurface->tangent(1, 0, 0);
+	displaySurface->textureCoord(1, textureBottom / BASE);
+
+	displaySurface->position(0.5f, 0.25f - top * scale, 0);
+	displaySurface->normal(0, 0, 1);
+	displaySurface->tangent(1, 0, 0);
+	displaySurface->textureCoord(1, textureTop / BASE);
+
+	const auto first = Ogre::uint32(index * 4);
+	displaySurface->quad(first, first + 1, first + 2, first + 3);
+}
+
+void AnnConsole::updateCursor(size_t column)
+{
+	if(column == cursorColumn) return;
+	cursorColumn = column;
+
+	//Underline the character, slightly in front of the surface
+	const auto scale  = 1.f / (2 * BASE);
+	const auto box	= getRowBox(CONSOLE_BUFFER + 1);
+	const auto left   = -0.5f + (MARGIN + column * charAdvance) * scale;
+	const auto right  = left + charAdvance * scale;
+	const auto bottom = 0.25f - box.bottom * scale;
+	const auto top	= bottom + std::max<size_t>(1, lineHeight / 8) * scale;
+
+	displaySurface->beginUpdate(1);
+	displaySurface->position(left, top, 0.001f);
+	displaySurface->position(left, bottom, 0.001f);
+	displaySurface->position(right, bottom, 0.001f);
+	displaySurface->position(right, top, 0.001f);
+	displaySurface->quad(0, 1, 2, 3);
+	displaySurface->end();
 }
 
 bool AnnConsole::isForbdiden(const std::string& keyword)
@@ -259,36 +339,31 @@ void AnnConsole::WriteToTexture(const Ogre::String& str, Ogre::TexturePtr destTe
 	if(destTexture->getWidth() < destRectangle.right)
 		destRectangle.right = destTexture->getWidth();
 
-	if(!font->isLoaded())
-		font->load();
+	//Glyphs are read from the copy of the font kept in memory, the font texture is never read back
+	const auto& atlas = AnnGlyphAtlas::get(font);
 
-	auto fontTexture = TexturePtr(TextureManager::getSingleton().getByName(font->getMaterial()->getTechnique(0)->getPass(0)->getTextureUnitState(0)->getTextureName()));
-
-	auto fontBuffer = fontTexture->getBuffer();
 	auto destBuffer = destTexture->getBuffer();
 
 	const auto destPb = destBuffer->lock(destRectangle, v1::HardwareBuffer::HBL_NORMAL);
 
-	// The font texture textureBuffer was created write only...so we cannot read it back :o). One solution is to copy the textureBuffer  instead of locking it. (Maybe there is a way to create a font texture which is not write_only ?)
-
-	// create a textureBuffer
-	const auto nBuffSize	 = fontBuffer->getSizeInBytes();
-	const auto textureBuffer = static_cast<uint8*>(calloc(nBuffSize, sizeof(uint8)));
-
-	// create pixel box using the copy of the textureBuffer
-	const PixelBox fontPb(fontBuffer->getWidth(), fontBuffer->getHeight(), fontBuffer->getDepth(), fontBuffer->getFormat(), textureBuffer);
-	fontBuffer->blitToMemory(fontPb);
-
-	const auto fontData = static_cast<uint8*>(fontPb.data);
-	const auto destData = static_cast<uint8*>(destPb.data);
-
-	const auto fontPixelSize = PixelUtil::getNumElemBytes(fontPb.format);
-	const auto destPixelSize = PixelUtil::getNumElemBytes(destPb.format);
-
-	const auto fontRowPitchBytes = fontPb.rowPitch * fontPixelSize;
+	const auto destData		  = static_cast<uint8*>(destPb.data);
+	const auto destPixelSize	 = PixelUtil::getNumElemBytes(destPb.format);
 	const auto destRowPitchBytes = destPb.rowPitch * destPixelSize;
 
-	std::vector<Box> GlyphTexCoords(str.size());
+	//Formats with four 8 bits channels are blended directly on the bytes
+	int bits[4];
+	PixelUtil::getBitDepths(destPb.format, bits);
+	const auto byteChannels = destPixelSize == 4 && !PixelUtil::isFloatingPoint(destPb.format) && !PixelUtil::isCompressed(destPb.format)
+		&& bits[0] == 8 && bits[1] == 8 && bits[2] == 8 && (bits[3] == 8 || bits[3] == 0);
+	uint32_t packedColor{ 0 };
+	if(byteChannels) PixelUtil::packColour(color, destPb.format, &packedColor);
+	const auto alpha = uint8_t(Math::Clamp(color.a, 0.f, 1.f) * 255.f + 0.5f);
+
+	//Width of a character in the layout, whitespaces are handled separately
+	const auto glyphWidth = [&](size_t index) -> size_t {
+		if(str[index] == '\t' || str[index] == '\n' || str[index] == ' ') return 0;
+		return atlas.getGlyph(str[index]).width;
+	};
 
 	size_t charheight = 0;
 	size_t charwidth  = 0;
@@ -297,25 +372,16 @@ void AnnConsole::WriteToTexture(const Ogre::String& str, Ogre::TexturePtr destTe
 	{
 		if((str[i] != '\t') && (str[i] != '\n') && (str[i] != ' '))
 		{
-			auto glypheTexRect		 = font->getGlyphTexCoords(str[i]);
-			GlyphTexCoords[i].left   = uint32_t(glypheTexRect.left * fontTexture->getSrcWidth());
-			GlyphTexCoords[i].top	= uint32_t(glypheTexRect.top * fontTexture->getSrcHeight());
-			GlyphTexCoords[i].right  = uint32_t(glypheTexRect.right * fontTexture->getSrcWidth());
-			GlyphTexCoords[i].bottom = uint32_t(glypheTexRect.bottom * fontTexture->getSrcHeight());
-
-			if(GlyphTexCoords[i].getHeight() > charheight)
-				charheight = GlyphTexCoords[i].getHeight();
-			if(GlyphTexCoords[i].getWidth() > charwidth)
-				charwidth = GlyphTexCoords[i].getWidth();
+			const auto& glyph = atlas.getGlyph(str[i]);
+			if(glyph.height > charheight)
+				charheight = glyph.height;
+			if(glyph.width > charwidth)
+				charwidth = glyph.width;
 		}
 	}
 
 	//get the size of the glyph '0'
-	const auto glypheTexRect = font->getGlyphTexCoords('0');
-	Box spaceBox;
-	spaceBox.left   = uint32_t(glypheTexRect.left * fontTexture->getSrcWidth());
-	spaceBox.right  = uint32_t(glypheTexRect.right * fontTexture->getSrcWidth());
-	auto spacewidth = spaceBox.getWidth();
+	size_t spacewidth = atlas.getGlyph('0').width;
 
 	//if not mono-spaced
 	if(spacewidth != charwidth) spacewidth = size_t(float(spacewidth) * 0.5f);
@@ -337,7 +403,7 @@ void AnnConsole::WriteToTexture(const Ogre::String& str, Ogre::TexturePtr destTe
 			default:
 			{
 				//wrapping
-				if((cursorX + GlyphTexCoords[strindex].getWidth() > lineend) && !carriagreturn)
+				if((cursorX + glyphWidth(strindex) > lineend) && !carriagreturn)
 				{
 					cursorY += charheight;
 					carriagreturn = true;
@@ -371,12 +437,12 @@ void AnnConsole::WriteToTexture(const Ogre::String& str, Ogre::TexturePtr destTe
 						if(wordwrap)
 							while((l < str.size()) && (str[l] != ' ') && (str[l] != '\t') && (str[l] != '\n'))
 							{
-								wordwidth += GlyphTexCoords[l].getWidth();
+								wordwidth += glyphWidth(l);
 								++l;
 							}
 						else
 						{
-							wordwidth += GlyphTexCoords[l].getWidth();
+							wordwidth += glyphWidth(l);
 							l++;
 						}
 
@@ -414,20 +480,30 @@ void AnnConsole::WriteToTexture(const Ogre::String& str, Ogre::TexturePtr destTe
 				if((cursorY + charheight) > destRectangle.getHeight())
 					goto stop;
 
-				//draw pixel by pixel
-				for(size_t i = 0; i < GlyphTexCoords[strindex].getHeight(); i++)
-					for(size_t j = 0; j < GlyphTexCoords[strindex].getWidth(); j++)
+				//draw row by row
+				const auto& glyph	  = atlas.getGlyph(str[strindex]);
+				const auto drawnWidth = std::min(size_t(glyph.width), size_t(destRectangle.getWidth()) - std::min(size_t(destRectangle.getWidth()), cursorX));
+				for(size_t i = 0; i < glyph.height; i++)
+				{
+					const auto coverage = atlas.getCoverage(glyph, i);
+					const auto row		= &destData[(i + cursorY) * destRowPitchBytes + cursorX * destPixelSize];
+					if(byteChannels)
+					{
+						AnnGlyphAtlas::blendRow(row, coverage, drawnWidth, packedColor, alpha);
+						continue;
+					}
+
+					for(size_t j = 0; j < drawnWidth; j++)
 					{
-						const auto alpha	  = float(color.a * (fontData[(i + GlyphTexCoords[strindex].top) * fontRowPitchBytes + (j + GlyphTexCoords[strindex].left) * fontPixelSize + 1] / 255.0));
-						const auto invalpha   = 1.0f - alpha;
-						const auto charOffset = (i + cursorY) * destRowPitchBytes + (j + cursorX) * destPixelSize;
+						const auto pixelAlpha = color.a * (coverage[j] / 255.f);
 						ColourValue pix;
-						PixelUtil::unpackColour(&pix, destPb.format, &destData[charOffset]);
-						pix = (pix * invalpha) + (color * alpha);
-						PixelUtil::packColour(pix, destPb.format, &destData[charOffset]);
+						PixelUtil::unpackColour(&pix, destPb.format, &row[j * destPixelSize]);
+						pix = (pix * (1.0f - pixelAlpha)) + (color * pixelAlpha);
+						PixelUtil::packColour(pix, destPb.format, &row[j * destPixelSize]);
 					}
+				}
 
-				cursorX += GlyphTexCoords[strindex].getWidth();
+				cursorX += glyph.width;
 			} //default
 		}	 //switch
 	}		  //for
@@ -435,9 +511,6 @@ void AnnConsole::WriteToTexture(const Ogre::String& str, Ogre::TexturePtr destTe
 stop:
 
 	destBuffer->unlock();
-
-	// Free the memory allocated for the textureBuffer
-	free(textureBuffer);
 }
 
 bool AnnConsole::setFromPointedHistory()
@@ -551,6 +624,8 @@ void AnnConsole::addToHistory(const std::string& input)
 
 bool AnnConsole::runSpecialInput(const std::string& input)
 {
+	static const std::string scriptProfilerCommand{ "scriptprof" };
+
 	if(input == "help")
 	{
 		bufferClear();
@@ -561,6 +636,7 @@ bool AnnConsole::runSpecialInput(const std::string& input)
 		append("you can't create global variables from that console. You have to");
 		append("reference GameObject by their name for example");
 		append("You can display this help by typing \"help\"");
+		append("Type \"scriptprof N\" to list the N slowest behavior scripts");
 
 		return true;
 	}
@@ -592,6 +668,43 @@ bool AnnConsole::runSpecialInput(const std::string& input)
 		return true;
 	}
 
+	else if(input.compare(0, scriptProfilerCommand.size(), scriptProfilerCommand) == 0)
+	{
+		//"scriptprof" or "scriptprof N" to list the N scripts that took the most time during the last frame
+		size_t count{ 10 };
+		if(input.size() > scriptProfilerCommand.size())
+		{
+			if(input[scriptProfilerCommand.size()] != ' ') return false;
+			try
+			{
+				count = std::stoul(input.substr(scriptProfilerCommand.size() + 1));
+			}
+			catch(const std::logic_error&)
+			{
+				return false;
+			}
+		}
+
+		bufferClear();
+		const auto profiles = AnnGetScriptManager()->getScriptProfiles();
+		append("Script                       last (ms)  peak (ms)  total (ms)");
+		for(size_t i{ 0 }; i < std::min(count, profiles.size()); ++i)
+		{
+			const auto& profile = profiles[i];
+			char line[MAX_CONSOLE_LOG_WIDTH + 1];
+			std::snprintf(line, sizeof line, "%-23.23s x%-4zu %9.3f %10.3f %11.1f",
+						  profile.name.c_str(),
+						  profile.instances,
+						  profile.lastFrameTime,
+						  profile.peakFrameTime,
+						  profile.totalTime);
+			append(line);
+		}
+		if(profiles.empty()) append("No behavior scripts are running");
+
+		return true;
+	}
+
 	return false;
 }
 
@@ -59,7 +59,7 @@ void AnnDefaultEventListener::setKeys(KeyCode::code fw,
 //All keys are regarded as their equivalent on the American QWERTY layout, independently of the operating system behavior.
 //For compatibility purposes, it's possible that the engine has done a system call to set the current keyboard layout to the American QWERTY layout.
 //It will normally switch the keyboard back to it's original configuration once the AnnEngine object is destroyed
-void AnnDefaultEventListener::KeyEvent(AnnKeyEvent e)
+void AnnDefaultEventListener::KeyEvent(const AnnKeyEvent& e)
 {
 	//If the corresponding key is pressed, set the direction to true.
 	if(!e.shouldIgnore())
@@ -112,13 +112,13 @@ void AnnDefaultEventListener::KeyEvent(AnnKeyEvent e)
 // X : horizontal movement to the right in pixels
 // Y : Vertical movement, to the front in pixels
 // Z : Scroll wheel movement, scroll up is positive, in "line" increments
-void AnnDefaultEventListener::MouseEvent(AnnMouseEvent e)
+void AnnDefaultEventListener::MouseEvent(const AnnMouseEvent& e)
 {
 	player->applyMouseRelativeRotation(e.getAxis(MouseAxisID(X)).getRelValue());
 }
 
 //The stick event contain all the data for a specific joystick. In includes buttons current states, press and release events, stick relative and absolute values
-void AnnDefaultEventListener::ControllerEvent(AnnControllerEvent e)
+void AnnDefaultEventListener::ControllerEvent(const AnnControllerEvent& e)
 {
 	if(AnnGetVRRenderer()->shouldPauseFlag()) return;
 	if(!e.isXboxController()) return;
@@ -145,7 +145,7 @@ void AnnDefaultEventListener::reclampDegreeToPositiveRange(float& degree)
 		degree += 360.0f;
 }
 
-void AnnDefaultEventListener::HandControllerEvent(AnnHandControllerEvent e)
+void AnnDefaultEventListener::HandControllerEvent(const AnnHandControllerEvent& e)
 {
 	if(AnnGetVRRenderer()->shouldPauseFlag()) return;
 	auto rightStickThreashold{ 0.0225 };
@@ -0,0 +1,202 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnDistanceFieldFont.hpp"
+#include "AnnGlyphAtlas.hpp"
+#include "AnnGetter.hpp"
+#include "AnnLogger.hpp"
+
+#include <OgreBitwise.h>
+#include <OgreHardwarePixelBuffer.h>
+#include <OgreTextureManager.h>
+
+#include <unordered_map>
+
+using namespace Annwvyn;
+
+namespace
+{
+	///Distance fields of the fonts already used
+	std::unordered_map<Ogre::Font*, std::unique_ptr<AnnDistanceFieldFont>> fieldCache;
+
+	///Offset from a pixel to the closest seed pixel
+	struct Offset
+	{
+		int32_t x, y;
+		int32_t squaredLength() const { return x * x + y * y; }
+	};
+
+	///Further than any glyph
+	const Offset noSeed{ 4096, 4096 };
+
+	///Two passes Euclidean distance transform (8SSEDT). Each pixel ends up with the offset to the closest seed
+	void distanceTransform(std::vector<Offset>& grid, int width, int height)
+	{
+		const auto compare = [&](Offset& offset, int x, int y, int dx, int dy) {
+			if(x + dx < 0 || y + dy < 0 || x + dx >= width || y + dy >= height) return;
+			auto other = grid[(y + dy) * width + x + dx];
+			other.x += dx;
+			other.y += dy;
+			if(other.squaredLength() < offset.squaredLength()) offset = other;
+		};
+
+		for(auto y{ 0 }; y < height; ++y)
+		{
+			for(auto x{ 0 }; x < width; ++x)
+			{
+				auto& offset = grid[y * width + x];
+				compare(offset, x, y, -1, 0);
+				compare(offset, x, y, 0, -1);
+				compare(offset, x, y, -1, -1);
+				compare(offset, x, y, 1, -1);
+			}
+			for(auto x{ width - 1 }; x >= 0; --x)
+				compare(grid[y * width + x], x, y, 1, 0);
+		}
+
+		for(auto y{ height - 1 }; y >= 0; --y)
+		{
+			for(auto x{ width - 1 }; x >= 0; --x)
+			{
+				auto& offset = grid[y * width + x];
+				compare(offset, x, y, 1, 0);
+				compare(offset, x, y, 0, 1);
+				compare(offset, x, y, -1, 1);
+				compare(offset, x, y, 1, 1);
+			}
+			for(auto x{ 0 }; x < width; ++x)
+				compare(grid[y * width + x], x, y, -1, 0);
+		}
+	}
+}
+
+void AnnDistanceFieldFont::computeDistanceField(const uint8_t* coverage, size_t width, size_t height, uint16_t spread, uint8_t* field)
+{
+	const auto fieldWidth  = int(width + 2 * spread);
+	const auto fieldHeight = int(height + 2 * spread);
+
+	//Distance to the closest inside pixel, and to the closest outside pixel
+	std::vector<Offset> toInside(fieldWidth * fieldHeight, noSeed), toOutside(fieldWidth * fieldHeight, Offset{ 0, 0 });
+	for(size_t y{ 0 }; y < height; ++y)
+		for(size_t x{ 0 }; x < width; ++x)
+			if(coverage[y * width + x] >= 128)
+			{
+				const auto index  = (y + spread) * fieldWidth + x + spread;
+				toInside[index]  = { 0, 0 };
+				toOutside[index] = noSeed;
+			}
+
+	distanceTransform(toInside, fieldWidth, fieldHeight);
+	distanceTransform(toOutside, fieldWidth, fieldHeight);
+
+	//0.5 on the outline, 1 at `spread` pixels inside, 0 at `spread` pixels outside
+	for(auto i{ 0 }; i < fieldWidth * fieldHeight; ++i)
+	{
+		const auto distance = std::sqrt(float(toOutside[i].squaredLength())) - std::sqrt(float(toInside[i].squaredLength()));
+		const auto value	= Ogre::Math::Clamp(0.5f + distance / (2.f * spread), 0.f, 1.f);
+		field[i]			= uint8_t(value * 255.f + 0.5f);
+	}
+}
+
+AnnDistanceFieldFont::AnnDistanceFieldFont(Ogre::Font* font, uint16_t spread) :
+ fontHandle(font->getHandle()),
+ spread(spread),
+ glyphs{}
+{
+	using namespace Ogre;
+
+	const auto& atlas = AnnGlyphAtlas::get(font);
+
+	//Place the glyphs on shelves, with room for the spread around each of them
+	struct Cell
+	{
+		size_t x, y;
+	};
+	std::array<Cell, 256> cells{};
+	size_t textureWidth{ 512 };
+	for(size_t c{ 0 }; c < glyphs.size(); ++c)
+		textureWidth = std::max<size_t>(textureWidth, Bitwise::firstPO2From(uint32(atlas.getGlyph(char(c)).width + 2 * spread)));
+
+	size_t cursorX{ 0 }, cursorY{ 0 }, shelfHeight{ 0 };
+	for(size_t c{ 0 }; c < glyphs.size(); ++c)
+	{
+		const auto& glyph = atlas.getGlyph(char(c));
+		if(glyph.width == 0 || glyph.height == 0) continue;
+
+		const size_t cellWidth  = glyph.width + 2 * spread;
+		const size_t cellHeight = glyph.height + 2 * spread;
+		if(cursorX + cellWidth > textureWidth)
+		{
+			cursorX = 0;
+			cursorY += shelfHeight;
+			shelfHeight = 0;
+		}
+
+		cells[c] = { cursorX, cursorY };
+		cursorX += cellWidth;
+		shelfHeight = std::max(shelfHeight, cellHeight);
+	}
+	const size_t textureHeight = Bitwise::firstPO2From(uint32(std::max<size_t>(1, cursorY + shelfHeight)));
+
+	//White, with the distance in the alpha channel
+	std::vector<uint8_t> pixels(textureWidth * textureHeight * 4, 255);
+	for(size_t i{ 3 }; i < pixels.size(); i += 4) pixels[i] = 0;
+
+	std::vector<uint8_t> coverage, field;
+	for(size_t c{ 0 }; c < glyphs.size(); ++c)
+	{
+		const auto& glyph = atlas.getGlyph(char(c));
+		if(glyph.width == 0 || glyph.height == 0) continue;
+
+		coverage.resize(glyph.width * glyph.height);
+		for(size_t row{ 0 }; row < glyph.height; ++row)
+			memcpy(&coverage[row * glyph.width], atlas.getCoverage(glyph, row), glyph.width);
+
+		const size_t cellWidth  = glyph.width + 2 * spread;
+		const size_t cellHeight = glyph.height + 2 * spread;
+		field.resize(cellWidth * cellHeight);
+		computeDistanceField(coverage.data(), glyph.width, glyph.height, spread, field.data());
+
+		const auto& cell = cells[c];
+		for(size_t y{ 0 }; y < cellHeight; ++y)
+			for(size_t x{ 0 }; x < cellWidth; ++x)
+				pixels[((cell.y + y) * textureWidth + cell.x + x) * 4 + 3] = field[y * cellWidth + x];
+
+		glyphs[c] = { float(cell.x) / textureWidth,
+					  float(cell.y) / textureHeight,
+					  float(cell.x + cellWidth) / textureWidth,
+					  float(cell.y + cellHeight) / textureHeight,
+					  glyph.width,
+					  glyph.height };
+	}
+
+	texture = TextureManager::getSingleton().createManual(AnnGetStringUtility()->getRandomString(),
+														  AnnResourceManager::getDefaultResourceGroupName(),
+														  TEX_TYPE_2D,
+														  uint(textureWidth),
+														  uint(textureHeight),
+														  0,
+														  PF_R8G8B8A8,
+														  TU_STATIC_WRITE_ONLY);
+	texture->getBuffer()->blitFromMemory(PixelBox(uint32(textureWidth), uint32(textureHeight), 1, PF_BYTE_RGBA, pixels.data()));
+
+	AnnDebug() << "Distance field of font " << font->getName() << " built : " << textureWidth << "x" << textureHeight;
+}
+
+AnnDistanceFieldFont::~AnnDistanceFieldFont()
+{
+	if(auto textureManager = Ogre::TextureManager::getSingletonPtr())
+		textureManager->remove(texture->getHandle());
+}
+
+const AnnDistanceFieldFont& AnnDistanceFieldFont::get(Ogre::Font* font)
+{
+	auto& field = fieldCache[font];
+	if(!field || field->fontHandle != font->getHandle()) field = std::make_unique<AnnDistanceFieldFont>(font);
+	return *field;
+}
+
+void AnnDistanceFieldFont::clearCache()
+{
+	fieldCache.clear();
+}
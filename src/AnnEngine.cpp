@@ -4,9 +4,13 @@
 #include "AnnEngine.hpp"
 #include "AnnLogger.hpp"
 #include "AnnException.hpp"
+#include "AnnGlyphAtlas.hpp"
+#include "AnnDistanceFieldFont.hpp"
+#include "AnnTrace.hpp"
 
-//Include the built-in renderer that doesn't do VR
+//Include the built-in renderers that don't do VR
 #include "AnnOgreNoVRRenderer.hpp"
+#include "AnnOgreReplayRenderer.hpp"
 
 using namespace Annwvyn;
 
@@ -120,6 +124,14 @@ void AnnEngine::selectAndCreateRenderer(const std::string& selectedRenderer, con
 		set		 = true;
 	}
 
+	//Built-in renderer that plays back an input recording instead of tracking anything
+	else if(selectedRenderer == "Replay")
+	{
+		std::cerr << "User requested to replay an input recording. Instantiating the built-in Replay\n";
+		renderer = std::make_shared<AnnOgreReplayRenderer>(title);
+		set		 = true;
+	}
+
 	if(!set)
 	{
 #ifdef _WIN32
@@ -228,6 +240,7 @@ AnnEngine::AnnEngine(const char title[], const std::string& hmdCommand) :
 
 	singleton	= this;
 	consoleReady = false;
+	logger		 = std::make_unique<AnnLogger>(logFileName);
 
 #ifdef _WIN32 //Windows specific setup
 
@@ -241,11 +254,19 @@ AnnEngine::AnnEngine(const char title[], const std::string& hmdCommand) :
 
 	stringUtility = std::make_shared<AnnStringUility>();
 
-	selectAndCreateRenderer(hmdCommand, title);
-	renderer->initOgreRoot(logFileName);
+	//Measure the time spent in each step of the engine startup
+	const auto startupBegin = std::chrono::steady_clock::now();
+	const auto timeStartupStep = [this](const std::string& step, auto&& stepFunction) {
+		const auto start = std::chrono::steady_clock::now();
+		stepFunction();
+		startupTimings.emplace_back(step, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	};
+
+	timeStartupStep("Renderer creation", [&] { selectAndCreateRenderer(hmdCommand, title); });
+	timeStartupStep("Ogre root", [&] { renderer->initOgreRoot(logFileName); });
 	player = std::make_shared<AnnPlayerBody>();
-	renderer->initVrHmd();
-	renderer->initPipeline();
+	timeStartupStep("VR hardware", [&] { renderer->initVrHmd(); });
+	timeStartupStep("Render pipeline", [&] { renderer->initPipeline(); });
 	SceneManager = renderer->getSceneManager();
 	renderer->showDebug(AnnOgreVRRenderer::DebugMode::MONOSCOPIC);
 
@@ -260,16 +281,16 @@ AnnEngine::AnnEngine(const char title[], const std::string& hmdCommand) :
 	// - other less important operation are done
 	// then the game can redraw
 
-	subsystems.push_back(levelManager = std::make_shared<AnnLevelManager>());
-	subsystems.push_back(gameObjectManager = std::make_shared<AnnGameObjectManager>());
-	subsystems.push_back(physicsEngine = std::make_shared<AnnPhysicsEngine>(getSceneManager()->getRootSceneNode(), player));
-	subsystems.push_back(eventManager = std::make_shared<AnnEventManager>(renderer->getWindow()));
-	subsystems.push_back(audioEngine = std::make_shared<AnnAudioEngine>());
-	subsystems.push_back(filesystemManager = std::make_shared<AnnFilesystemManager>(title));
-	subsystems.push_back(resourceManager = std::make_shared<AnnResourceManager>());
-	subsystems.push_back(sceneryManager = std::make_shared<AnnSceneryManager>(renderer));
-	subsystems.push_back(scriptManager = std::make_shared<AnnScriptManager>());
-	renderer->initClientHmdRendering();
+	timeStartupStep("LevelManager", [&] { subsystems.push_back(levelManager = std::make_shared<AnnLevelManager>()); });
+	timeStartupStep("GameObjectManager", [&] { subsystems.push_back(gameObjectManager = std::make_shared<AnnGameObjectManager>()); });
+	timeStartupStep("PhysicsEngine", [&] { subsystems.push_back(physicsEngine = std::make_shared<AnnPhysicsEngine>(getSceneManager()->getRootSceneNode(), player)); });
+	timeStartupStep("EventManager", [&] { subsystems.push_back(eventManager = std::make_shared<AnnEventManager>(renderer->getWindow())); });
+	timeStartupStep("AudioEngine", [&] { subsystems.push_back(audioEngine = std::make_shared<AnnAudioEngine>()); });
+	timeStartupStep("FilesystemManager", [&] { subsystems.push_back(filesystemManager = std::make_shared<AnnFilesystemManager>(title)); });
+	timeStartupStep("ResourceManager", [&] { subsystems.push_back(resourceManager = std::make_shared<AnnResourceManager>()); });
+	timeStartupStep("SceneryManager", [&] { subsystems.push_back(sceneryManager = std::make_shared<AnnSceneryManager>(renderer)); });
+	timeStartupStep("ScriptManager", [&] { subsystems.push_back(scriptManager = std::make_shared<AnnScriptManager>()); });
+	timeStartupStep("VR rendering", [&] { renderer->initClientHmdRendering(); });
 
 	vrRendererPovGameplayPlacement = renderer->getCameraInformationNode();
 	vrRendererPovGameplayPlacement->setPosition(player->getPosition() + AnnVect3(0.0f, player->getEyesHeight(), 0.0f));
@@ -277,7 +298,8 @@ AnnEngine::AnnEngine(const char title[], const std::string& hmdCommand) :
 	//This subsystem need the vrRendererPovGameplayPlacement object to be
 	//initialized. And the Resource manager because it wants a font file and an
 	//image background
-	subsystems.push_back(onScreenConsole = std::make_shared<AnnConsole>());
+	timeStartupStep("Console", [&] { subsystems.push_back(onScreenConsole = std::make_shared<AnnConsole>()); });
+	const auto startupTotal = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count();
 
 	consoleReady = true;
 	//Display start banner
@@ -291,6 +313,28 @@ AnnEngine::AnnEngine(const char title[], const std::string& hmdCommand) :
 	writeToLog("| Visit https://wwwannwvyn.org/ for more informations!     |", false);
 	writeToLog("| Version : " + getAnnwvynVersion(61 - 13 - 1) + "|", false);
 	writeToLog("============================================================", false);
+
+	logStartupTimings(startupTotal);
+}
+
+void AnnEngine::logStartupTimings(double total) const
+{
+	writeToLog("Startup time breakdown :", false);
+	for(const auto& timing : startupTimings)
+	{
+		std::stringstream line;
+		line << " - " << std::left << std::setw(20) << timing.first << std::right << std::fixed << std::setprecision(2) << std::setw(10) << timing.second << "ms";
+		writeToLog(line.str(), false);
+	}
+
+	std::stringstream line;
+	line << " = " << std::left << std::setw(20) << "Total" << std::right << std::fixed << std::setprecision(2) << std::setw(10) << total << "ms";
+	writeToLog(line.str(), false);
+}
+
+const std::vector<std::pair<std::string, double>>& AnnEngine::getStartupTimings() const
+{
+	return startupTimings;
 }
 
 AnnEngine::~AnnEngine()
@@ -299,6 +343,9 @@ AnnEngine::~AnnEngine()
 	writeToLog("Game engine stopped. Subsystem are shutting down...");
 	writeToLog("Good luck with the real world now! :3");
 	consoleReady = false;
+	AnnTrace::stop();
+	AnnDistanceFieldFont::clearCache();
+	AnnGlyphAtlas::clearCache();
 #ifdef _WIN32
 	if(manualConsole) FreeConsole();
 #endif
@@ -320,7 +367,14 @@ AnnAudioEnginePtr AnnEngine::getAudioEngine() const { return audioEngine; }
 AnnPhysicsEnginePtr AnnEngine::getPhysicsEngine() const { return physicsEngine; }
 Ogre::SceneNode* AnnEngine::getPlayerPovNode() const { return vrRendererPovGameplayPlacement; }
 Ogre::SceneManager* AnnEngine::getSceneManager() const { return SceneManager; }
-unsigned long AnnEngine::getTimeFromStartUp() const { return renderer->getTimer()->getMilliseconds(); }
+unsigned long AnnEngine::getTimeFromStartUp() const
+{
+	//Recorded and replayed sessions see the clock of the frame
+	double recordedClock;
+	if(eventManager && eventManager->getRecordedClock(recordedClock)) return static_cast<unsigned long>(recordedClock * 1000.0);
+	return renderer->getTimer()->getMilliseconds();
+}
+
 double AnnEngine::getTimeFromStartupSeconds() const { return double(getTimeFromStartUp()) / 1000.0; }
 void AnnEngine::initPlayerStandingPhysics() const { physicsEngine->initPlayerStandingPhysics(vrRendererPovGameplayPlacement); }
 void AnnEngine::initPlayerRoomscalePhysics() const { physicsEngine->initPlayerRoomscalePhysics(vrRendererPovGameplayPlacement); }
@@ -346,25 +400,17 @@ void AnnEngine::setConsoleYellow()
 //This is static, but actually needs Ogre to be running. So be careful
 void AnnEngine::writeToLog(std::string message, bool flag)
 {
-	if(consoleReady)
-		singleton->onScreenConsole->append(message);
-
-	if(flag)
-	{
-		setConsoleYellow();
-		message = "Annwvyn - " + message;
-	}
-	else
-	{
-		setConsoleGreen();
-	}
+	AnnLogger::push(std::move(message), AnnLogLevel::info, flag);
+}
 
-	if(Ogre::LogManager::getSingletonPtr())
-		Ogre::LogManager::getSingleton().logMessage(message);
-	else
-		std::cout << message << '\n';
+void AnnEngine::writeDeferredLog() const
+{
+	//The console is only touched by the main thread
+	const auto messages = AnnLogger::takeConsoleMessages();
+	if(!consoleReady) return;
 
-	setConsoleGreen();
+	for(const auto& message : messages)
+		onScreenConsole->append(message);
 }
 
 //Need to be redone.
@@ -383,6 +429,9 @@ bool AnnEngine::checkNeedToQuit() const
 // of the game or app using this engine.
 bool AnnEngine::refresh()
 {
+	AnnTrace::frameBegin();
+	writeDeferredLog();
+
 	//Set player position from gameplay to the rendering code
 	syncPalyerPov();
 	//Update VR form real world
@@ -391,12 +440,21 @@ bool AnnEngine::refresh()
 	updateTime = renderer->getUpdateTime();
 	player->engineUpdate(float(getFrameTime()));
 
+	const auto tracing = AnnTrace::isRecording();
 	for(size_t i{ 0 }; i < subsystems.size(); ++i)
 		if(subsystems[i]->needUpdate())
+		{
+			const auto start = tracing ? AnnTrace::now() : AnnTrace::TimePoint{};
 			subsystems[i]->update();
+			if(tracing) AnnTrace::subsystem(subsystems[i]->name, start, AnnTrace::now());
+		}
 
 	//Update view
+	const auto renderStart = tracing ? AnnTrace::now() : AnnTrace::TimePoint{};
 	renderer->renderAndSubmitFrame();
+	if(tracing) AnnTrace::subsystem("Renderer", renderStart, AnnTrace::now());
+
+	AnnTrace::frameEnd();
 	return !checkNeedToQuit();
 }
 
@@ -6,6 +6,7 @@
 #include "AnnLogger.hpp"
 #include "AnnEngine.hpp"
 #include "AnnGetter.hpp"
+#include "AnnOgreReplayRenderer.hpp"
 
 using namespace Annwvyn;
 using std::abs;
@@ -23,16 +24,17 @@ AnnEventManager::AnnEventManager(Ogre::RenderWindow* w) :
  lastTimerCreated(0),
  defaultEventListener(nullptr),
  knowXbox(false),
- keyboardIgnore{ false }
+ keyboardIgnore{ false },
+ inputTime(0),
+ inputReplay(nullptr)
 {
 	//Reserve some memory
 	keyEventBuffer.reserve(10);
 	mouseEventBuffer.reserve(10);
-	stickEventBuffer.reserve(10);
 	handControllerEventBuffer.reserve(10);
 
 	//Init all bool array to false
-	for(auto& keyState : previousKeyStates) keyState = false;
+	for(auto& keyState : keyStates) keyState = false;
 	for(auto& mouseButtonState : previousMouseButtonStates) mouseButtonState = false;
 
 	//Configure and create the input system
@@ -45,11 +47,17 @@ AnnEventManager::AnnEventManager(Ogre::RenderWindow* w) :
 	//Get the keyboard, mouse and joysticks objects
 	Keyboard = static_cast<OIS::Keyboard*>(InputManager->createInputObject(OIS::OISKeyboard, true));
 	Mouse	= static_cast<OIS::Mouse*>(InputManager->createInputObject(OIS::OISMouse, true));
-	for(auto nbStick(0); nbStick < InputManager->getNumberOfDevices(OIS::OISJoyStick); nbStick++)
+
+	//The stick buffers are never moved once created : events point into them, and they own their OIS object
+	const auto nbSticks = size_t(std::max(0, InputManager->getNumberOfDevices(OIS::OISJoyStick)));
+	Joysticks.reserve(nbSticks);
+	stickEventBuffer.reserve(nbSticks);
+	for(size_t nbStick(0); nbStick < nbSticks; nbStick++)
 	{
 		//Create joystick object
 		const auto oisJoystick = static_cast<OIS::JoyStick*>(InputManager->createInputObject(OIS::OISJoyStick, true));
 		Joysticks.emplace_back(oisJoystick);
+		setupControllerEvent(Joysticks.back());
 
 		const auto& vendor = oisJoystick->vendor();
 		AnnDebug() << "Detected joystick : " << vendor;
@@ -63,8 +71,17 @@ AnnEventManager::AnnEventManager(Ogre::RenderWindow* w) :
 		}
 	}
 
+	if(knowXbox)
+		for(auto& joystick : Joysticks)
+			joystick.event.xbox = joystick.event.stickID == xboxID;
+
+	//Key events are received from OIS during capture. The text inputer gets them from this object
 	textInputer = std::make_unique<AnnTextInputer>();
-	Keyboard->setEventCallback(textInputer.get());
+	Keyboard->setEventCallback(this);
+
+	//When the renderer plays back a recording, the input comes from it
+	if(const auto replayRenderer = std::dynamic_pointer_cast<AnnOgreReplayRenderer>(AnnGetVRRenderer()))
+		inputReplay = replayRenderer->getInputReplay();
 }
 
 AnnTextInputer* AnnEventManager::getTextInputer() const
@@ -74,6 +91,8 @@ AnnTextInputer* AnnEventManager::getTextInputer() const
 
 AnnEventManager::~AnnEventManager()
 {
+	stopInputThread();
+	stopInputRecording();
 	clearListenerList();
 	defaultEventListener = nullptr;
 	Keyboard->setEventCallback(nullptr);
@@ -148,6 +167,8 @@ unsigned int AnnControllerBuffer::idcounter = 0;
 
 void AnnEventManager::captureEvents()
 {
+	inputTime = getInputTime();
+
 	//Capture events
 	Keyboard->capture();
 	Mouse->capture();
@@ -156,89 +177,237 @@ void AnnEventManager::captureEvents()
 		joystick.oisJoystick->capture();
 }
 
-void AnnEventManager::processKeyboardEvents()
+double AnnEventManager::getInputTime()
 {
-	//for each key of the keyboard, if state changed:
-	for(size_t c(0); c < KeyCode::SIZE; c++)
-		if(Keyboard->isKeyDown(OIS::KeyCode(c)) != previousKeyStates[c])
-		{
-			//create a corresponding key event
-			AnnKeyEvent e;
-			e.setCode(KeyCode::code(c));
-			e.ignored																	  = keyboardIgnore;
-			bool(previousKeyStates[c] = Keyboard->isKeyDown(OIS::KeyCode(c))) ? e.pressed = true : e.pressed = false;
-
-			//Add to buffer
-			keyEventBuffer.push_back(e);
-		}
+	return double(AnnGetVRRenderer()->getTimer()->getMicroseconds()) / 1000000.0;
+}
+
+bool AnnEventManager::keyPressed(const OIS::KeyEvent& arg)
+{
+	processSample({ AnnInputSample::key, true, 0, uint32_t(arg.key), arg.text, {}, {} }, inputTime);
+	return true;
+}
+
+bool AnnEventManager::keyReleased(const OIS::KeyEvent& arg)
+{
+	processSample({ AnnInputSample::key, false, 0, uint32_t(arg.key), arg.text, {}, {} }, inputTime);
+	return true;
+}
+
+void AnnEventManager::bufferKeyEvent(OIS::KeyCode key, bool pressed, double time)
+{
+	if(size_t(key) >= KeyCode::SIZE || keyStates[key] == pressed) return;
+	keyStates[key] = pressed;
+
+	AnnKeyEvent e;
+	e.setCode(KeyCode::code(key));
+	e.ignored = keyboardIgnore;
+	e.pressed = pressed;
+	e.time	= time;
+	keyEventBuffer.push_back(e);
 }
 
 void AnnEventManager::processMouseEvents()
 {
-	auto state(Mouse->getMouseState());
+	const auto& state = Mouse->getMouseState();
+	processSample({ AnnInputSample::mouse, false, 0, uint32_t(state.buttons), 0, { state.X.rel, state.X.abs, state.Y.rel, state.Y.abs, state.Z.rel, state.Z.abs }, {} }, inputTime);
+}
 
-	AnnMouseEvent e;
+void AnnEventManager::setupControllerEvent(AnnControllerBuffer& joystick)
+{
+	const auto& state = joystick.oisJoystick->getJoyStickState();
+	for(size_t i{ 0 }; i < joystick.axes.size(); ++i)
+	{
+		joystick.axes[i]	   = { ControllerAxisID(i), 0, 0 };
+		joystick.axes[i].noRel = state.mAxes[i].absOnly;
+	}
 
-	for(size_t i(0); i < ButtonCount; i++)
-		e.setButtonStatus(MouseButtonId(i), state.buttonDown(OIS::MouseButtonID(i)));
+	auto& event	= joystick.event;
+	event.vendor   = &joystick.oisJoystick->vendor();
+	event.stickID  = joystick.getID();
+	event.buttons  = { joystick.buttons.data(), joystick.buttons.size() };
+	event.axes	 = { joystick.axes.data(), joystick.axes.size() };
+	event.povs	 = { joystick.povs.data(), joystick.povs.size() };
+	event.pressed  = { joystick.pressed.data(), 0 };
+	event.released = { joystick.released.data(), 0 };
+}
 
-	e.setAxisInformation(X, AnnMouseAxis(X, state.X.rel, state.X.abs));
-	e.setAxisInformation(Y, AnnMouseAxis(Y, state.Y.rel, state.Y.abs));
-	e.setAxisInformation(Z, AnnMouseAxis(Z, state.Z.rel, state.Z.abs));
+void AnnEventManager::setStickButton(size_t stick, size_t button, bool down, double time)
+{
+	auto& joystick = Joysticks[stick];
+	if(button >= joystick.buttons.size() || bool(joystick.buttons[button]) == down) return;
+	joystick.buttons[button] = down ? 1 : 0;
+	inputRecorder.input({ AnnInputSample::stickButton, down, uint16_t(stick), uint32_t(button), 0, {}, {} }, time);
+
+	//A button can be pressed more than once in a frame when the input thread runs. The lists can't grow
+	auto& list	 = down ? joystick.event.pressed : joystick.event.released;
+	auto& storage = down ? joystick.pressed : joystick.released;
+	if(list.size() < storage.size())
+	{
+		storage[list.size()] = static_cast<unsigned short>(button);
+		list				 = { storage.data(), list.size() + 1 };
+	}
 
-	mouseEventBuffer.push_back(e);
+	joystick.changed	= true;
+	joystick.event.time = time;
+}
+
+void AnnEventManager::setStickAxis(size_t stick, size_t axis, int abs, int rel, double time)
+{
+	auto& joystick = Joysticks[stick];
+	if(axis >= joystick.axes.size()) return;
+	auto& value = joystick.axes[axis];
+	if(value.a == abs && value.r == rel) return;
+	inputRecorder.input({ AnnInputSample::stickAxis, false, uint16_t(stick), uint32_t(axis), 0, { abs, rel }, {} }, time);
+
+	value.a				= abs;
+	value.r				= rel;
+	joystick.changed	= true;
+	joystick.event.time = time;
+}
+
+void AnnEventManager::setStickPov(size_t stick, size_t pov, int direction, double time)
+{
+	auto& joystick = Joysticks[stick];
+	if(pov >= joystick.povs.size() || joystick.povDirections[pov] == direction) return;
+	inputRecorder.input({ AnnInputSample::stickPov, false, uint16_t(stick), uint32_t(pov), 0, { direction }, {} }, time);
+
+	joystick.povDirections[pov] = direction;
+	joystick.povs[pov]			= { unsigned(direction) };
+	joystick.changed			= true;
+	joystick.event.time			= time;
 }
 
 void AnnEventManager::processJoystickEvents()
 {
-	for(auto& Joystick : Joysticks)
+	for(size_t stick{ 0 }; stick < Joysticks.size(); ++stick)
 	{
-		const auto& state(Joystick.oisJoystick->getJoyStickState());
-		AnnControllerEvent stickEvent;
-		stickEvent.vendor  = Joystick.oisJoystick->vendor();
-		stickEvent.stickID = Joystick.getID();
-
-		//Get all buttons immediate data
-		const auto buttonSize = state.mButtons.size();
-		stickEvent.buttons.resize(buttonSize);
-		for(auto i = 0u; i < buttonSize; ++i)
+		const auto& state = Joysticks[stick].oisJoystick->getJoyStickState();
+
+		for(size_t button{ 0 }; button < state.mButtons.size(); ++button)
+			setStickButton(stick, button, state.mButtons[button], inputTime);
+
+		for(size_t axis{ 0 }; axis < state.mAxes.size(); ++axis)
+			setStickAxis(stick, axis, state.mAxes[axis].abs, state.mAxes[axis].rel, inputTime);
+
+		//The joystick state object always have 4 Pov but the event has the number of Pov the stick has
+		for(size_t pov{ 0 }; pov < Joysticks[stick].povs.size(); ++pov)
+			setStickPov(stick, pov, state.mPOV[pov].direction, inputTime);
+	}
+}
+
+void AnnEventManager::processSample(const AnnInputSample& sample, double time)
+{
+	switch(sample.kind)
+	{
+		case AnnInputSample::key:
 		{
-			if(state.mButtons[i])
-				stickEvent.buttons[i] = 1;
+			inputRecorder.input(sample, time);
+			bufferKeyEvent(OIS::KeyCode(sample.index), sample.pressed, time);
+			const OIS::KeyEvent keyEvent(Keyboard, OIS::KeyCode(sample.index), sample.text);
+			if(sample.pressed)
+				textInputer->keyPressed(keyEvent);
 			else
-				stickEvent.buttons[i] = 0;
+				textInputer->keyReleased(keyEvent);
+			break;
 		}
+		case AnnInputSample::mouse:
+			inputRecorder.input(sample, time);
+			for(size_t i(0); i < ButtonCount; i++)
+				sampledMouse.setButtonStatus(MouseButtonId(i), (sample.index & (1u << i)) != 0);
+			for(auto axis : { X, Y, Z })
+			{
+				sampledMouse.axes[axis].rel += sample.values[axis * 2];
+				sampledMouse.axes[axis].abs = sample.values[axis * 2 + 1];
+			}
+			sampledMouse.time = time;
+			break;
+
+		//The stick setters record the changes themselves. A recording may come from a computer with more sticks
+		case AnnInputSample::stickButton:
+			if(sample.stick < Joysticks.size()) setStickButton(sample.stick, sample.index, sample.pressed, time);
+			break;
+		case AnnInputSample::stickAxis:
+			if(sample.stick < Joysticks.size()) setStickAxis(sample.stick, sample.index, sample.values[0], sample.values[1], time);
+			break;
+		case AnnInputSample::stickPov:
+			if(sample.stick < Joysticks.size()) setStickPov(sample.stick, sample.index, sample.values[0], time);
+			break;
+	}
+}
 
-		//Get all axes immediate data
-		auto axisID = 0;
-		for(const auto& axis : state.mAxes)
-		{
-			AnnControllerAxis annAxis{ axisID++, axis.rel, axis.abs };
-			annAxis.noRel = axis.absOnly;
-			stickEvent.axes.push_back(annAxis);
-		}
+void AnnEventManager::processSampledInput()
+{
+	//Samples are timed with the steady clock, events with the engine clock
+	const auto steadyNow	= std::chrono::steady_clock::now();
+	const auto engineNow	= getInputTime();
+	const auto toEngineTime = [&](std::chrono::steady_clock::time_point time) {
+		return engineNow - std::chrono::duration<double>(steadyNow - time).count();
+	};
+
+	AnnInputSample sample;
+	while(inputThread->pop(sample))
+		processSample(sample, toEngineTime(sample.time));
+}
+
+void AnnEventManager::processReplayedInput()
+{
+	//Changes are timed relative to the frame they happened in
+	for(const auto& input : inputReplay->getInputs())
+		processSample(input.sample, inputTime - input.age);
+}
 
-		//The joystick state object always have 4 Pov but the AnnControllerEvent has the number of Pov the stick has
-		const auto nbPov = size_t(Joystick.oisJoystick->getNumberOfComponents(OIS::ComponentType::OIS_POV));
-		for(auto i(0u); i < nbPov; i++)
-			stickEvent.povs.push_back({ unsigned(state.mPOV[i].direction) });
-
-		//Get press and release event lists
-		const auto nbButton{ min(state.mButtons.size(), Joystick.previousStickButtonStates.size()) };
-		for(auto button(0u); button < nbButton; button++)
-			if(!Joystick.previousStickButtonStates[button] && state.mButtons[button])
-				stickEvent.pressed.push_back(static_cast<unsigned short>(button));
-			else if(Joystick.previousStickButtonStates[button] && !state.mButtons[button])
-				stickEvent.released.push_back(static_cast<unsigned short>(button));
-
-		//Save current buttons state for next frame
-		Joystick.previousStickButtonStates = stickEvent.buttons;
-		if(knowXbox)
-			if(stickEvent.stickID == xboxID)
-				stickEvent.xbox = true;
-
-		stickEventBuffer.push_back(stickEvent);
+void AnnEventManager::startInputThread(double frequency)
+{
+	stopInputThread();
+	if(inputReplay)
+	{
+		AnnDebug(AnnLogLevel::warning) << "Input is replayed from a recording, the input thread is not started";
+		return;
 	}
+
+	std::vector<OIS::JoyStick*> sticks;
+	for(auto& joystick : Joysticks) sticks.push_back(joystick.oisJoystick);
+
+	//The samples continue from the mouse state of the last capture
+	inputThread = std::make_unique<AnnInputThread>(Keyboard, Mouse, std::move(sticks), frequency);
+}
+
+void AnnEventManager::stopInputThread()
+{
+	inputThread.reset();
+}
+
+bool AnnEventManager::isInputThreadRunning() const
+{
+	return inputThread != nullptr;
+}
+
+bool AnnEventManager::startInputRecording(const std::string& fileName)
+{
+	return inputRecorder.start(fileName);
+}
+
+void AnnEventManager::stopInputRecording()
+{
+	inputRecorder.stop();
+}
+
+bool AnnEventManager::isRecordingInput() const
+{
+	return inputRecorder.isRecording();
+}
+
+bool AnnEventManager::isReplayingInput() const
+{
+	return inputReplay != nullptr;
+}
+
+bool AnnEventManager::getRecordedClock(double& clock) const
+{
+	if(!isRecordingInput() && !isReplayingInput()) return false;
+	clock = inputTime;
+	return true;
 }
 
 void AnnEventManager::processHandControllerEvents()
@@ -248,6 +417,7 @@ void AnnEventManager::processHandControllerEvents()
 		{
 			if(!handController) continue;
 			handControllerEventBuffer.push_back({ handController.get() });
+			handControllerEventBuffer.back().time = inputTime;
 		}
 }
 
@@ -256,10 +426,10 @@ void AnnEventManager::pushEventsToListeners()
 	for(auto& weak_listener : listeners)
 		if(auto listener = weak_listener.lock())
 		{
-			for(auto& e : keyEventBuffer) listener->KeyEvent(e);
-			for(auto& e : mouseEventBuffer) listener->MouseEvent(e);
-			for(auto& e : stickEventBuffer) listener->ControllerEvent(e);
-			for(auto& e : handControllerEventBuffer) listener->HandControllerEvent(e);
+			for(const auto& e : keyEventBuffer) listener->KeyEvent(e);
+			for(const auto& e : mouseEventBuffer) listener->MouseEvent(e);
+			for(auto e : stickEventBuffer) listener->ControllerEvent(*e);
+			for(const auto& e : handControllerEventBuffer) listener->HandControllerEvent(e);
 
 			listener->tick();
 		}
@@ -272,11 +442,50 @@ void AnnEventManager::pushEventsToListeners()
 
 void AnnEventManager::processInput()
 {
-	captureEvents();
-	processKeyboardEvents();
-	processMouseEvents();
-	processJoystickEvents();
+	//Press and release lists only hold this frame's changes
+	for(auto& joystick : Joysticks)
+	{
+		joystick.changed		 = false;
+		joystick.event.pressed  = { joystick.pressed.data(), 0 };
+		joystick.event.released = { joystick.released.data(), 0 };
+	}
+
+	//Relative mouse movements add up, the rest is the last known state
+	for(auto axis : { X, Y, Z })
+		sampledMouse.axes[axis].rel = 0;
+
+	if(inputReplay)
+	{
+		//The clock of the recorded session, not the one of this run
+		inputTime = inputReplay->getFrame().time;
+		processReplayedInput();
+	}
+	else if(inputThread)
+	{
+		inputTime = getInputTime();
+		processSampledInput();
+	}
+	else
+	{
+		//Key events are buffered by the keyboard callbacks during the capture
+		captureEvents();
+		processMouseEvents();
+		processJoystickEvents();
+	}
+
+	mouseEventBuffer.push_back(sampledMouse);
+	for(auto& joystick : Joysticks)
+		if(joystick.changed) stickEventBuffer.push_back(&joystick.event);
+
 	processHandControllerEvents();
+
+	//The tracking of this frame has been updated by the renderer before the subsystems
+	if(inputRecorder.isRecording())
+	{
+		const auto renderer = AnnGetVRRenderer();
+		inputRecorder.frame(renderer->getUpdateTime(), inputTime, renderer->trackedHeadPose, renderer->getHandControllerArray());
+	}
+
 	pushEventsToListeners();
 }
 
@@ -325,18 +534,7 @@ void AnnEventManager::processCollisionEvents()
 		if(auto listener = weakListener.lock())
 		{
 			for(const auto& collisionBuffer : collisionBuffers)
-			{
-				const auto aMov		= static_cast<AnnAbstractMovable*>(std::get<0>(collisionBuffer));
-				const auto bMov		= static_cast<AnnAbstractMovable*>(std::get<1>(collisionBuffer));
-				const auto position = std::get<2>(collisionBuffer);
-				const auto normal   = std::get<3>(collisionBuffer);
-
-				if(auto a = dynamic_cast<AnnGameObject*>(aMov))
-					if(auto b = dynamic_cast<AnnGameObject*>(bMov))
-					{
-						listener->CollisionEvent({ a, b, position, normal });
-					}
-			}
+				listener->CollisionEvent({ std::get<0>(collisionBuffer), std::get<1>(collisionBuffer), std::get<2>(collisionBuffer), std::get<3>(collisionBuffer) });
 
 			for(auto playerCollision : playerCollisionBuffer)
 				listener->PlayerCollisionEvent({ playerCollision });
@@ -359,8 +557,10 @@ void AnnEventManager::detectedCollision(void* a, void* b, AnnVect3 position, Ann
 	if(!a) return playerCollision(b);
 	if(!b) return playerCollision(a);
 
-	//push the object-object collision in the buffer
-	collisionBuffers.emplace_back(a, b, position, normal);
+	//push the object-object collision in the buffer. Objects are referenced by handle, as they can be removed before the event is sent
+	if(auto aObject = dynamic_cast<AnnGameObject*>(static_cast<AnnAbstractMovable*>(a)))
+		if(auto bObject = dynamic_cast<AnnGameObject*>(static_cast<AnnAbstractMovable*>(b)))
+			collisionBuffers.emplace_back(aObject->getHandle(), bObject->getHandle(), position, normal);
 }
 
 void AnnEventManager::playerCollision(void* object)
@@ -368,7 +568,7 @@ void AnnEventManager::playerCollision(void* object)
 	auto movable = static_cast<AnnAbstractMovable*>(object);
 	if(auto gameObject = dynamic_cast<AnnGameObject*>(movable))
 	{
-		playerCollisionBuffer.push_back(gameObject);
+		playerCollisionBuffer.push_back(gameObject->getHandle());
 	}
 	else if(auto triggerObject = dynamic_cast<AnnTriggerObject*>(movable))
 	{
@@ -9,7 +9,8 @@
 using namespace Annwvyn;
 
 AnnEvent::AnnEvent() :
- type(NO_TYPE)
+ type(NO_TYPE),
+ time(0)
 {
 }
 
@@ -18,6 +19,11 @@ AnnEventType AnnEvent::getType() const
 	return type;
 }
 
+double AnnEvent::getTime() const
+{
+	return time;
+}
+
 //---------------------------------------KEYBOARD
 AnnKeyEvent::AnnKeyEvent() :
  AnnEvent(),
@@ -117,7 +123,7 @@ AnnMouseEvent::AnnMouseEvent() :
 	type = USER_INPUT;
 }
 
-bool AnnMouseEvent::getButtonState(MouseButtonId id)
+bool AnnMouseEvent::getButtonState(MouseButtonId id) const
 {
 	if(id == InvalidButton) return false;
 
@@ -127,7 +133,7 @@ bool AnnMouseEvent::getButtonState(MouseButtonId id)
 	return false;
 }
 
-AnnMouseAxis AnnMouseEvent::getAxis(MouseAxisID id)
+AnnMouseAxis AnnMouseEvent::getAxis(MouseAxisID id) const
 {
 	if(id == InvalidAxis) return AnnMouseAxis(InvalidAxis, 0, 0);
 
@@ -302,6 +308,7 @@ AnnControllerPov::AnnControllerPov(unsigned int binaryDirection) :
 AnnControllerEvent::AnnControllerEvent() :
  AnnEvent(),
  xbox(false),
+ vendor(nullptr),
  stickID(-1)
 {
 	type = USER_INPUT;
@@ -314,7 +321,7 @@ ControllerID AnnControllerEvent::getControllerID() const
 	return stickID;
 }
 
-bool AnnControllerEvent::isDown(ButtonId id)
+bool AnnControllerEvent::isDown(ButtonId id) const
 {
 	if(id >= buttons.size()) return false;
 	return buttons[id] != 0;
@@ -325,18 +332,19 @@ size_t AnnControllerEvent::getNbButtons() const
 	return buttons.size();
 }
 
-std::vector<unsigned short> AnnControllerEvent::getPressed() const
+AnnSpan<const unsigned short> AnnControllerEvent::getPressed() const
 {
-	return pressed;
+	return { pressed.data(), pressed.size() };
 }
 
-std::vector<unsigned short> AnnControllerEvent::getReleased() const
+AnnSpan<const unsigned short> AnnControllerEvent::getReleased() const
 {
-	return released;
+	return { released.data(), released.size() };
 }
 
-AnnControllerAxis AnnControllerEvent::getAxis(ControllerAxisID ax)
+AnnControllerAxis AnnControllerEvent::getAxis(ControllerAxisID ax) const
 {
+	if(ax < 0 || size_t(ax) >= axes.size()) return {};
 	return axes[ax];
 }
 
@@ -345,7 +353,7 @@ size_t AnnControllerEvent::getAxisCount() const
 	return axes.size();
 }
 
-bool AnnControllerEvent::isPressed(ButtonId id)
+bool AnnControllerEvent::isPressed(ButtonId id) const
 {
 	//if id is not a valid button
 	if(id >= buttons.size()) return false;
@@ -355,7 +363,7 @@ bool AnnControllerEvent::isPressed(ButtonId id)
 	return false;
 }
 
-bool AnnControllerEvent::isReleased(ButtonId id)
+bool AnnControllerEvent::isReleased(ButtonId id) const
 {
 	//if id is not a valid button
 	if(id >= buttons.size()) return false;
@@ -365,12 +373,13 @@ bool AnnControllerEvent::isReleased(ButtonId id)
 	return false;
 }
 
-std::string AnnControllerEvent::getVendor() const
+const std::string& AnnControllerEvent::getVendor() const
 {
-	return vendor;
+	static const std::string noVendor;
+	return vendor ? *vendor : noVendor;
 }
 
-AnnControllerPov AnnControllerEvent::getPov(PovId pov)
+AnnControllerPov AnnControllerEvent::getPov(PovId pov) const
 {
 	if(pov < getPovCount())
 		return povs[pov];
@@ -400,7 +409,7 @@ void AnnTimeEvent::setTimerID(AnnTimerID id)
 	tID = id;
 }
 
-AnnCollisionEvent::AnnCollisionEvent(AnnGameObject* first, AnnGameObject* second, AnnVect3 position, AnnVect3 normal) :
+AnnCollisionEvent::AnnCollisionEvent(AnnGameObjectHandle first, AnnGameObjectHandle second, AnnVect3 position, AnnVect3 normal) :
  a{ first },
  b{ second },
  position{ position },
@@ -410,6 +419,12 @@ AnnCollisionEvent::AnnCollisionEvent(AnnGameObject* first, AnnGameObject* second
 }
 
 bool AnnCollisionEvent::hasObject(AnnGameObject* obj) const
+{
+	if(!obj) return false;
+	return hasObject(obj->getHandle());
+}
+
+bool AnnCollisionEvent::hasObject(AnnGameObjectHandle obj) const
 {
 	if(obj == a || obj == b)
 		return true;
@@ -418,10 +433,20 @@ bool AnnCollisionEvent::hasObject(AnnGameObject* obj) const
 
 AnnGameObject* AnnCollisionEvent::getA() const
 {
-	return a;
+	return a.get();
 }
 
 AnnGameObject* AnnCollisionEvent::getB() const
+{
+	return b.get();
+}
+
+AnnGameObjectHandle AnnCollisionEvent::getHandleA() const
+{
+	return a;
+}
+
+AnnGameObjectHandle AnnCollisionEvent::getHandleB() const
 {
 	return b;
 }
@@ -451,7 +476,7 @@ bool AnnCollisionEvent::isWallCollision(const float scalarApprox) const
 	return Ogre::Math::RealEqual(AnnVect3::UNIT_Y.dotProduct(normal), 0, scalarApprox);
 }
 
-AnnPlayerCollisionEvent::AnnPlayerCollisionEvent(AnnGameObject* collided) :
+AnnPlayerCollisionEvent::AnnPlayerCollisionEvent(AnnGameObjectHandle collided) :
  AnnEvent(),
  col{ collided }
 {
@@ -459,6 +484,11 @@ AnnPlayerCollisionEvent::AnnPlayerCollisionEvent(AnnGameObject* collided) :
 }
 
 AnnGameObject* AnnPlayerCollisionEvent::getObject() const
+{
+	return col.get();
+}
+
+AnnGameObjectHandle AnnPlayerCollisionEvent::getObjectHandle() const
 {
 	return col;
 }
@@ -482,9 +512,20 @@ bool AnnTimer::isTimeout() const
 }
 
 AnnControllerBuffer::AnnControllerBuffer(OIS::JoyStick* joystick) :
- oisJoystick(joystick)
+ oisJoystick(joystick),
+ changed(false)
 {
 	id = idcounter++;
+
+	//Everything an event can point to is allocated here, once
+	const auto& state = joystick->getJoyStickState();
+	buttons.resize(state.mButtons.size(), 0);
+	pressed.resize(state.mButtons.size());
+	released.resize(state.mButtons.size());
+	axes.resize(state.mAxes.size());
+	const auto nbPov = size_t(std::max(0, joystick->getNumberOfComponents(OIS::ComponentType::OIS_POV)));
+	povs.resize(std::min<size_t>(nbPov, 4));
+	povDirections.resize(povs.size(), OIS::Pov::Centered);
 }
 
 AnnControllerBuffer::~AnnControllerBuffer()
@@ -0,0 +1,49 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnFrameArena.hpp"
+
+using namespace Annwvyn;
+
+AnnFrameArena::AnnFrameArena(size_t blockSize) :
+ blockSize(blockSize),
+ currentBlock(0),
+ offset(0)
+{
+}
+
+void AnnFrameArena::reset()
+{
+	currentBlock = 0;
+	offset		 = 0;
+}
+
+size_t AnnFrameArena::getCapacity() const
+{
+	size_t capacity{ 0 };
+	for(auto size : blockSizes) capacity += size;
+	return capacity;
+}
+
+void* AnnFrameArena::allocateBytes(size_t size, size_t alignment)
+{
+	//Try the current block, then the next ones that have been allocated on a previous frame
+	for(; currentBlock < blocks.size(); ++currentBlock, offset = 0)
+	{
+		const auto base	= reinterpret_cast<uintptr_t>(blocks[currentBlock].get());
+		const auto aligned = (base + offset + alignment - 1) & ~uintptr_t(alignment - 1);
+		if(aligned + size <= base + blockSizes[currentBlock])
+		{
+			offset = aligned + size - base;
+			return reinterpret_cast<void*>(aligned);
+		}
+	}
+
+	//Nothing fits, get a new block big enough. Memory from new[] is aligned for any fundamental type
+	const auto newBlockSize = std::max(blockSize, size);
+	blocks.emplace_back(new unsigned char[newBlockSize]);
+	blockSizes.push_back(newBlockSize);
+	currentBlock = blocks.size() - 1;
+	offset		 = size;
+	return blocks.back().get();
+}
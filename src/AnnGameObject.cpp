@@ -5,6 +5,7 @@
 #include "AnnLogger.hpp"
 #include "AnnGetter.hpp"
 #include "AnnException.hpp"
+#include "AnnObjectRecycler.hpp"
 
 using namespace Annwvyn;
 
@@ -16,17 +17,32 @@ AnnGameObject::AnnGameObject() :
  rigidBody(nullptr),
  bodyMass(0),
  audioSource(nullptr),
- state(nullptr)
+ state(nullptr),
+ active(true),
+ bodyColideWithPlayer(true),
+ prefabPool(nullptr)
 {
 }
 
 AnnGameObject::~AnnGameObject()
 {
 	for(auto script : scripts) script->unregisterAsListener();
+	for(auto script : domainScripts) script->unregisterAsListener();
+	for(auto behavior : nativeBehaviors) behavior->unregisterAsListener();
 
 	AnnDebug() << "Destructing game object " << getName() << " !";
+
+	//Give the node, item and audio source to the next object created from the same mesh
+	if(const auto pool = recycler.lock())
+		if(pool->recycle(meshName, sceneNode, model3D, audioSource))
+		{
+			sceneNode   = nullptr;
+			model3D		= nullptr;
+			audioSource = nullptr;
+		}
+
 	//Clean OpenAL de-aloc
-	if(AnnGetAudioEngine())
+	if(audioSource && AnnGetAudioEngine())
 		AnnGetAudioEngine()->removeSource(audioSource);
 
 	if(AnnGetPhysicsEngine())
@@ -221,7 +237,8 @@ void AnnGameObject::setupPhysics(float mass, phyShapeType type, bool colideWithP
 	collisionShape->setLocalScaling(scale.getBtVector());
 
 	//Register the mass
-	bodyMass = mass;
+	bodyMass			 = mass;
+	bodyColideWithPlayer = colideWithPlayer;
 
 	//Calculate inertia
 	btVector3 inertia{ 0, 0, 0 };
@@ -233,10 +250,15 @@ void AnnGameObject::setupPhysics(float mass, phyShapeType type, bool colideWithP
 	rigidBody = new btRigidBody(bodyMass, state, collisionShape, inertia);
 	rigidBody->setUserPointer(this);
 
+	if(active) addBodyToWorld();
+}
+
+void AnnGameObject::addBodyToWorld() const
+{
 	//Add body to the dynamics world while respecting collision masks settings
-	physicsEngine->getWorld()->addRigidBody(rigidBody,
-											AnnPhysicsEngine::CollisionMasks::General,
-											colideWithPlayer ? AnnPhysicsEngine::CollisionMasks::ColideWithAll : AnnPhysicsEngine::CollisionMasks::General);
+	AnnGetPhysicsEngine()->getWorld()->addRigidBody(rigidBody,
+													AnnPhysicsEngine::CollisionMasks::General,
+													bodyColideWithPlayer ? AnnPhysicsEngine::CollisionMasks::ColideWithAll : AnnPhysicsEngine::CollisionMasks::General);
 }
 
 Ogre::SceneNode* AnnGameObject::getNode() const
@@ -333,14 +355,86 @@ std::string AnnGameObject::getName() const
 	return name;
 }
 
+const std::string& AnnGameObject::getMeshName() const
+{
+	return meshName;
+}
+
+AnnGameObjectHandle AnnGameObject::getHandle() const
+{
+	return AnnGameObjectHandle(slot);
+}
+
+void AnnGameObject::setActive(bool state)
+{
+	if(state == active) return;
+	active = state;
+
+	sceneNode->setVisible(active);
+
+	if(rigidBody)
+	{
+		if(active)
+		{
+			//Don't keep the momentum from the previous life of the object
+			rigidBody->setLinearVelocity(btVector3(0, 0, 0));
+			rigidBody->setAngularVelocity(btVector3(0, 0, 0));
+			rigidBody->clearForces();
+			addBodyToWorld();
+			rigidBody->activate();
+		}
+		else
+			AnnGetPhysicsEngine()->removeRigidBody(rigidBody);
+	}
+
+	if(!active && audioSource) audioSource->stop();
+
+	for(auto script : scripts)
+	{
+		script->setEnabled(active);
+		active ? script->registerAsListener() : script->unregisterAsListener();
+	}
+	for(auto script : domainScripts)
+	{
+		script->setEnabled(active);
+		active ? script->registerAsListener() : script->unregisterAsListener();
+	}
+	for(auto behavior : nativeBehaviors)
+	{
+		behavior->setEnabled(active);
+		active ? behavior->registerAsListener() : behavior->unregisterAsListener();
+	}
+}
+
+bool AnnGameObject::isActive() const
+{
+	return active;
+}
+
 void AnnGameObject::attachScript(const std::string& scriptName)
 {
+	if(auto behavior = AnnGetScriptManager()->createNativeBehavior(scriptName, this))
+	{
+		nativeBehaviors.push_back(behavior);
+		behavior->registerAsListener();
+		return;
+	}
+
 	auto script = AnnGetScriptManager()->getBehaviorScript(scriptName, this);
 	if(script->isValid())
 		scripts.push_back(script);
 	script->registerAsListener();
 }
 
+void AnnGameObject::attachScript(const std::string& scriptName, const std::string& domainName)
+{
+	auto script = AnnGetScriptManager()->getBehaviorScript(scriptName, this, domainName);
+	if(!script->isValid()) return;
+
+	domainScripts.push_back(script);
+	script->registerAsListener();
+}
+
 bool AnnGameObject::hasParent() const
 {
 	auto parentSceneNode = sceneNode->getParentSceneNode();
@@ -362,7 +456,7 @@ std::shared_ptr<AnnGameObject> AnnGameObject::getParent() const
 	return AnnGetGameObjectManager()->getFromNode(sceneNode->getParentSceneNode());
 }
 
-void AnnGameObject::attachChildObject(std::shared_ptr<AnnGameObject> child) const
+void AnnGameObject::attachChildObject(const std::shared_ptr<AnnGameObject>& child) const
 {
 	//child->sceneNode has been detached from it's current parent(that was either a node or the root node)
 	child->sceneNode->getParentSceneNode()->removeChild(child->sceneNode);
@@ -0,0 +1,55 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnGameObjectHandle.hpp"
+#include "AnnGameObjectManager.hpp"
+#include "AnnException.hpp"
+
+using namespace Annwvyn;
+
+AnnGameObjectHandle::AnnGameObjectHandle(AnnSlotHandle slot) :
+ slot(slot)
+{
+}
+
+AnnGameObject* AnnGameObjectHandle::get() const
+{
+	return AnnGameObjectManager::resolve(*this);
+}
+
+AnnGameObject* AnnGameObjectHandle::operator->() const
+{
+	const auto object = get();
+	if(!object) throw AnnNullGameObjectError();
+	return object;
+}
+
+bool AnnGameObjectHandle::isValid() const
+{
+	return get() != nullptr;
+}
+
+AnnGameObjectHandle::operator bool() const
+{
+	return isValid();
+}
+
+std::shared_ptr<AnnGameObject> AnnGameObjectHandle::lock() const
+{
+	return AnnGameObjectManager::resolveShared(*this);
+}
+
+AnnSlotHandle AnnGameObjectHandle::getSlot() const
+{
+	return slot;
+}
+
+bool AnnGameObjectHandle::operator==(const AnnGameObjectHandle& other) const
+{
+	return slot == other.slot;
+}
+
+bool AnnGameObjectHandle::operator!=(const AnnGameObjectHandle& other) const
+{
+	return slot != other.slot;
+}
@@ -13,34 +13,54 @@
 
 using namespace Annwvyn;
 
+AnnSlotMap<AnnGameObject>* AnnGameObjectManager::liveObjects{ nullptr };
+
 AnnGameObjectManager::AnnGameObjectManager() :
- AnnSubSystem("GameObjectManager"), halfPos(true), halfTexCoord(true), qTan(true)
+ AnnSubSystem("GameObjectManager"), updatingObjects(false), halfPos(true), halfTexCoord(true), qTan(true), meshCacheConfigured(false)
 {
 	//There will only be one manager, set the id to 0
-	autoID = 0;
+	autoID		= 0;
+	liveObjects = &Objects;
+}
+
+AnnGameObjectManager::~AnnGameObjectManager()
+{
+	if(liveObjects == &Objects) liveObjects = nullptr;
 }
 
 void AnnGameObjectManager::update()
 {
-	//Run animations and update OpenAL sources position
-	for(auto gameObject : Objects)
+	//Run animations and update OpenAL sources position.
+	//Removal moves the last object in the hole. Objects removed by scripts are taken out after the loop, so none is skipped
+	updatingObjects = true;
+	for(size_t i{ 0 }; i < Objects.size(); ++i)
 	{
+		const auto gameObject = Objects[i];
 		gameObject->addAnimationTime(AnnGetEngine()->getFrameTime());
 		gameObject->updateOpenAlPos();
 		gameObject->update();
 		gameObject->callUpdateOnScripts();
 	}
+	updatingObjects = false;
+
+	auto removed = std::move(pendingRemovals);
+	pendingRemovals.clear();
+	for(const auto& object : removed)
+		removeGameObject(object);
+
+	//Native behaviors are stored by type, not by object
+	AnnGetScriptManager()->updateNativeBehaviors();
+
+	//Send the moved instances to the scene, once for the frame
+	for(size_t i{ 0 }; i < InstancedMeshes.size(); ++i)
+		InstancedMeshes[i]->update();
 }
 
-Ogre::MeshPtr AnnGameObjectManager::getAndConvertFromV1Mesh(const char* meshName, Ogre::v1::MeshPtr& v1Mesh, Ogre::MeshPtr& v2Mesh) const
+Ogre::MeshPtr AnnGameObjectManager::getAndConvertFromV1Mesh(const char* meshName, Ogre::v1::MeshPtr& v1Mesh, Ogre::MeshPtr& v2Mesh, Ogre::DataStreamPtr source) const
 {
 	static const std::string sufix = "_V2mesh";
 	const auto meshManager		   = Ogre::MeshManager::getSingletonPtr();
-
-	v1Mesh = Ogre::v1::MeshManager::getSingleton().load(meshName,
-														Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME,
-														Ogre::v1::HardwareBuffer::HBU_STATIC,
-														Ogre::v1::HardwareBuffer::HBU_STATIC);
+	v1Mesh.setNull();
 
 	//Generate the name of the v2 mesh
 	auto v2meshName = meshName + sufix;
@@ -48,39 +68,57 @@ Ogre::MeshPtr AnnGameObjectManager::getAndConvertFromV1Mesh(const char* meshName
 
 	//v2Mesh
 	v2Mesh = meshManager->getByName(v2meshName);
-	if(!v2Mesh) //create and import
-	{
-		AnnDebug() << v2meshName << " doesn't exist yet in the v2 MeshManager, creating it and loading the v1 " << meshName << " geometry";
-		v2Mesh = meshManager->createManual(v2meshName, AnnResourceManager::getDefaultResourceGroupName());
-		v2Mesh->importV1(v1Mesh.get(), halfPos, halfTexCoord, qTan);
-	}
+	if(v2Mesh) return v2Mesh;
+
+	if(const auto cache = getMeshCache())
+		return v2Mesh = cache->load(meshName, v2meshName, AnnResourceManager::getDefaultResourceGroupName(), { halfPos, halfTexCoord, qTan }, source);
+
+	//create and import
+	AnnDebug() << v2meshName << " doesn't exist yet in the v2 MeshManager, creating it and loading the v1 " << meshName << " geometry";
+	auto v1 = AnnMeshCache::loadV1(meshName, source);
+	v2Mesh = meshManager->createManual(v2meshName, AnnResourceManager::getDefaultResourceGroupName());
+	v2Mesh->importV1(v1.get(), halfPos, halfTexCoord, qTan);
 
+	//The v1 geometry is not needed anymore, don't keep it in memory
+	Ogre::v1::MeshManager::getSingleton().remove(v1->getHandle());
 	return v2Mesh;
 }
 
 std::shared_ptr<AnnGameObject> AnnGameObjectManager::createGameObject(const std::string& meshName, std::string identifier, std::shared_ptr<AnnGameObject> obj)
 {
-	AnnDebug("Creating a game object from the mesh file: " + std::string(meshName));
+	ANN_LOG(debug) << "Creating a game object from the mesh file: " << meshName;
 	auto smgr{ AnnGetEngine()->getSceneManager() };
 
-	Ogre::v1::MeshPtr v1Mesh;
-	Ogre::MeshPtr v2Mesh;
-	getAndConvertFromV1Mesh(meshName.c_str(), v1Mesh, v2Mesh);
-	v1Mesh.setNull();
+	Ogre::SceneNode* node{ nullptr };
+	Ogre::Item* item{ nullptr };
+	std::shared_ptr<AnnAudioSource> audioSource{ nullptr };
+
+	//Reuse what an object with the same mesh left, if possible
+	if(!recycler || !recycler->reuse(meshName, node, item, audioSource))
+	{
+		Ogre::v1::MeshPtr v1Mesh;
+		Ogre::MeshPtr v2Mesh;
+		getAndConvertFromV1Mesh(meshName.c_str(), v1Mesh, v2Mesh);
+		v1Mesh.setNull();
 
-	//Create an item
-	auto item = smgr->createItem(v2Mesh);
+		//Create an item
+		item = smgr->createItem(v2Mesh);
 
-	//Create a node
-	auto node = smgr->getRootSceneNode()->createChildSceneNode();
+		//Create a node
+		node = smgr->getRootSceneNode()->createChildSceneNode();
 
-	//Attach
-	node->attachObject(item);
+		//Attach
+		node->attachObject(item);
+
+		audioSource = AnnGetAudioEngine()->createSource();
+	}
 
 	//Set GameObject members
 	obj->setNode(node);
 	obj->setItem(item);
-	obj->audioSource = AnnGetAudioEngine()->createSource();
+	obj->audioSource = audioSource;
+	obj->meshName	= meshName;
+	obj->recycler	= recycler;
 
 	//id will be unique to every non-identified object.
 	//The identifier name can be empty, meaning that we have to figure out an unique name.
@@ -91,44 +129,115 @@ std::shared_ptr<AnnGameObject> AnnGameObjectManager::createGameObject(const std:
 	AnnDebug() << "The object " << identifier << " has been created. Annwvyn memory address " << obj;
 	AnnDebug() << "This object take " << sizeof *obj.get() << " bytes";
 
-	obj->name					  = identifier;
-	identifiedObjects[identifier] = obj;
-	Objects.push_back(obj);
+	obj->name = identifier;
+	track(obj);
 
 	obj->postInit();
 	return obj;
 }
 
-void AnnGameObjectManager::removeGameObject(std::shared_ptr<AnnGameObject> object)
+void AnnGameObjectManager::removeGameObject(const std::shared_ptr<AnnGameObject>& object)
 {
-	AnnDebug() << "Removed object " << object->getName();
-
 	if(!object) throw AnnNullGameObjectError();
 
-	Objects.erase(
-		std::remove(std::begin(Objects), std::end(Objects), object),
-		std::end(Objects));
+	//Removed from a script while the objects are updated
+	if(updatingObjects)
+	{
+		if(std::find(pendingRemovals.begin(), pendingRemovals.end(), object) == pendingRemovals.end())
+			pendingRemovals.push_back(object);
+		return;
+	}
+
+	//Instances of prefabs go back to their pool
+	if(object->prefabPool)
+	{
+		object->prefabPool->despawn(object);
+		return;
+	}
+
+	if(untrack(object)) AnnDebug() << "Removed object " << object->getName();
+}
+
+void AnnGameObjectManager::track(const std::shared_ptr<AnnGameObject>& object)
+{
+	object->slot						 = Objects.insert(object);
+	identifiedObjects[object->getName()] = object->getHandle();
+}
+
+bool AnnGameObjectManager::untrack(const std::shared_ptr<AnnGameObject>& object)
+{
+	//Keep the handle, erasing the object makes it stale
+	const auto handle = object->getHandle();
+	if(!Objects.erase(object->slot)) return false;
+
+	//Another object may have taken the name since
+	const auto identified = identifiedObjects.find(object->getName());
+	if(identified != identifiedObjects.end() && identified->second == handle)
+		identifiedObjects.erase(identified);
+	return true;
+}
+
+void AnnGameObjectManager::registerPrefab(const std::string& name, const AnnPrefab& prefab, size_t preallocate)
+{
+	if(prefabs.find(name) != prefabs.end())
+		throw AnnInitializationError(ANN_ERR_UNKOWN, "Prefab " + name + " is already registered");
+
+	prefabs[name] = std::make_unique<AnnPrefabPool>(name, prefab, preallocate);
+}
+
+std::shared_ptr<AnnGameObject> AnnGameObjectManager::spawn(const std::string& prefabName, AnnVect3 position, AnnQuaternion orientation)
+{
+	const auto pool = getPrefabPool(prefabName);
+	if(!pool) throw AnnInitializationError(ANN_ERR_NOTINIT, "Prefab " + prefabName + " is not registered");
+
+	return pool->spawn(position, orientation);
+}
+
+void AnnGameObjectManager::despawn(const std::shared_ptr<AnnGameObject>& object)
+{
+	removeGameObject(object);
+}
+
+AnnPrefabPool* AnnGameObjectManager::getPrefabPool(const std::string& prefabName) const
+{
+	const auto pool = prefabs.find(prefabName);
+	if(pool == prefabs.end()) return nullptr;
+	return pool->second.get();
+}
+
+void AnnGameObjectManager::removeGameObject(AnnGameObjectHandle handle)
+{
+	if(const auto object = Objects.getShared(handle.getSlot()))
+		removeGameObject(object);
+}
 
-	identifiedObjects.erase(object->getName());
+AnnGameObject* AnnGameObjectManager::resolve(AnnGameObjectHandle handle)
+{
+	if(!liveObjects) return nullptr;
+	return liveObjects->get(handle.getSlot());
+}
+
+std::shared_ptr<AnnGameObject> AnnGameObjectManager::resolveShared(AnnGameObjectHandle handle)
+{
+	if(!liveObjects) return nullptr;
+	return liveObjects->getShared(handle.getSlot());
 }
 
 std::shared_ptr<AnnGameObject> AnnGameObjectManager::getFromNode(Ogre::SceneNode* node)
 {
-	AnnDebug() << "Trying to identify object at address " << static_cast<void*>(node);
+	ANN_LOG(debug) << "Trying to identify object at address " << static_cast<void*>(node);
 
-	const auto result = std::find_if(begin(Objects), end(Objects), [&](std::shared_ptr<AnnGameObject> object) { return object->getNode() == node; });
-	if(result != end(Objects)) return *result;
+	const auto result = std::find_if(Objects.begin(), Objects.end(), [&](std::shared_ptr<AnnGameObject> object) { return object->getNode() == node; });
+	if(result != Objects.end()) return *result;
 
-	AnnDebug() << "The Scene Node" << static_cast<void*>(node) << " doesn't belong to any AnnGameObject";
+	ANN_LOG(debug) << "The Scene Node" << static_cast<void*>(node) << " doesn't belong to any AnnGameObject";
 	return nullptr;
 }
 
 void AnnGameObjectManager::removeLightObject(std::shared_ptr<AnnLightObject> light)
 {
 	if(!light) throw AnnNullGameObjectError();
-	Lights.erase(
-		std::remove(std::begin(Lights), std::end(Lights), light),
-		std::end(Lights));
+	if(!Lights.erase(light->slot)) return;
 
 	identifiedLights.erase(light->getName());
 }
@@ -139,7 +248,7 @@ std::shared_ptr<AnnLightObject> AnnGameObjectManager::createLightObject(std::str
 	if(lightObjectName.empty()) lightObjectName = "light" + std::to_string(nextID());
 	auto Light = std::make_shared<AnnLightObject>(AnnGetEngine()->getSceneManager()->createLight(), lightObjectName);
 	Light->setType(AnnLightObject::LightTypes::ANN_LIGHT_POINT);
-	Lights.push_back(Light);
+	Light->slot = Lights.insert(Light);
 	identifiedLights[lightObjectName] = Light;
 	return Light;
 }
@@ -149,16 +258,47 @@ std::shared_ptr<AnnTriggerObject> AnnGameObjectManager::createTriggerObject(std:
 	AnnDebug("Creating a trigger object");
 	if(triggerObjectName.empty()) triggerObjectName = "trigger" + std::to_string(nextID());
 	auto trigger = std::make_shared<AnnTriggerObject>(triggerObjectName);
-	Triggers.push_back(trigger);
+	trigger->slot = Triggers.insert(trigger);
 	identifiedTriggerObjects[triggerObjectName] = trigger;
 	return trigger;
 }
 
+std::shared_ptr<AnnInstancedMesh> AnnGameObjectManager::createInstancedMesh(const std::string& meshName, std::string identifier, bool isStatic)
+{
+	AnnDebug("Creating an instanced mesh from the mesh file: " + meshName);
+
+	Ogre::v1::MeshPtr v1Mesh;
+	Ogre::MeshPtr v2Mesh;
+	getAndConvertFromV1Mesh(meshName.c_str(), v1Mesh, v2Mesh);
+	v1Mesh.setNull();
+
+	if(identifier.empty()) identifier = meshName + "_instances" + std::to_string(nextID());
+	auto instancedMesh  = std::make_shared<AnnInstancedMesh>(v2Mesh, identifier, isStatic);
+	instancedMesh->slot = InstancedMeshes.insert(instancedMesh);
+	identifiedInstancedMeshes[identifier] = instancedMesh;
+	return instancedMesh;
+}
+
+void AnnGameObjectManager::removeInstancedMesh(const std::shared_ptr<AnnInstancedMesh>& instancedMesh)
+{
+	if(!instancedMesh) throw AnnNullGameObjectError();
+	if(!InstancedMeshes.erase(instancedMesh->slot)) return;
+
+	identifiedInstancedMeshes.erase(instancedMesh->getName());
+}
+
+std::shared_ptr<AnnInstancedMesh> AnnGameObjectManager::getInstancedMesh(const std::string& instancedMeshName) const
+{
+	const auto instancedMesh = identifiedInstancedMeshes.find(instancedMeshName);
+	if(instancedMesh != end(identifiedInstancedMeshes))
+		return instancedMesh->second;
+	return nullptr;
+}
+
 void AnnGameObjectManager::removeTriggerObject(std::shared_ptr<AnnTriggerObject> trigger)
 {
-	Triggers.erase(
-		std::remove(std::begin(Triggers), std::end(Triggers), trigger),
-		std::end(Triggers));
+	if(!trigger) throw AnnNullGameObjectError();
+	if(!Triggers.erase(trigger->slot)) return;
 
 	identifiedTriggerObjects.erase(trigger->getName());
 }
@@ -195,12 +335,17 @@ std::shared_ptr<AnnGameObject> AnnGameObjectManager::playerLookingAt(unsigned sh
 	return getFromNode(result->movable->getParentSceneNode());
 }
 
-std::shared_ptr<AnnGameObject> AnnGameObjectManager::getGameObject(std::string gameObjectName)
+std::shared_ptr<AnnGameObject> AnnGameObjectManager::getGameObject(const std::string& gameObjectName) const
+{
+	return Objects.getShared(getGameObjectHandle(gameObjectName).getSlot());
+}
+
+AnnGameObjectHandle AnnGameObjectManager::getGameObjectHandle(const std::string& gameObjectName) const
 {
 	const auto object = identifiedObjects.find(gameObjectName);
 	if(object != end(identifiedObjects))
 		return object->second;
-	return nullptr;
+	return {};
 }
 
 std::shared_ptr<AnnLightObject> AnnGameObjectManager::getLightObject(std::string lightObjectName)
@@ -226,6 +371,53 @@ void AnnGameObjectManager::setImportParameter(bool halfPosition, bool halfTextur
 	qTan		 = qTangents;
 }
 
+void AnnGameObjectManager::setMeshCacheDirectory(const std::string& directory)
+{
+	meshCacheDirectory  = directory;
+	meshCacheConfigured = true;
+	meshCache.reset();
+}
+
+AnnMeshCache* AnnGameObjectManager::getMeshCache() const
+{
+	//The save directory is only known once the engine is running
+	if(!meshCacheConfigured)
+	{
+		AnnGetFileSystemManager()->createSaveDirectory();
+		meshCacheDirectory  = AnnGetFileSystemManager()->getSaveDirectoryFullPath() + "/MeshCache";
+		meshCacheConfigured = true;
+	}
+
+	if(!meshCache && !meshCacheDirectory.empty())
+		meshCache = std::make_unique<AnnMeshCache>(meshCacheDirectory);
+	return meshCache.get();
+}
+
+void AnnGameObjectManager::setObjectRecycling(bool recycle)
+{
+	if(recycle == getObjectRecycling()) return;
+	if(recycle)
+		recycler = std::make_shared<AnnObjectRecycler>(AnnGetEngine()->getSceneManager());
+	else
+		recycler = nullptr;
+}
+
+bool AnnGameObjectManager::getObjectRecycling() const
+{
+	return recycler != nullptr;
+}
+
+void AnnGameObjectManager::clearRecycledObjects() const
+{
+	if(recycler) recycler->clear();
+}
+
+size_t AnnGameObjectManager::getRecycledObjectCount() const
+{
+	if(recycler) return recycler->size();
+	return 0;
+}
+
 uID AnnGameObjectManager::nextID()
 {
 	return ++autoID;
@@ -0,0 +1,160 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnGlyphAtlas.hpp"
+#include "AnnLogger.hpp"
+
+#include <OgreTextureManager.h>
+#include <OgreHardwarePixelBuffer.h>
+#include <OgreTechnique.h>
+#include <OgrePass.h>
+
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANN_GLYPH_ATLAS_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace Annwvyn;
+
+namespace
+{
+	///Atlases of the fonts already used
+	std::unordered_map<Ogre::Font*, std::unique_ptr<AnnGlyphAtlas>> atlasCache;
+
+	///x / 255, rounded, for x in [0, 65025]
+	inline uint32_t divide255(uint32_t x)
+	{
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+}
+
+AnnGlyphAtlas::AnnGlyphAtlas(Ogre::Font* font) :
+ fontHandle(font->getHandle()),
+ width(0),
+ height(0),
+ glyphs{}
+{
+	using namespace Ogre;
+
+	if(!font->isLoaded())
+		font->load();
+
+	auto fontTexture = TexturePtr(TextureManager::getSingleton().getByName(font->getMaterial()->getTechnique(0)->getPass(0)->getTextureUnitState(0)->getTextureName()));
+	auto fontBuffer  = fontTexture->getBuffer();
+
+	// The font texture buffer was created write only, so we cannot lock it. Copy it once instead
+	std::vector<uint8> textureBuffer(fontBuffer->getSizeInBytes());
+	const PixelBox fontPb(fontBuffer->getWidth(), fontBuffer->getHeight(), fontBuffer->getDepth(), fontBuffer->getFormat(), textureBuffer.data());
+	fontBuffer->blitToMemory(fontPb);
+
+	//Only keep the alpha
+	width	= fontPb.getWidth();
+	height   = fontPb.getHeight();
+	coverage.resize(width * height);
+
+	const auto pixelSize	= PixelUtil::getNumElemBytes(fontPb.format);
+	const auto rowPitchBytes = fontPb.rowPitch * pixelSize;
+	for(size_t y{ 0 }; y < height; ++y)
+		for(size_t x{ 0 }; x < width; ++x)
+		{
+			ColourValue pixel;
+			PixelUtil::unpackColour(&pixel, fontPb.format, &textureBuffer[y * rowPitchBytes + x * pixelSize]);
+			coverage[y * width + x] = uint8_t(pixel.a * 255.f + 0.5f);
+		}
+
+	//Glyph positions, in pixels of the atlas
+	auto ranges = font->getCodePointRangeList();
+	if(ranges.empty()) ranges.push_back({ 33, 166 });
+	for(const auto& range : ranges)
+		for(auto codePoint = range.first; codePoint <= range.second && codePoint < glyphs.size(); ++codePoint)
+		{
+			const auto& rect  = font->getGlyphTexCoords(codePoint);
+			const auto left   = uint32_t(rect.left * fontTexture->getSrcWidth());
+			const auto top	= uint32_t(rect.top * fontTexture->getSrcHeight());
+			const auto right  = std::min(uint32_t(rect.right * fontTexture->getSrcWidth()), uint32_t(width));
+			const auto bottom = std::min(uint32_t(rect.bottom * fontTexture->getSrcHeight()), uint32_t(height));
+			if(right <= left || bottom <= top) continue;
+
+			glyphs[codePoint] = { uint16_t(left), uint16_t(top), uint16_t(right - left), uint16_t(bottom - top) };
+		}
+
+	AnnDebug() << "Glyph atlas of font " << font->getName() << " built : " << width << "x" << height;
+}
+
+const AnnGlyphAtlas& AnnGlyphAtlas::get(Ogre::Font* font)
+{
+	auto& atlas = atlasCache[font];
+	if(!atlas || atlas->fontHandle != font->getHandle()) atlas = std::make_unique<AnnGlyphAtlas>(font);
+	return *atlas;
+}
+
+void AnnGlyphAtlas::clearCache()
+{
+	atlasCache.clear();
+}
+
+void AnnGlyphAtlas::blendRowScalar(uint8_t* destination, const uint8_t* coverage, size_t count, uint32_t color, uint8_t alpha)
+{
+	uint8_t colorBytes[4];
+	memcpy(colorBytes, &color, 4);
+
+	for(size_t i{ 0 }; i < count; ++i)
+	{
+		const auto a	= divide255(uint32_t(coverage[i]) * alpha);
+		const auto invA = 255 - a;
+		for(auto channel{ 0 }; channel < 4; ++channel)
+		{
+			auto& d = destination[i * 4 + channel];
+			d		= uint8_t(divide255(d * invA + colorBytes[channel] * a));
+		}
+	}
+}
+
+void AnnGlyphAtlas::blendRow(uint8_t* destination, const uint8_t* coverage, size_t count, uint32_t color, uint8_t alpha)
+{
+#ifdef ANN_GLYPH_ATLAS_SSE2
+	const auto zero		= _mm_setzero_si128();
+	const auto full		= _mm_set1_epi16(255);
+	const auto half		= _mm_set1_epi16(128);
+	const auto alpha16	= _mm_set1_epi16(alpha);
+	const auto color16  = _mm_unpacklo_epi8(_mm_set1_epi32(int(color)), zero);
+
+	//(x + 128 + ((x + 128) >> 8)) >> 8, on 8 lanes of 16 bits
+	const auto divide = [&](__m128i x) {
+		x = _mm_add_epi16(x, half);
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	};
+
+	//Blend 2 pixels, 4 channels of 16 bits each
+	const auto blend = [&](__m128i d, __m128i a) {
+		const auto invA = _mm_sub_epi16(full, a);
+		return divide(_mm_add_epi16(_mm_mullo_epi16(d, invA), _mm_mullo_epi16(color16, a)));
+	};
+
+	//4 pixels at a time
+	size_t i{ 0 };
+	for(; i + 4 <= count; i += 4)
+	{
+		int32_t coverage4;
+		memcpy(&coverage4, coverage + i, 4);
+
+		//Alpha of each pixel : coverage * alpha / 255, then spread on the 4 channels
+		const auto a	 = divide(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(coverage4), zero), alpha16));
+		const auto a01 = _mm_unpacklo_epi16(a, a);
+		const auto aLo = _mm_unpacklo_epi32(a01, a01);
+		const auto aHi = _mm_unpackhi_epi32(a01, a01);
+
+		const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+		const auto lo	 = blend(_mm_unpacklo_epi8(pixels, zero), aLo);
+		const auto hi	 = blend(_mm_unpackhi_epi8(pixels, zero), aHi);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(lo, hi));
+	}
+
+	blendRowScalar(destination + i * 4, coverage + i, count - i, color, alpha);
+#else
+	blendRowScalar(destination, coverage, count, color, alpha);
+#endif
+}
@@ -0,0 +1,193 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnInputRecorder.hpp"
+#include "AnnLogger.hpp"
+
+#include <cstring>
+
+using namespace Annwvyn;
+
+namespace
+{
+	///The buffer is written to the file when it gets bigger than this
+	constexpr size_t bufferFlushSize{ 64 * 1024 };
+
+	///A record payload must fit in RecordHeader::size
+	constexpr size_t maxPayloadSize{ 0xFFFF };
+
+	void store(float (&destination)[3], const AnnVect3& v)
+	{
+		destination[0] = v.x;
+		destination[1] = v.y;
+		destination[2] = v.z;
+	}
+
+	void store(float (&destination)[4], const AnnQuaternion& q)
+	{
+		destination[0] = q.w;
+		destination[1] = q.x;
+		destination[2] = q.y;
+		destination[3] = q.z;
+	}
+}
+
+AnnInputRecorder::AnnInputRecorder() :
+ describedHands{},
+ frameCount(0)
+{
+}
+
+AnnInputRecorder::~AnnInputRecorder()
+{
+	stop();
+}
+
+bool AnnInputRecorder::start(const std::string& fileName)
+{
+	stop();
+
+	file.open(fileName, std::ios::binary | std::ios::trunc);
+	if(!file.is_open())
+	{
+		AnnDebug(AnnLogLevel::warning) << "Cannot open input recording file " << fileName;
+		return false;
+	}
+
+	frameCount = 0;
+	describedHands.fill(nullptr);
+	pendingInputs.clear();
+	buffer.reserve(bufferFlushSize + 1024);
+
+	AnnInputRecordingFormat::Header header{};
+	memcpy(header.magic, AnnInputRecordingFormat::magic, sizeof header.magic);
+	header.version = AnnInputRecordingFormat::version;
+	file.write(reinterpret_cast<const char*>(&header), sizeof header);
+
+	AnnDebug() << "Recording input to " << fileName;
+	return true;
+}
+
+void AnnInputRecorder::stop()
+{
+	if(!isRecording()) return;
+
+	//Input received after the last frame doesn't belong to any frame
+	pendingInputs.clear();
+	writeBuffer();
+	file.close();
+	AnnDebug() << "Input recording stopped after " << frameCount << " frames";
+}
+
+bool AnnInputRecorder::isRecording() const
+{
+	return file.is_open();
+}
+
+void AnnInputRecorder::input(const AnnInputSample& sample, double time)
+{
+	if(!isRecording()) return;
+
+	AnnInputRecordingFormat::InputRecord record{};
+	record.kind	= sample.kind;
+	record.pressed = sample.pressed ? 1 : 0;
+	record.stick   = sample.stick;
+	record.index   = sample.index;
+	record.text	= sample.text;
+	std::copy(sample.values.begin(), sample.values.end(), record.values);
+	pendingInputs.push_back({ record, time });
+}
+
+void AnnInputRecorder::frame(double delta, double time, const AnnPose& head, const std::array<AnnHandControllerPtr, MAX_CONTROLLER_NUMBER>& hands)
+{
+	if(!isRecording()) return;
+
+	AnnInputRecordingFormat::FrameRecord record{};
+	record.delta = delta;
+	record.frame = frameCount++;
+	record.time	 = time;
+	store(record.headPosition, head.position);
+	store(record.headOrientation, head.orientation);
+	append(AnnInputRecordingFormat::frame, record);
+
+	for(size_t side{ 0 }; side < hands.size(); ++side)
+	{
+		const auto hand = hands[side].get();
+		if(!hand) continue;
+
+		if(describedHands[side] != hand)
+		{
+			describe(*hand);
+			describedHands[side] = hand;
+		}
+		writeHand(*hand);
+	}
+
+	for(auto& input : pendingInputs)
+	{
+		input.record.age = float(time - input.time);
+		append(AnnInputRecordingFormat::input, input.record);
+	}
+	pendingInputs.clear();
+
+	//Only touch the file between frames
+	if(buffer.size() >= bufferFlushSize) writeBuffer();
+}
+
+void AnnInputRecorder::describe(AnnHandController& hand)
+{
+	const auto axisCount = std::min<size_t>(hand.getNbAxes(), 0xFF);
+
+	extra.clear();
+	const auto addString = [&](const std::string& text) {
+		extra.insert(extra.end(), text.begin(), text.end());
+		extra.push_back('\0');
+	};
+	addString(hand.getTypeString());
+	for(size_t i{ 0 }; i < axisCount; ++i) addString(hand.getAxis(i).getName());
+
+	const AnnInputRecordingFormat::HandDescriptionRecord record{ uint8_t(hand.getSide()), uint8_t(axisCount), 0 };
+	append(AnnInputRecordingFormat::handDescription, &record, sizeof record, extra.data(), std::min(extra.size(), maxPayloadSize - sizeof record));
+}
+
+void AnnInputRecorder::writeHand(AnnHandController& hand)
+{
+	AnnInputRecordingFormat::HandRecord record{};
+	record.side		   = uint8_t(hand.getSide());
+	record.tracked	 = hand.isTracked() ? 1 : 0;
+	record.buttonCount = uint8_t(std::min<size_t>(hand.getNbButton(), 0xFF));
+	record.axisCount   = uint8_t(std::min<size_t>(hand.getNbAxes(), 0xFF));
+	store(record.position, hand.getWorldPosition());
+	store(record.orientation, hand.getWorldOrientation());
+	store(record.linearSpeed, hand.getLinearSpeed());
+	store(record.angularSpeed, hand.getAngularSpeed());
+
+	extra.resize(record.axisCount * sizeof(float) + record.buttonCount);
+	for(size_t i{ 0 }; i < record.axisCount; ++i)
+	{
+		const auto value = hand.getAxis(i).getValue();
+		memcpy(&extra[i * sizeof value], &value, sizeof value);
+	}
+	for(size_t i{ 0 }; i < record.buttonCount; ++i)
+		extra[record.axisCount * sizeof(float) + i] = hand.getButtonState(uint8_t(i)) ? 1 : 0;
+
+	append(AnnInputRecordingFormat::hand, &record, sizeof record, extra.data(), extra.size());
+}
+
+void AnnInputRecorder::append(AnnInputRecordingFormat::RecordType type, const void* payload, size_t size, const void* extraPayload, size_t extraSize)
+{
+	const AnnInputRecordingFormat::RecordHeader header{ type, uint16_t(size + extraSize) };
+
+	const auto offset = buffer.size();
+	buffer.resize(offset + sizeof header + size + extraSize);
+	memcpy(&buffer[offset], &header, sizeof header);
+	memcpy(&buffer[offset + sizeof header], payload, size);
+	if(extraSize) memcpy(&buffer[offset + sizeof header + size], extraPayload, extraSize);
+}
+
+void AnnInputRecorder::writeBuffer()
+{
+	file.write(buffer.data(), std::streamsize(buffer.size()));
+	file.flush();
+	buffer.clear();
+}
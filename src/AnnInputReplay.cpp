@@ -0,0 +1,188 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnInputReplay.hpp"
+#include "AnnLogger.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace Annwvyn;
+
+namespace
+{
+	///Read the payload of a record into a struct. Missing bytes, from an older version, are left at zero
+	template <class Record>
+	Record readPayload(const char* payload, size_t size)
+	{
+		Record record{};
+		memcpy(&record, payload, std::min(size, sizeof record));
+		return record;
+	}
+}
+
+AnnInputReplay::AnnInputReplay() :
+ offset(0),
+ version(0),
+ finished(true),
+ frame{}
+{
+}
+
+bool AnnInputReplay::open(const std::string& fileName)
+{
+	std::ifstream input(fileName, std::ios::binary);
+	if(!input)
+	{
+		AnnDebug(AnnLogLevel::warning) << "Cannot open input recording " << fileName;
+		return false;
+	}
+	file.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+
+	AnnInputRecordingFormat::Header header{};
+	if(file.size() < sizeof header
+	   || memcmp(file.data(), AnnInputRecordingFormat::magic, sizeof header.magic) != 0)
+	{
+		AnnDebug(AnnLogLevel::warning) << fileName << " is not an input recording";
+		file.clear();
+		return false;
+	}
+	memcpy(&header, file.data(), sizeof header);
+	if(header.version > AnnInputRecordingFormat::version)
+	{
+		AnnDebug(AnnLogLevel::warning) << fileName << " was recorded by a newer version of the engine";
+		file.clear();
+		return false;
+	}
+
+	offset   = sizeof header;
+	version  = header.version;
+	finished = false;
+	frame	= {};
+	hands.clear();
+	inputs.clear();
+	for(auto& description : handDescriptions) description = {};
+
+	AnnDebug() << "Replaying input from " << fileName;
+	return true;
+}
+
+bool AnnInputReplay::nextFrame()
+{
+	hands.clear();
+	inputs.clear();
+	if(finished) return false;
+
+	auto inFrame{ false };
+	while(offset + sizeof(AnnInputRecordingFormat::RecordHeader) <= file.size())
+	{
+		AnnInputRecordingFormat::RecordHeader recordHeader{};
+		memcpy(&recordHeader, &file[offset], sizeof recordHeader);
+
+		//The engine may have stopped in the middle of a record
+		const auto payloadOffset = offset + sizeof recordHeader;
+		if(payloadOffset + recordHeader.size > file.size()) break;
+
+		//The next frame starts here
+		if(recordHeader.type == AnnInputRecordingFormat::frame && inFrame) return true;
+
+		const auto payload = &file[payloadOffset];
+		const size_t size  = recordHeader.size;
+		offset			   = payloadOffset + size;
+
+		switch(recordHeader.type)
+		{
+			case AnnInputRecordingFormat::frame:
+			{
+				const auto previousTime = frame.time;
+				frame					= readPayload<AnnInputRecordingFormat::FrameRecord>(payload, size);
+				if(version < 2) frame.time = previousTime + frame.delta;
+				inFrame = true;
+				break;
+			}
+
+			case AnnInputRecordingFormat::handDescription:
+			{
+				const auto record = readPayload<AnnInputRecordingFormat::HandDescriptionRecord>(payload, size);
+				if(record.side >= handDescriptions.size() || size < sizeof record) break;
+
+				//Null terminated strings : the type, then the axis names
+				std::vector<std::string> strings;
+				for(auto text = payload + sizeof record; text < payload + size;)
+				{
+					const auto length = strnlen(text, size_t(payload + size - text));
+					strings.emplace_back(text, length);
+					text += length + 1;
+				}
+
+				auto& description = handDescriptions[record.side];
+				description.type  = strings.empty() ? std::string{} : strings.front();
+				description.axisNames.assign(strings.begin() + std::min<size_t>(strings.size(), 1), strings.end());
+				description.axisNames.resize(record.axisCount);
+				break;
+			}
+
+			case AnnInputRecordingFormat::hand:
+			{
+				Hand hand;
+				hand.record			= readPayload<AnnInputRecordingFormat::HandRecord>(payload, size);
+				const auto axesSize = hand.record.axisCount * sizeof(float);
+				if(size < sizeof hand.record + axesSize + hand.record.buttonCount) break;
+
+				hand.axes.resize(hand.record.axisCount);
+				memcpy(hand.axes.data(), payload + sizeof hand.record, axesSize);
+				hand.buttons.assign(payload + sizeof hand.record + axesSize, payload + sizeof hand.record + axesSize + hand.record.buttonCount);
+				hands.push_back(std::move(hand));
+				break;
+			}
+
+			case AnnInputRecordingFormat::input:
+			{
+				const auto record = readPayload<AnnInputRecordingFormat::InputRecord>(payload, size);
+
+				AnnInputSample sample{};
+				sample.kind	= AnnInputSample::Kind(record.kind);
+				sample.pressed = record.pressed != 0;
+				sample.stick   = record.stick;
+				sample.index   = record.index;
+				sample.text	= record.text;
+				std::copy(std::begin(record.values), std::end(record.values), sample.values.begin());
+				inputs.push_back({ sample, record.age });
+				break;
+			}
+
+			default: break; //Written by a newer engine, skip it
+		}
+	}
+
+	//Reached the end of the file
+	offset   = file.size();
+	finished = true;
+	return inFrame;
+}
+
+bool AnnInputReplay::isFinished() const
+{
+	return finished;
+}
+
+const AnnInputRecordingFormat::FrameRecord& AnnInputReplay::getFrame() const
+{
+	return frame;
+}
+
+const std::vector<AnnInputReplay::Hand>& AnnInputReplay::getHands() const
+{
+	return hands;
+}
+
+const AnnInputReplay::HandDescription& AnnInputReplay::getHandDescription(size_t side) const
+{
+	return handDescriptions[std::min(side, handDescriptions.size() - 1)];
+}
+
+const std::vector<AnnInputReplay::Input>& AnnInputReplay::getInputs() const
+{
+	return inputs;
+}
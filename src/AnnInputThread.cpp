@@ -0,0 +1,132 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnInputThread.hpp"
+#include "AnnLogger.hpp"
+
+using namespace Annwvyn;
+
+AnnInputThread::AnnInputThread(OIS::Keyboard* keyboard, OIS::Mouse* mouse, std::vector<OIS::JoyStick*> sticks, double frequency) :
+ keyboard(keyboard),
+ previousKeyListener(keyboard->getEventCallback()),
+ mouse(mouse),
+ sticks(std::move(sticks)),
+ mouseButtons(0),
+ mouseAbs{},
+ period(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / std::max(1.0, frequency)))),
+ droppedCount(0),
+ running(true)
+{
+	//Start from the current state, only the changes are queued
+	const auto& mouseState = mouse->getMouseState();
+	mouseButtons		   = uint32_t(mouseState.buttons);
+	mouseAbs			   = { mouseState.X.abs, mouseState.Y.abs, mouseState.Z.abs };
+	for(auto stick : this->sticks) stickStates.push_back(stick->getJoyStickState());
+
+	keyboard->setEventCallback(this);
+	thread = std::thread(&AnnInputThread::run, this);
+	AnnDebug() << "Input thread capturing at " << getFrequency() << "Hz";
+}
+
+AnnInputThread::~AnnInputThread()
+{
+	running = false;
+	thread.join();
+	keyboard->setEventCallback(previousKeyListener);
+
+	if(droppedCount) AnnDebug(AnnLogLevel::warning) << "Input thread dropped " << droppedCount << " samples";
+}
+
+bool AnnInputThread::pop(AnnInputSample& sample)
+{
+	return samples.pop(sample);
+}
+
+double AnnInputThread::getFrequency() const
+{
+	return 1.0 / std::chrono::duration<double>(period).count();
+}
+
+size_t AnnInputThread::getDroppedCount() const
+{
+	return droppedCount;
+}
+
+bool AnnInputThread::keyPressed(const OIS::KeyEvent& arg)
+{
+	push({ AnnInputSample::key, true, 0, uint32_t(arg.key), arg.text, {}, captureTime });
+	return true;
+}
+
+bool AnnInputThread::keyReleased(const OIS::KeyEvent& arg)
+{
+	push({ AnnInputSample::key, false, 0, uint32_t(arg.key), arg.text, {}, captureTime });
+	return true;
+}
+
+void AnnInputThread::run()
+{
+	auto next = std::chrono::steady_clock::now();
+	while(running)
+	{
+		captureTime = std::chrono::steady_clock::now();
+
+		//Key samples are queued by the callbacks during the capture
+		keyboard->capture();
+		mouse->capture();
+		sampleMouse(captureTime);
+		for(auto stick : sticks) stick->capture();
+		sampleSticks(captureTime);
+
+		//Don't try to catch up after a stall
+		next = std::max(next + period, std::chrono::steady_clock::now());
+		std::this_thread::sleep_until(next);
+	}
+}
+
+void AnnInputThread::sampleMouse(std::chrono::steady_clock::time_point now)
+{
+	const auto& state = mouse->getMouseState();
+	const std::array<int32_t, 3> abs{ state.X.abs, state.Y.abs, state.Z.abs };
+	if(uint32_t(state.buttons) == mouseButtons && abs == mouseAbs && state.X.rel == 0 && state.Y.rel == 0 && state.Z.rel == 0) return;
+
+	mouseButtons = uint32_t(state.buttons);
+	mouseAbs	 = abs;
+	push({ AnnInputSample::mouse, false, 0, mouseButtons, 0, { state.X.rel, state.X.abs, state.Y.rel, state.Y.abs, state.Z.rel, state.Z.abs }, now });
+}
+
+void AnnInputThread::sampleSticks(std::chrono::steady_clock::time_point now)
+{
+	for(size_t s{ 0 }; s < sticks.size(); ++s)
+	{
+		const auto& state = sticks[s]->getJoyStickState();
+		auto& previous	= stickStates[s];
+		const auto stick  = uint16_t(s);
+
+		for(size_t i{ 0 }; i < std::min(state.mButtons.size(), previous.mButtons.size()); ++i)
+			if(state.mButtons[i] != previous.mButtons[i])
+			{
+				previous.mButtons[i] = state.mButtons[i];
+				push({ AnnInputSample::stickButton, bool(state.mButtons[i]), stick, uint32_t(i), 0, {}, now });
+			}
+
+		for(size_t i{ 0 }; i < std::min(state.mAxes.size(), previous.mAxes.size()); ++i)
+			if(state.mAxes[i].abs != previous.mAxes[i].abs || state.mAxes[i].rel != 0)
+			{
+				previous.mAxes[i].abs = state.mAxes[i].abs;
+				push({ AnnInputSample::stickAxis, false, stick, uint32_t(i), 0, { state.mAxes[i].abs, state.mAxes[i].rel }, now });
+			}
+
+		for(size_t i{ 0 }; i < 4; ++i)
+			if(state.mPOV[i].direction != previous.mPOV[i].direction)
+			{
+				previous.mPOV[i].direction = state.mPOV[i].direction;
+				push({ AnnInputSample::stickPov, false, stick, uint32_t(i), 0, { state.mPOV[i].direction }, now });
+			}
+	}
+}
+
+void AnnInputThread::push(const AnnInputSample& sample)
+{
+	if(!samples.push(sample)) ++droppedCount;
+}
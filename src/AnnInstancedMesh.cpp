@@ -0,0 +1,179 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnInstancedMesh.hpp"
+#include "AnnEngine.hpp"
+#include "AnnGetter.hpp"
+#include "AnnLogger.hpp"
+
+#include <OgreItem.h>
+
+using namespace Annwvyn;
+
+AnnInstancedMesh::AnnInstancedMesh(Ogre::MeshPtr mesh, const std::string& name, bool isStatic) :
+ mesh(mesh),
+ name(name),
+ memoryType(isStatic ? Ogre::SCENE_STATIC : Ogre::SCENE_DYNAMIC),
+ sceneManager(AnnGetEngine()->getSceneManager()),
+ dirtyBegin(0),
+ dirtyEnd(0)
+{
+	AnnDebug() << "Instanced mesh " << name << " created from " << mesh->getName();
+}
+
+AnnInstancedMesh::~AnnInstancedMesh()
+{
+	clear();
+}
+
+size_t AnnInstancedMesh::addInstance(const AnnInstanceTransform& transform)
+{
+	const auto index = transforms.size();
+	const auto node  = sceneManager->getRootSceneNode(memoryType)->createChildSceneNode(memoryType);
+	const auto item  = sceneManager->createItem(mesh, memoryType);
+	if(!datablockName.empty()) item->setDatablock(datablockName);
+	node->attachObject(item);
+
+	transforms.push_back(transform);
+	nodes.push_back(node);
+	items.push_back(item);
+
+	apply(index);
+	return index;
+}
+
+void AnnInstancedMesh::removeInstance(size_t index)
+{
+	if(index >= transforms.size()) return;
+
+	//Destroy the instance, and move the last one in the hole
+	nodes[index]->detachAllObjects();
+	sceneManager->destroyItem(items[index]);
+	sceneManager->destroySceneNode(nodes[index]);
+
+	const auto last		 = transforms.size() - 1;
+	const auto lastDirty = last >= dirtyBegin && last < dirtyEnd;
+	if(index != last)
+	{
+		transforms[index] = transforms[last];
+		nodes[index]	  = nodes[last];
+		items[index]	  = items[last];
+	}
+	transforms.pop_back();
+	nodes.pop_back();
+	items.pop_back();
+
+	dirtyEnd   = std::min(dirtyEnd, transforms.size());
+	dirtyBegin = std::min(dirtyBegin, dirtyEnd);
+
+	//The moved instance still needs it's pending update
+	if(lastDirty && index != last) markDirty(index, 1);
+}
+
+void AnnInstancedMesh::clear()
+{
+	for(size_t i{ 0 }; i < nodes.size(); ++i)
+	{
+		nodes[i]->detachAllObjects();
+		sceneManager->destroyItem(items[i]);
+		sceneManager->destroySceneNode(nodes[i]);
+	}
+
+	transforms.clear();
+	nodes.clear();
+	items.clear();
+	dirtyBegin = dirtyEnd = 0;
+}
+
+size_t AnnInstancedMesh::size() const
+{
+	return transforms.size();
+}
+
+const AnnInstanceTransform& AnnInstancedMesh::getTransform(size_t index) const
+{
+	return transforms.at(index);
+}
+
+void AnnInstancedMesh::setTransform(size_t index, const AnnInstanceTransform& transform)
+{
+	transforms.at(index) = transform;
+	markDirty(index, 1);
+}
+
+void AnnInstancedMesh::setTransforms(size_t first, const AnnInstanceTransform* source, size_t count)
+{
+	if(first + count > transforms.size()) throw std::out_of_range("Instance index out of range in " + name);
+
+	std::copy(source, source + count, transforms.begin() + first);
+	markDirty(first, count);
+}
+
+AnnInstanceTransform* AnnInstancedMesh::getTransforms()
+{
+	return transforms.data();
+}
+
+void AnnInstancedMesh::markDirty(size_t first, size_t count)
+{
+	if(count == 0) return;
+	const auto last = std::min(first + count, transforms.size());
+	if(first >= last) return;
+
+	//Grow the range of instances to update
+	if(dirtyBegin == dirtyEnd)
+	{
+		dirtyBegin = first;
+		dirtyEnd   = last;
+		return;
+	}
+
+	dirtyBegin = std::min(dirtyBegin, first);
+	dirtyEnd   = std::max(dirtyEnd, last);
+}
+
+void AnnInstancedMesh::setDatablock(const std::string& datablockName)
+{
+	this->datablockName = datablockName;
+	for(auto item : items)
+		item->setDatablock(datablockName);
+}
+
+void AnnInstancedMesh::setVisible(bool visible) const
+{
+	for(auto node : nodes)
+		node->setVisible(visible);
+}
+
+bool AnnInstancedMesh::isStatic() const
+{
+	return memoryType == Ogre::SCENE_STATIC;
+}
+
+const std::string& AnnInstancedMesh::getName() const
+{
+	return name;
+}
+
+void AnnInstancedMesh::update()
+{
+	if(dirtyBegin == dirtyEnd) return;
+
+	for(auto i = dirtyBegin; i < dirtyEnd; ++i)
+		apply(i);
+
+	dirtyBegin = dirtyEnd = 0;
+}
+
+void AnnInstancedMesh::apply(size_t index) const
+{
+	const auto& transform = transforms[index];
+	const auto node		  = nodes[index];
+	node->setPosition(transform.position);
+	node->setOrientation(transform.orientation);
+	node->setScale(transform.scale);
+
+	//Static nodes are only updated by Ogre when told to
+	if(memoryType == Ogre::SCENE_STATIC)
+		sceneManager->notifyStaticDirty(node);
+}
@@ -14,6 +14,8 @@ namespace Annwvyn
 	//Our little pimpl
 	struct AnnJsonLevel::AnnJson
 	{
+		///JSON code, if the level was constructed from code
+		std::string code;
 		json_t j;
 	};
 
@@ -40,27 +42,10 @@ namespace Annwvyn
 		phyShapeType type;
 	};
 
-	inline phyShapeType stringToShape(const std::string& str)
-	{
-		if(str == "static")
-			return staticShape;
-		if(str == "convex")
-			return convexShape;
-		if(str == "box")
-			return boxShape;
-		if(str == "cylinder")
-			return cylinderShape;
-		if(str == "capsule")
-			return capsuleShape;
-		if(str == "sphere")
-			return sphereShape;
-		return error;
-	}
-
 	void from_json(const json_t& j, phyParam& p)
 	{
 		p.mass			   = j["mass"];
-		p.type			   = stringToShape(j["shape"]);
+		p.type			   = AnnJsonLevel::shapeFromString(j["shape"]);
 		p.colideWithPlayer = j["playerColide"];
 	}
 
@@ -84,17 +69,32 @@ namespace Annwvyn
 		if(!j["scripts"].is_null())
 		{
 			for(auto& jsonScript : j["scripts"])
-				obj->attachScript(jsonScript);
+			{
+				//A script is either it's name, or an object with a "name" and the "domain" to run it into
+				if(jsonScript.is_object())
+					obj->attachScript(jsonScript["name"].get<std::string>(), jsonScript["domain"].get<std::string>());
+				else
+					obj->attachScript(jsonScript);
+			}
 		}
 	}
 
-	AnnLightObject::LightTypes lightTypeFromString(const std::string& s)
+	void from_json(const json_t& j, AnnInstanceTransform& t)
 	{
-		if(s == "directional") return AnnLightObject::ANN_LIGHT_DIRECTIONAL;
-		if(s == "spot") return AnnLightObject::ANN_LIGHT_SPOTLIGHT;
-		if(s == "point") return AnnLightObject::ANN_LIGHT_POINT;
+		t.position = j["position"].get<AnnVect3>();
+		if(j.find("orientation") != std::end(j))
+			t.orientation = j["orientation"].get<AnnQuaternion>();
+		if(j.find("scale") != std::end(j))
+			t.scale = j["scale"].get<AnnVect3>();
+	}
 
-		return AnnLightObject::ANN_LIGHT_ERROR;
+	void from_json(const json_t& j, AnnInstancedMeshPtr& instances)
+	{
+		const auto isStatic = j.find("static") == std::end(j) || j["static"].get<bool>();
+		instances			= AnnGetGameObjectManager()->createInstancedMesh(j["mesh"], j.value("name", std::string{}), isStatic);
+
+		for(const AnnInstanceTransform transform : j["transforms"])
+			instances->addInstance(transform);
 	}
 
 	void from_json(const json_t& j, AnnLightObjectPtr& l)
@@ -102,7 +102,7 @@ namespace Annwvyn
 		auto GameObjectManager = AnnGetGameObjectManager();
 		l					   = GameObjectManager->createLightObject(j["name"]);
 
-		auto type = lightTypeFromString(j["type"]);
+		auto type = AnnJsonLevel::lightTypeFromString(j["type"]);
 		if(type != AnnLightObject::ANN_LIGHT_ERROR)
 			l->setType(type);
 
@@ -142,40 +142,62 @@ using namespace Annwvyn;
 
 AnnJsonLevel::AnnJsonLevel(std::string path, const bool preload) :
  constructLevel(),
- preloadResources(preload)
+ preloadResources(preload),
+ path(std::move(path)),
+ prepared(false),
+ resourcesDeclared(false),
+ createdEntries(0)
 {
-	jsonFile   = std::make_unique<AnnJson>();
-	auto& json = jsonFile->j;
+	jsonFile = std::make_unique<AnnJson>();
 
-	//Read full content of the pointed file
-	const std::string file{
-		[&] {
-			std::ifstream fileStream(path);
-			if(fileStream)
-				return std::string(std::istreambuf_iterator<char>(fileStream),
-								   std::istreambuf_iterator<char>());
-			return std::string{};
-		}()
-	};
-
-	//If it wasn't possible to open the file or anything happened while reading chars
-	if(file.empty())
-		throw AnnInitializationError(ANN_ERR_INFILE, "Could not load content of JSON level file " + path);
-
-	//Load JSON
-	json = json_t::parse(file);
-
-	processJson();
+	//Until the file is parsed
+	name = this->path;
 }
 
 AnnJsonLevel::AnnJsonLevel(bool, std::string jsonCode, const bool preload) :
  constructLevel(),
- preloadResources(preload)
+ preloadResources(preload),
+ prepared(false),
+ resourcesDeclared(false),
+ createdEntries(0)
+{
+	jsonFile	   = std::make_unique<AnnJson>();
+	jsonFile->code = std::move(jsonCode);
+}
+
+void AnnJsonLevel::prepare()
 {
-	jsonFile   = std::make_unique<AnnJson>();
+	if(prepared) return;
 	auto& json = jsonFile->j;
-	json	   = json_t::parse(jsonCode);
-	processJson();
+
+	if(path.empty())
+	{
+		json = json_t::parse(jsonFile->code);
+		jsonFile->code.clear();
+	}
+	else
+	{
+		//Read full content of the pointed file
+		const std::string file{
+			[&] {
+				std::ifstream fileStream(path);
+				if(fileStream)
+					return std::string(std::istreambuf_iterator<char>(fileStream),
+									   std::istreambuf_iterator<char>());
+				return std::string{};
+			}()
+		};
+
+		//If it wasn't possible to open the file or anything happened while reading chars
+		if(file.empty())
+			throw AnnInitializationError(ANN_ERR_INFILE, "Could not load content of JSON level file " + path);
+
+		json = json_t::parse(file);
+	}
+
+	name = json["name"].get<std::string>();
+	AnnDebug() << "name is " << name;
+	prepared = true;
 }
 
 AnnJsonLevel::~AnnJsonLevel()
@@ -184,6 +206,10 @@ AnnJsonLevel::~AnnJsonLevel()
 
 void AnnJsonLevel::load()
 {
+	prepare();
+	declareResources();
+	if(resourcePreload) resourcePreload->wait();
+
 	auto& json = jsonFile->j;
 
 	for(auto& jsonGameObject : json["content"])
@@ -192,6 +218,83 @@ void AnnJsonLevel::load()
 	for(auto& jsonLight : json["lighting"])
 		levelLighting.push_back(jsonLight);
 
+	for(auto& jsonInstances : json["instances"])
+		levelInstances.push_back(jsonInstances);
+
+	placePlayer();
+	createdEntries = json["content"].size() + json["lighting"].size() + json["instances"].size();
+}
+
+bool AnnJsonLevel::loadIncrementally(double budget)
+{
+	//Already done on a worker thread by switchToLevelAsync()
+	prepare();
+
+	//Objects need the resources of the level. The resource manager uploads them a bit every frame
+	declareResources();
+	if(resourcePreload && !resourcePreload->isDone()) return false;
+
+	auto& json	 = jsonFile->j;
+	auto& content  = json["content"];
+	auto& lighting  = json["lighting"];
+	auto& instances = json["instances"];
+
+	return runTimeSliced(budget, [&] {
+		if(createdEntries < content.size())
+			levelContent.push_back(content[createdEntries]);
+		else if(createdEntries < content.size() + lighting.size())
+			levelLighting.push_back(lighting[createdEntries - content.size()]);
+		else if(createdEntries < content.size() + lighting.size() + instances.size())
+			levelInstances.push_back(instances[createdEntries - content.size() - lighting.size()]);
+		else
+		{
+			placePlayer();
+			return true;
+		}
+
+		++createdEntries;
+		return false;
+	});
+}
+
+float AnnJsonLevel::getLoadingProgress() const
+{
+	if(!prepared) return 0;
+	const auto& json = jsonFile->j;
+	const auto total = (json.count("content") ? json.at("content").size() : 0) + (json.count("lighting") ? json.at("lighting").size() : 0)
+		+ (json.count("instances") ? json.at("instances").size() : 0);
+	if(total == 0) return 1;
+	return float(createdEntries) / float(total);
+}
+
+void AnnJsonLevel::unload()
+{
+	AnnLevel::unload();
+	createdEntries = 0;
+}
+
+phyShapeType AnnJsonLevel::shapeFromString(const std::string& shape)
+{
+	if(shape == "static") return staticShape;
+	if(shape == "convex") return convexShape;
+	if(shape == "box") return boxShape;
+	if(shape == "cylinder") return cylinderShape;
+	if(shape == "capsule") return capsuleShape;
+	if(shape == "sphere") return sphereShape;
+	return error;
+}
+
+AnnLightObject::LightTypes AnnJsonLevel::lightTypeFromString(const std::string& type)
+{
+	if(type == "directional") return AnnLightObject::ANN_LIGHT_DIRECTIONAL;
+	if(type == "spot") return AnnLightObject::ANN_LIGHT_SPOTLIGHT;
+	if(type == "point") return AnnLightObject::ANN_LIGHT_POINT;
+	return AnnLightObject::ANN_LIGHT_ERROR;
+}
+
+void AnnJsonLevel::placePlayer()
+{
+	auto& json  = jsonFile->j;
 	auto player = AnnGetPlayer();
 	player->setPosition(json["player"]["startPosition"]);
 	player->setOrientation(json["player"]["startOrientation"].get<AnnQuaternion>());
@@ -204,23 +307,25 @@ void AnnJsonLevel::runLogic()
 {
 }
 
-void AnnJsonLevel::processJson()
+void AnnJsonLevel::declareResources()
 {
-	auto& json = jsonFile->j;
-	AnnDebug() << "got json:\n"
-			   << json;
-	name = json["name"].get<std::string>();
-	AnnDebug() << "name is " << name;
+	if(resourcesDeclared) return;
+	resourcesDeclared = true;
 
+	auto& json = jsonFile->j;
 	if(!json["resources"].is_null())
 		AnnDebug() << "Defined " << json["resources"].size() << " resources";
+	auto resourceManager = AnnGetResourceManager();
+	std::vector<std::string> groups;
 	for(const resLocParam resource : json["resources"])
 	{
 		declareResource(resource);
-		auto resourceManager = AnnGetResourceManager();
-		if(preloadResources && resource.group != resourceManager->getDefaultResourceGroupName())
-		{
-			resourceManager->loadGroup(resource.group);
-		}
+		if(preloadResources && resource.group != resourceManager->getDefaultResourceGroupName()
+		   && std::find(groups.begin(), groups.end(), resource.group) == groups.end())
+			groups.push_back(resource.group);
 	}
+
+	//Read the files of every group in parallel
+	if(!groups.empty())
+		resourcePreload = resourceManager->loadGroupsAsync(groups);
 }
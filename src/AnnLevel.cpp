@@ -5,6 +5,8 @@
 #include "AnnLogger.hpp"
 #include "AnnGetter.hpp"
 
+#include <chrono>
+
 using namespace Annwvyn;
 
 AnnLevel::AnnLevel()
@@ -41,6 +43,11 @@ void AnnLevel::unload()
 		AnnGetGameObjectManager()->removeGameObject(obj);
 	levelContent.clear();
 
+	//Remove instanced props
+	for(auto instances : levelInstances)
+		AnnGetGameObjectManager()->removeInstancedMesh(instances);
+	levelInstances.clear();
+
 	//Remove volumetric event triggers
 	for(auto obj : levelTrigger)
 		AnnGetGameObjectManager()->removeTriggerObject(obj);
@@ -51,11 +58,43 @@ void AnnLevel::unload()
 	AnnGetPlayer()->_hintRoomscaleUpdateTranslationReference();
 }
 
+void AnnLevel::prepare()
+{
+}
+
+bool AnnLevel::loadIncrementally(double)
+{
+	load();
+	return true;
+}
+
+float AnnLevel::getLoadingProgress() const
+{
+	return 0;
+}
+
+bool AnnLevel::runTimeSliced(double budget, const std::function<bool()>& step)
+{
+	using clock			= std::chrono::steady_clock;
+	const auto deadline = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double, std::milli>(budget));
+
+	do
+		if(step()) return true;
+	while(clock::now() < deadline);
+
+	return false;
+}
+
 AnnTriggerObjectList& AnnLevel::getTriggers()
 {
 	return levelTrigger;
 }
 
+AnnInstancedMeshList& AnnLevel::getInstancedMeshes()
+{
+	return levelInstances;
+}
+
 std::shared_ptr<AnnLightObject> AnnLevel::addLightObject(std::string id)
 {
 	auto light(AnnGetGameObjectManager()->createLightObject(id));
@@ -70,6 +109,13 @@ std::shared_ptr<AnnGameObject> AnnLevel::addGameObject(std::string entityName, s
 	return object;
 }
 
+std::shared_ptr<AnnInstancedMesh> AnnLevel::addInstancedMesh(std::string meshName, std::string instancesName, bool isStatic)
+{
+	auto instances(AnnGetGameObjectManager()->createInstancedMesh(meshName, instancesName, isStatic));
+	levelInstances.push_back(instances);
+	return instances;
+}
+
 void AnnLevel::addManualMovableObject(std::shared_ptr<AnnAbstractMovable> movable)
 {
 	levelMovable.push_back(movable);
@@ -5,6 +5,7 @@
 #include "AnnEngine.hpp"
 #include "AnnLogger.hpp"
 #include "AnnGetter.hpp"
+#include "AnnTrace.hpp"
 
 using namespace Annwvyn;
 
@@ -12,13 +13,18 @@ AnnLevelManager::AnnLevelManager() :
  AnnSubSystem("LevelManager"),
  current(nullptr),
  jumpRequested(false),
- jumpTo(0)
+ jumpTo(0),
+ loadingState(LoadingState::idle),
+ loading(nullptr),
+ loadingBudget(2),
+ loadingFrames(0)
 {
 }
 
 AnnLevelManager::~AnnLevelManager()
 {
 	AnnDebug() << "Deleting the Level Manager. Unloading current level and releasing all level pointers";
+	cancelAsyncLoad();
 	unloadCurrentLevel();
 }
 
@@ -37,9 +43,15 @@ void AnnLevelManager::switchToLevel(AnnLevelID levelId)
 	AnnDebug() << "LevelManager jumping to levelId : " << levelId;
 	jumpRequested = false;
 	jumpTo		  = 0;
+	cancelAsyncLoad();
 	unloadCurrentLevel();
 	current = loadedLevels[levelId];
+	AnnTrace::levelPhase(current->name, AnnTraceFormat::loadBegin);
 	current->load();
+	AnnTrace::levelPhase(current->name, AnnTraceFormat::loadEnd);
+
+	//Objects of the previous level that weren't reused are not needed anymore
+	AnnGetGameObjectManager()->clearRecycledObjects();
 }
 
 void AnnLevelManager::switchToLevel(std::shared_ptr<AnnLevel> level)
@@ -52,6 +64,71 @@ void AnnLevelManager::switchToLevel(std::shared_ptr<AnnLevel> level)
 		}
 }
 
+void AnnLevelManager::switchToLevelAsync(AnnLevelID levelId)
+{
+	if(!(levelId < loadedLevels.size())) return;
+
+	AnnDebug() << "LevelManager loading levelId " << levelId << " in the background";
+	cancelAsyncLoad();
+	jumpRequested = false;
+
+	loading		  = loadedLevels[levelId];
+	loadingState  = LoadingState::preparing;
+	loadingFrames = 0;
+	auto level	= loading;
+	AnnTrace::levelPhase(level->name, AnnTraceFormat::prepareBegin);
+	preparation   = std::async(std::launch::async, [level] { level->prepare(); });
+}
+
+void AnnLevelManager::switchToLevelAsync(AnnLevelPtr level)
+{
+	for(AnnLevelID i(0); i < loadedLevels.size(); i++)
+		if(loadedLevels[i] == level)
+		{
+			switchToLevelAsync(i);
+			break;
+		}
+}
+
+bool AnnLevelManager::isLoading() const
+{
+	return loadingState != LoadingState::idle;
+}
+
+float AnnLevelManager::getLoadingProgress() const
+{
+	switch(loadingState)
+	{
+		case LoadingState::preparing: return 0;
+		case LoadingState::instantiating: return 0.5f + 0.5f * loading->getLoadingProgress();
+		default: return 1;
+	}
+}
+
+void AnnLevelManager::setLoadingBudget(double milliseconds)
+{
+	loadingBudget = milliseconds;
+}
+
+double AnnLevelManager::getLoadingBudget() const
+{
+	return loadingBudget;
+}
+
+void AnnLevelManager::cancelAsyncLoad()
+{
+	//prepare() cannot be interrupted, but it doesn't touch the scene
+	if(preparation.valid()) preparation.wait();
+	preparation  = {};
+	loading		 = nullptr;
+	loadingState = LoadingState::idle;
+}
+
+void AnnLevelManager::setReuseObjectsBetweenLevels(bool reuse)
+{
+	AnnGetGameObjectManager()->setObjectRecycling(reuse);
+}
+
 void AnnLevelManager::addLevel(std::shared_ptr<AnnLevel> level)
 {
 	AnnDebug() << "Adding level " << level << " to LevelManager";
@@ -72,12 +149,48 @@ void AnnLevelManager::update()
 {
 	if(jumpRequested)
 		return switchToLevel(jumpTo);
+
+	switch(loadingState)
+	{
+		//The current level keeps running until the new one is prepared
+		case LoadingState::preparing:
+			if(preparation.wait_for(std::chrono::seconds(0)) != std::future_status::ready) break;
+			loadingState = LoadingState::idle;
+			preparation.get(); //Rethrow here what prepare() may have thrown
+			AnnTrace::levelPhase(loading->name, AnnTraceFormat::prepareEnd);
+			unloadCurrentLevel();
+			current		 = loading;
+			loadingState = LoadingState::instantiating;
+			AnnTrace::levelPhase(current->name, AnnTraceFormat::loadBegin);
+			//fallthrough
+
+		//Don't run the logic of a level that isn't complete
+		case LoadingState::instantiating:
+			++loadingFrames;
+			if(!current->loadIncrementally(loadingBudget)) return;
+			AnnDebug() << "LevelManager finished loading level in " << loadingFrames << " frames";
+			AnnTrace::levelPhase(current->name, AnnTraceFormat::loadEnd);
+			AnnGetGameObjectManager()->clearRecycledObjects();
+			loading		 = nullptr;
+			loadingState = LoadingState::idle;
+			break;
+
+		default: break;
+	}
+
 	if(current) current->runLogic();
 }
 
 void AnnLevelManager::unloadCurrentLevel()
 {
-	if(current) current->unload();
+	//The level being instantiated is the current one
+	if(loadingState == LoadingState::instantiating) cancelAsyncLoad();
+	if(current)
+	{
+		AnnTrace::levelPhase(current->name, AnnTraceFormat::unloadBegin);
+		current->unload();
+		AnnTrace::levelPhase(current->name, AnnTraceFormat::unloadEnd);
+	}
 	current = nullptr;
 }
 
@@ -97,13 +210,19 @@ std::shared_ptr<AnnLevel> AnnLevelManager::getLevelByIndex(AnnLevelID id)
 	return loadedLevels[id];
 }
 
-void AnnLevelManager::addToCurrentLevel(std::shared_ptr<AnnGameObject> obj) const
+void AnnLevelManager::addToCurrentLevel(const std::shared_ptr<AnnGameObject>& obj) const
 {
 	if(!current || !obj) return;
 	current->levelContent.push_back(obj);
 }
 
-void AnnLevelManager::removeFromCurrentLevel(std::shared_ptr<AnnGameObject> obj) const
+void AnnLevelManager::addToCurrentLevel(AnnGameObjectHandle obj) const
+{
+	//The level owns it's content
+	addToCurrentLevel(obj.lock());
+}
+
+void AnnLevelManager::removeFromCurrentLevel(const std::shared_ptr<AnnGameObject>& obj) const
 {
 	if(!current || !obj) return;
 	current->levelContent.erase(
@@ -111,6 +230,15 @@ void AnnLevelManager::removeFromCurrentLevel(std::shared_ptr<AnnGameObject> obj)
 		end(current->levelContent));
 }
 
+void AnnLevelManager::removeFromCurrentLevel(AnnGameObjectHandle obj) const
+{
+	if(!current) return;
+	const auto object = obj.get();
+	current->levelContent.erase(
+		remove_if(begin(current->levelContent), end(current->levelContent), [&](const AnnGameObjectPtr& content) { return content.get() == object; }),
+		end(current->levelContent));
+}
+
 std::shared_ptr<AnnLevel> AnnLevelManager::getCurrentLevel() const
 {
 	return current;
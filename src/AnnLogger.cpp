@@ -5,32 +5,311 @@
 //The debug output is opened by the AnnEngine class
 #include "AnnEngine.hpp"
 
+#include <OgreLogManager.h>
+
 using namespace Annwvyn;
 
-AnnDebug::AnnDebug() :
- std::ostream(new AnnDebugBuff())
+AnnLogger* AnnLogger::instance{ nullptr };
+std::atomic<AnnLogLevel> AnnLogger::runtimeLevel{ AnnLogLevel(ANN_LOG_MIN_LEVEL) };
+
+AnnLogger::AnnLogger(const std::string& logFileName) :
+ head(&stub),
+ tail(&stub),
+ pushedCount(0),
+ writtenCount(0),
+ running(true),
+ sleeping(false),
+ ownLogManager(false)
 {
+	stub.next = nullptr;
+
+	//Ogre::Root uses the log manager that already exists. Its log only forwards the messages here, this object writes the file
+	if(!Ogre::LogManager::getSingletonPtr())
+	{
+		OGRE_NEW Ogre::LogManager();
+		Ogre::LogManager::getSingleton().createLog(logFileName, true, false, true);
+		ownLogManager = true;
+		file.open(logFileName);
+		Ogre::LogManager::getSingleton().getDefaultLog()->addListener(this);
+	}
+
+	instance = this;
+	writer   = std::thread(&AnnLogger::writerLoop, this);
 }
 
-AnnDebug::AnnDebug(const std::string& message) :
- std::ostream(new AnnDebugBuff())
+AnnLogger::~AnnLogger()
 {
-	*this << message;
+	if(ownLogManager)
+		Ogre::LogManager::getSingleton().getDefaultLog()->removeListener(this);
+
+	running = false;
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		wakeUp.notify_one();
+	}
+	writer.join();
+	instance = nullptr;
+
+	if(ownLogManager)
+		OGRE_DELETE Ogre::LogManager::getSingletonPtr();
 }
 
-AnnDebug::~AnnDebug()
+void AnnLogger::setLevel(AnnLogLevel level)
+{
+	runtimeLevel = std::max(level, AnnLogLevel(ANN_LOG_MIN_LEVEL));
+}
+
+AnnLogLevel AnnLogger::getLevel()
+{
+	return runtimeLevel;
+}
+
+void AnnLogger::push(std::string message, AnnLogLevel level, bool flag, bool toConsole)
+{
+	auto queued = new Message{ { nullptr }, std::move(message), level, flag, toConsole, std::time(nullptr) };
+
+	if(!instance)
+	{
+		writeToTerminal(*queued);
+		delete queued;
+		return;
+	}
+
+	instance->enqueue(queued);
+}
+
+void AnnLogger::flush()
+{
+	if(!instance) return;
+
+	const auto target = instance->pushedCount.load();
+	while(instance->writtenCount.load() < target)
+	{
+		instance->wakeUp.notify_one();
+		std::this_thread::yield();
+	}
+}
+
+std::vector<std::string> AnnLogger::takeConsoleMessages()
+{
+	std::vector<std::string> messages;
+	if(!instance) return messages;
+
+	std::lock_guard<std::mutex> lock(instance->consoleMutex);
+	messages.swap(instance->consoleMessages);
+	return messages;
+}
+
+size_t AnnLogger::getWrittenCount()
+{
+	if(!instance) return 0;
+	return instance->writtenCount;
+}
+
+void AnnLogger::messageLogged(const Ogre::String& message, Ogre::LogMessageLevel lml, bool maskDebug, const Ogre::String& logName, bool& skipThisMessage)
 {
-	delete rdbuf();
+	AnnLogLevel level;
+	switch(lml)
+	{
+		case Ogre::LML_TRIVIAL: level = AnnLogLevel::debug; break;
+		case Ogre::LML_CRITICAL: level = AnnLogLevel::error; break;
+		default: level = AnnLogLevel::info; break;
+	}
+
+	if(isEnabled(level))
+		push(message, level, false, false);
 }
 
-AnnDebug::AnnDebugBuff::~AnnDebugBuff()
+void AnnLogger::enqueue(Message* message)
+{
+	pushedCount.fetch_add(1, std::memory_order_release);
+	link(message);
+
+	if(sleeping.load(std::memory_order_acquire))
+		wakeUp.notify_one();
+}
+
+//Multiple producers, single consumer intrusive queue, by Dmitry Vyukov
+void AnnLogger::link(Message* message)
+{
+	message->next.store(nullptr, std::memory_order_relaxed);
+	const auto previous = head.exchange(message, std::memory_order_acq_rel);
+	previous->next.store(message, std::memory_order_release);
+}
+
+AnnLogger::Message* AnnLogger::dequeue()
+{
+	auto front = tail;
+	auto next  = front->next.load(std::memory_order_acquire);
+
+	//Skip the stub
+	if(front == &stub)
+	{
+		if(!next) return nullptr;
+		tail  = next;
+		front = next;
+		next  = next->next.load(std::memory_order_acquire);
+	}
+
+	if(next)
+	{
+		tail = next;
+		return front;
+	}
+
+	//A producer is between the exchange and the link, try again later
+	if(front != head.load(std::memory_order_acquire)) return nullptr;
+
+	//Put the stub back behind the last message so it can be taken
+	link(&stub);
+
+	next = front->next.load(std::memory_order_acquire);
+	if(next)
+	{
+		tail = next;
+		return front;
+	}
+
+	return nullptr;
+}
+
+void AnnLogger::writerLoop()
+{
+	for(;;)
+	{
+		while(auto message = dequeue())
+		{
+			write(*message);
+			delete message;
+			writtenCount.fetch_add(1, std::memory_order_release);
+		}
+
+		file.flush();
+		std::cout.flush();
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		if(!running && writtenCount == pushedCount) return;
+
+		//Producers don't take the mutex, the timeout covers a notification sent just before sleeping
+		sleeping = true;
+		wakeUp.wait_for(lock, std::chrono::milliseconds(10), [this] { return !running || writtenCount != pushedCount; });
+		sleeping = false;
+	}
+}
+
+void AnnLogger::write(const Message& message)
+{
+	writeToTerminal(message);
+
+	if(file.is_open())
+	{
+		char time[16];
+		std::strftime(time, sizeof time, "%H:%M:%S: ", std::localtime(&message.time));
+		file << time << (message.flag ? "Annwvyn - " : "") << message.text << '\n';
+	}
+	else
+	{
+		//Someone else owns the Ogre log, forward the engine's messages to it
+		Ogre::LogManager::getSingleton().getDefaultLog()->logMessage(message.flag ? "Annwvyn - " + message.text : message.text);
+	}
+
+	if(message.toConsole)
+	{
+		std::lock_guard<std::mutex> lock(consoleMutex);
+		consoleMessages.push_back(message.text);
+	}
+}
+
+void AnnLogger::writeToTerminal(const Message& message)
+{
+	if(message.flag)
+	{
+		AnnEngine::setConsoleYellow();
+		std::cout << "Annwvyn - " << message.text << '\n';
+	}
+	else
+	{
+		AnnEngine::setConsoleGreen();
+		std::cout << message.text << '\n';
+	}
+
+	AnnEngine::setConsoleGreen();
+}
+
+AnnDebug::AnnDebugBuff::AnnDebugBuff() :
+ level(AnnLogLevel::debug)
 {
-	pubsync();
 }
 
 int AnnDebug::AnnDebugBuff::sync()
 {
-	AnnEngine::writeToLog(str());
+	if(!str().empty())
+		AnnLogger::push(str(), level);
 	str("");
 	return 0;
 }
+
+namespace
+{
+	///Buffers owned by a thread. AnnDebug objects can be destroyed in any order, released buffers go in a free list
+	template <class Buffer>
+	struct BufferPool
+	{
+		std::vector<std::unique_ptr<Buffer>> buffers;
+		std::vector<Buffer*> freeBuffers;
+	};
+
+	///Pool of the calling thread
+	template <class Buffer>
+	BufferPool<Buffer>& getThreadPool()
+	{
+		thread_local BufferPool<Buffer> pool;
+		return pool;
+	}
+}
+
+AnnDebug::AnnDebugBuff* AnnDebug::acquireBuffer(AnnLogLevel level)
+{
+	auto& pool = getThreadPool<AnnDebugBuff>();
+
+	if(pool.freeBuffers.empty())
+	{
+		pool.buffers.push_back(std::make_unique<AnnDebugBuff>());
+		pool.freeBuffers.push_back(pool.buffers.back().get());
+	}
+
+	auto buffer = pool.freeBuffers.back();
+	pool.freeBuffers.pop_back();
+	buffer->level = level;
+	return buffer;
+}
+
+void AnnDebug::releaseBuffer(AnnDebugBuff* buffer)
+{
+	getThreadPool<AnnDebugBuff>().freeBuffers.push_back(buffer);
+}
+
+AnnDebug::AnnDebug(AnnLogLevel level) :
+ std::ostream(AnnLogger::isEnabled(level) ? acquireBuffer(level) : nullptr)
+{
+}
+
+AnnDebug::AnnDebug(const std::string& message) :
+ AnnDebug(AnnLogLevel::debug, message)
+{
+}
+
+AnnDebug::AnnDebug(AnnLogLevel level, const std::string& message) :
+ AnnDebug(level)
+{
+	*this << message;
+}
+
+AnnDebug::~AnnDebug()
+{
+	//A disabled level has no buffer
+	if(!rdbuf()) return;
+
+	rdbuf()->pubsync();
+	releaseBuffer(static_cast<AnnDebugBuff*>(rdbuf()));
+}
@@ -0,0 +1,125 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnMappedFile.hpp"
+#include "AnnException.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace Annwvyn;
+
+#ifdef _WIN32
+
+AnnMappedFile::AnnMappedFile(const std::string& path) :
+ path(path),
+ address(nullptr),
+ length(0),
+ fileHandle(INVALID_HANDLE_VALUE),
+ mappingHandle(nullptr)
+{
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(fileHandle == INVALID_HANDLE_VALUE)
+		throw AnnInitializationError(ANN_ERR_INFILE, "Cannot open " + path);
+
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(fileHandle, &fileSize);
+	length = size_t(fileSize.QuadPart);
+
+	//Windows refuses to map an empty file
+	if(length == 0) return;
+
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(mappingHandle) address = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if(!address)
+	{
+		if(mappingHandle) CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		throw AnnInitializationError(ANN_ERR_INFILE, "Cannot map " + path + " in memory");
+	}
+}
+
+AnnMappedFile::~AnnMappedFile()
+{
+	if(address) UnmapViewOfFile(address);
+	if(mappingHandle) CloseHandle(mappingHandle);
+	if(fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+}
+
+#else
+
+AnnMappedFile::AnnMappedFile(const std::string& path) :
+ path(path),
+ address(nullptr),
+ length(0)
+{
+	const auto descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(descriptor < 0)
+		throw AnnInitializationError(ANN_ERR_INFILE, "Cannot open " + path);
+
+	struct stat fileStatus;
+	if(fstat(descriptor, &fileStatus) != 0)
+	{
+		close(descriptor);
+		throw AnnInitializationError(ANN_ERR_INFILE, "Cannot stat " + path);
+	}
+	length = size_t(fileStatus.st_size);
+
+	//mmap refuses a zero sized mapping
+	if(length > 0)
+	{
+		const auto mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if(mapping == MAP_FAILED)
+		{
+			close(descriptor);
+			throw AnnInitializationError(ANN_ERR_INFILE, "Cannot map " + path + " in memory");
+		}
+		address = static_cast<const char*>(mapping);
+	}
+
+	//The mapping stays valid after the file is closed
+	close(descriptor);
+}
+
+AnnMappedFile::~AnnMappedFile()
+{
+	if(address) munmap(const_cast<char*>(address), length);
+}
+
+#endif
+
+const char* AnnMappedFile::data() const
+{
+	return address;
+}
+
+size_t AnnMappedFile::size() const
+{
+	return length;
+}
+
+const std::string& AnnMappedFile::getPath() const
+{
+	return path;
+}
+
+void AnnMappedFile::prefetch() const
+{
+	if(!address) return;
+
+#ifndef _WIN32
+	madvise(const_cast<char*>(address), length, MADV_WILLNEED);
+#endif
+
+	//Reading one byte per page is enough to make the OS load it
+	const size_t pageSize{ 4096 };
+	volatile char sink{ 0 };
+	for(size_t i{ 0 }; i < length; i += pageSize)
+		sink = sink ^ address[i];
+}
@@ -0,0 +1,163 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnMeshCache.hpp"
+#include "AnnFilesystem.hpp"
+#include "AnnLogger.hpp"
+
+#include <OgreMeshManager.h>
+#include <OgreMeshManager2.h>
+#include <OgreMeshSerializer.h>
+#include <OgreMeshSerializer2.h>
+#include <OgreRoot.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace Annwvyn;
+
+AnnMeshCache::AnnMeshCache(const std::string& directory) :
+ directory(directory),
+ hits(0),
+ misses(0)
+{
+	AnnFilesystemManager::createDirectory(directory);
+	AnnDebug() << "Converted meshes are cached in " << directory;
+}
+
+Ogre::MeshPtr AnnMeshCache::load(const std::string& meshName, const std::string& v2MeshName, const std::string& group, ImportFlags flags, Ogre::DataStreamPtr source)
+{
+	//Hash the source file, then the conversion parameters and the Ogre version that produced the cache
+	auto key{ hashSeed };
+	{
+		const auto file = source.isNull() ? Ogre::ResourceGroupManager::getSingleton().openResource(meshName, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME) : source;
+		file->seek(0);
+		std::vector<char> buffer(file->size());
+		file->read(buffer.data(), buffer.size());
+		key = hash(buffer.data(), buffer.size(), key);
+	}
+	const uint32_t parameters[]{ flags.halfPosition, flags.halfTextureCoords, flags.qTangents, OGRE_VERSION };
+	key = hash(parameters, sizeof parameters, key);
+
+	const auto path = getCachePath(meshName, key);
+	auto v2Mesh		= Ogre::MeshManager::getSingleton().createManual(v2MeshName, group);
+
+	if(readCache(path, v2Mesh.get()))
+	{
+		AnnDebug() << v2MeshName << " read from the mesh cache " << path;
+		++hits;
+		return v2Mesh;
+	}
+
+	AnnDebug() << v2MeshName << " is not in the mesh cache, converting the v1 " << meshName << " geometry";
+	++misses;
+
+	auto v1Mesh = loadV1(meshName, source);
+	v2Mesh->importV1(v1Mesh.get(), flags.halfPosition, flags.halfTextureCoords, flags.qTangents);
+
+	//The v1 geometry is not needed anymore, don't keep it in memory
+	Ogre::v1::MeshManager::getSingleton().remove(v1Mesh->getHandle());
+	v1Mesh.setNull();
+
+	writeCache(path, v2Mesh.get());
+	return v2Mesh;
+}
+
+Ogre::v1::MeshPtr AnnMeshCache::loadV1(const std::string& meshName, Ogre::DataStreamPtr source)
+{
+	auto& meshManager = Ogre::v1::MeshManager::getSingleton();
+	if(source.isNull())
+		return meshManager.load(meshName,
+								Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME,
+								Ogre::v1::HardwareBuffer::HBU_STATIC,
+								Ogre::v1::HardwareBuffer::HBU_STATIC);
+
+	//Same buffers as MeshManager::load() would create, but from the bytes already in memory
+	auto v1Mesh = meshManager.createManual(meshName, Ogre::ResourceGroupManager::getSingleton().findGroupContainingResource(meshName));
+	v1Mesh->setVertexBufferPolicy(Ogre::v1::HardwareBuffer::HBU_STATIC);
+	v1Mesh->setIndexBufferPolicy(Ogre::v1::HardwareBuffer::HBU_STATIC);
+	source->seek(0);
+	Ogre::v1::MeshSerializer().importMesh(source, v1Mesh.get());
+	return v1Mesh;
+}
+
+uint64_t AnnMeshCache::hash(const void* data, size_t size, uint64_t seed)
+{
+	static constexpr uint64_t prime{ 0x100000001b3ull };
+
+	auto value	 = seed;
+	const auto bytes = static_cast<const uint8_t*>(data);
+	for(size_t i{ 0 }; i < size; ++i)
+	{
+		value ^= bytes[i];
+		value *= prime;
+	}
+	return value;
+}
+
+std::string AnnMeshCache::getCachePath(const std::string& meshName, uint64_t key) const
+{
+	//Mesh names can contain a path, keep only characters that are safe in a file name
+	auto fileName = meshName;
+	for(auto& c : fileName)
+		if(c == '/' || c == '\\' || c == ':') c = '_';
+
+	std::ostringstream path;
+	path << directory << "/" << fileName << "." << std::hex << std::setw(16) << std::setfill('0') << key << ".v2mesh";
+	return path.str();
+}
+
+const std::string& AnnMeshCache::getDirectory() const
+{
+	return directory;
+}
+
+size_t AnnMeshCache::getHitCount() const
+{
+	return hits;
+}
+
+size_t AnnMeshCache::getMissCount() const
+{
+	return misses;
+}
+
+bool AnnMeshCache::readCache(const std::string& path, Ogre::Mesh* mesh) const
+{
+	auto file = OGRE_NEW_T(std::ifstream, Ogre::MEMCATEGORY_GENERAL)(path, std::ios::binary);
+	if(!*file)
+	{
+		OGRE_DELETE_T(file, basic_ifstream, Ogre::MEMCATEGORY_GENERAL);
+		return false;
+	}
+
+	Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataStream(path, file, true));
+	try
+	{
+		Ogre::MeshSerializer serializer(Ogre::Root::getSingleton().getRenderSystem()->getVaoManager());
+		serializer.importMesh(stream, mesh);
+		return true;
+	}
+	catch(const Ogre::Exception& e)
+	{
+		//A truncated or outdated file, convert the mesh again
+		AnnDebug() << "Ignoring invalid mesh cache file " << path << " : " << e.getDescription();
+		mesh->unload();
+		return false;
+	}
+}
+
+void AnnMeshCache::writeCache(const std::string& path, const Ogre::Mesh* mesh) const
+{
+	try
+	{
+		Ogre::MeshSerializer serializer(Ogre::Root::getSingleton().getRenderSystem()->getVaoManager());
+		serializer.exportMesh(mesh, path);
+	}
+	catch(const Ogre::Exception& e)
+	{
+		AnnDebug() << "Could not write mesh cache file " << path << " : " << e.getDescription();
+	}
+}
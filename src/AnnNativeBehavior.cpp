@@ -0,0 +1,42 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnNativeBehavior.hpp"
+#include "AnnGetter.hpp"
+
+using namespace Annwvyn;
+
+AnnNativeBehavior::AnnNativeBehavior(AnnGameObject* owner) :
+ constructListener(),
+ owner(owner),
+ poolIndex(0),
+ enabled(true)
+{
+}
+
+AnnNativeBehavior::~AnnNativeBehavior() = default;
+
+AnnGameObject* AnnNativeBehavior::getOwner() const
+{
+	return owner;
+}
+
+void AnnNativeBehavior::registerAsListener()
+{
+	AnnGetEventManager()->addListener(getSharedListener());
+}
+
+void AnnNativeBehavior::unregisterAsListener()
+{
+	AnnGetEventManager()->removeListener(getSharedListener());
+}
+
+void AnnNativeBehavior::setEnabled(bool state)
+{
+	enabled = state;
+}
+
+bool AnnNativeBehavior::isEnabled() const
+{
+	return enabled;
+}
@@ -0,0 +1,100 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnObjectRecycler.hpp"
+#include "AnnAudioEngine.hpp"
+#include "AnnLogger.hpp"
+#include "AnnGetter.hpp"
+
+#include <OgreItem.h>
+#include <OgreSubItem.h>
+
+using namespace Annwvyn;
+
+AnnObjectRecycler::AnnObjectRecycler(Ogre::SceneManager* sceneManager) :
+ sceneManager(sceneManager),
+ count(0),
+ reuseCount(0)
+{
+}
+
+AnnObjectRecycler::~AnnObjectRecycler()
+{
+	clear();
+}
+
+bool AnnObjectRecycler::recycle(const std::string& mesh, Ogre::SceneNode* node, Ogre::Item* item, std::shared_ptr<AnnAudioSource> audioSource)
+{
+	//Only the plain node + item pair created by the game object manager can be reused as is
+	if(!node || !item || node->numChildren() != 0 || node->numAttachedObjects() != 1 || node->getAttachedObject(0) != item)
+		return false;
+
+	if(node->getParent()) node->getParent()->removeChild(node);
+	node->setVisible(false);
+	if(audioSource) audioSource->stop();
+
+	pool[mesh].push_back({ node, item, audioSource });
+	++count;
+	return true;
+}
+
+bool AnnObjectRecycler::reuse(const std::string& mesh, Ogre::SceneNode*& node, Ogre::Item*& item, std::shared_ptr<AnnAudioSource>& audioSource)
+{
+	const auto available = pool.find(mesh);
+	if(available == pool.end() || available->second.empty()) return false;
+
+	auto parts = available->second.back();
+	available->second.pop_back();
+	--count;
+	++reuseCount;
+
+	//Whatever the previous object did to them, make them look freshly created
+	parts.node->setPosition(Ogre::Vector3::ZERO);
+	parts.node->setOrientation(Ogre::Quaternion::IDENTITY);
+	parts.node->setScale(Ogre::Vector3::UNIT_SCALE);
+	parts.node->setVisible(true);
+	sceneManager->getRootSceneNode()->addChild(parts.node);
+
+	const auto& subMeshes = parts.item->getMesh()->getSubMeshes();
+	for(size_t i{ 0 }; i < parts.item->getNumSubItems() && i < subMeshes.size(); ++i)
+		parts.item->getSubItem(i)->setDatablock(subMeshes[i]->mMaterialName);
+
+	node		= parts.node;
+	item		= parts.item;
+	audioSource = parts.audioSource;
+	return true;
+}
+
+void AnnObjectRecycler::clear()
+{
+	if(count > 0 || reuseCount > 0)
+		AnnDebug() << "Object recycler reused " << reuseCount << " objects, destroying " << count << " unused ones";
+
+	for(auto& meshParts : pool)
+		for(auto& parts : meshParts.second)
+			destroy(parts);
+
+	pool.clear();
+	count	   = 0;
+	reuseCount = 0;
+}
+
+size_t AnnObjectRecycler::size() const
+{
+	return count;
+}
+
+size_t AnnObjectRecycler::getReuseCount() const
+{
+	return reuseCount;
+}
+
+void AnnObjectRecycler::destroy(Parts& parts) const
+{
+	if(parts.audioSource && AnnGetAudioEngine())
+		AnnGetAudioEngine()->removeSource(parts.audioSource);
+
+	parts.node->detachAllObjects();
+	sceneManager->destroyItem(parts.item);
+	sceneManager->destroySceneNode(parts.node);
+}
@@ -0,0 +1,94 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnOgreReplayRenderer.hpp"
+
+#include "AnnLogger.hpp"
+#include "AnnException.hpp"
+
+using namespace Annwvyn;
+
+std::string AnnOgreReplayRenderer::replayFile;
+
+AnnOgreReplayRenderer::AnnOgreReplayRenderer(std::string name) :
+ AnnOgreNoVRRenderer(name)
+{
+	rendererName = "OpenGL/Replay";
+	if(!replay.open(replayFile))
+		throw AnnInitializationError(ANN_ERR_INFILE, "Cannot replay input recording \"" + replayFile + "\"");
+}
+
+void AnnOgreReplayRenderer::setReplayFile(const std::string& fileName)
+{
+	replayFile = fileName;
+}
+
+bool AnnOgreReplayRenderer::shouldQuit()
+{
+	return replay.isFinished() || AnnOgreNoVRRenderer::shouldQuit();
+}
+
+void AnnOgreReplayRenderer::getTrackingPoseAndVRTiming()
+{
+	//Keep the renderer's own clock running, but simulate with the recorded frame time. The engine time comes from the recording too
+	calculateTimingFromOgre();
+	if(!replay.nextFrame()) return;
+
+	const auto& frame = replay.getFrame();
+	updateTime		  = frame.delta;
+
+	trackedHeadPose.position	= AnnVect3(frame.headPosition);
+	trackedHeadPose.orientation = AnnQuaternion(frame.headOrientation[0], frame.headOrientation[1], frame.headOrientation[2], frame.headOrientation[3]);
+
+	for(const auto& hand : replay.getHands())
+		updateHandController(hand);
+}
+
+AnnInputReplay* AnnOgreReplayRenderer::getInputReplay()
+{
+	return &replay;
+}
+
+void AnnOgreReplayRenderer::updateHandController(const AnnInputReplay::Hand& hand)
+{
+	if(hand.record.side >= handControllers.size()) return;
+	const auto side = AnnHandController::AnnHandControllerSide(hand.record.side);
+
+	const auto& description = replay.getHandDescription(side);
+	if(!handControllers[side])
+		handControllers[side] = std::make_shared<AnnHandController>(description.type, smgr->getRootSceneNode()->createChildSceneNode(), size_t(side), side);
+
+	auto handController = handControllers[side];
+
+	auto& axesVector = handController->getAxesVector();
+	if(axesVector.size() != hand.axes.size())
+	{
+		axesVector.clear();
+		for(size_t i{ 0 }; i < hand.axes.size(); ++i)
+			axesVector.push_back(AnnHandControllerAxis{ i < description.axisNames.size() ? description.axisNames[i] : "Axis " + std::to_string(i), hand.axes[i] });
+	}
+	for(size_t i{ 0 }; i < hand.axes.size(); ++i)
+		axesVector[i].updateValue(hand.axes[i]);
+
+	//Pressed and released buttons are found by comparing with the previous frame, like the VR renderers do
+	auto& buttons  = handController->getButtonStateVector();
+	auto& pressed  = handController->getPressedButtonsVector();
+	auto& released = handController->getReleasedButtonsVector();
+	pressed.clear();
+	released.clear();
+	buttons.resize(hand.buttons.size(), 0);
+	for(uint8_t i(0); i < hand.buttons.size(); i++)
+	{
+		if(hand.buttons[i] && !buttons[i])
+			pressed.push_back(i);
+		else if(!hand.buttons[i] && buttons[i])
+			released.push_back(i);
+		buttons[i] = hand.buttons[i];
+	}
+
+	if(!hand.record.tracked) return;
+	handController->setTrackedPosition(AnnVect3(hand.record.position));
+	handController->setTrackedOrientation(AnnQuaternion(hand.record.orientation[0], hand.record.orientation[1], hand.record.orientation[2], hand.record.orientation[3]));
+	handController->setTrackedLinearSpeed(AnnVect3(hand.record.linearSpeed));
+	handController->setTrackedAngularSpeed(AnnVect3(hand.record.angularSpeed));
+}
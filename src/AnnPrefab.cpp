@@ -0,0 +1,91 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnPrefab.hpp"
+#include "AnnGameObject.hpp"
+#include "AnnGetter.hpp"
+#include "AnnLogger.hpp"
+
+using namespace Annwvyn;
+
+AnnPrefabPool::AnnPrefabPool(const std::string& name, const AnnPrefab& prefab, size_t preallocate) :
+ name(name),
+ prefab(prefab)
+{
+	AnnDebug() << "Preallocating " << preallocate << " instances of prefab " << name;
+	instances.reserve(preallocate);
+	available.reserve(preallocate);
+	for(size_t i{ 0 }; i < preallocate; ++i)
+		available.push_back(createInstance());
+}
+
+AnnPrefabPool::~AnnPrefabPool()
+{
+	for(auto& instance : instances)
+		instance->prefabPool = nullptr;
+}
+
+std::shared_ptr<AnnGameObject> AnnPrefabPool::createInstance()
+{
+	const auto manager = AnnGetGameObjectManager();
+	auto instance	  = manager->createGameObject(prefab.mesh, name + std::to_string(instances.size()));
+
+	//Scale before creating the body, the collision shape takes the scale of the node
+	instance->setScale(prefab.scale, false);
+	if(prefab.hasPhysics) instance->setupPhysics(prefab.mass, prefab.shape, prefab.colideWithPlayer);
+	for(const auto& script : prefab.scripts)
+		instance->attachScript(script);
+
+	instance->prefabPool = this;
+	instance->setActive(false);
+	manager->untrack(instance);
+
+	instances.push_back(instance);
+	return instance;
+}
+
+std::shared_ptr<AnnGameObject> AnnPrefabPool::spawn(AnnVect3 position, AnnQuaternion orientation)
+{
+	std::shared_ptr<AnnGameObject> instance;
+	if(available.empty())
+	{
+		AnnDebug() << "Prefab pool " << name << " is empty, creating a new instance";
+		instance = createInstance();
+	}
+	else
+	{
+		instance = std::move(available.back());
+		available.pop_back();
+	}
+
+	instance->setPosition(position);
+	instance->setOrientation(orientation);
+	instance->setActive(true);
+	AnnGetGameObjectManager()->track(instance);
+	return instance;
+}
+
+bool AnnPrefabPool::despawn(const std::shared_ptr<AnnGameObject>& instance)
+{
+	if(!instance || instance->prefabPool != this || !instance->isActive()) return false;
+
+	instance->setActive(false);
+	AnnGetGameObjectManager()->untrack(instance);
+	available.push_back(instance);
+	return true;
+}
+
+size_t AnnPrefabPool::getActiveCount() const
+{
+	return instances.size() - available.size();
+}
+
+size_t AnnPrefabPool::getAvailableCount() const
+{
+	return available.size();
+}
+
+const std::string& AnnPrefabPool::getName() const
+{
+	return name;
+}
@@ -12,6 +12,7 @@ AnnResourceManager::AnnResourceManager() :
 {
 	ResourceGroupManager->createResourceGroup(getDefaultResourceGroupName());
 	addDefaultResourceLocation();
+	preloader = std::make_unique<AnnResourcePreloader>();
 }
 
 void AnnResourceManager::addZipLocation(const std::string& path, const std::string& resourceGroupName) const
@@ -78,6 +79,31 @@ void AnnResourceManager::loadGroup(const std::string& groupName) const
 		ResourceGroupManager->loadResourceGroup(groupName);
 }
 
+AnnResourcePreloadPtr AnnResourceManager::loadGroupAsync(const std::string& groupName)
+{
+	return loadGroupsAsync({ groupName });
+}
+
+AnnResourcePreloadPtr AnnResourceManager::loadGroupsAsync(const std::vector<std::string>& groupNames)
+{
+	return preloader->load(groupNames);
+}
+
+void AnnResourceManager::setUploadBudget(double milliseconds) const
+{
+	preloader->setUploadBudget(milliseconds);
+}
+
+void AnnResourceManager::update()
+{
+	preloader->upload(preloader->getUploadBudget());
+}
+
+bool AnnResourceManager::needUpdate()
+{
+	return preloader->hasWork();
+}
+
 const char* AnnResourceManager::getDefaultResourceGroupName()
 {
 	return "b";
@@ -0,0 +1,319 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnResourcePreloader.hpp"
+#include "AnnGetter.hpp"
+#include "AnnLogger.hpp"
+#include "AnnTrace.hpp"
+
+#include <OgreCodec.h>
+#include <OgreResourceGroupManager.h>
+#include <OgreStringConverter.h>
+#include <OgreTextureManager.h>
+
+#include <algorithm>
+#include <chrono>
+
+using namespace Annwvyn;
+
+AnnResourcePreload::AnnResourcePreload(AnnResourcePreloader* preloader, std::vector<std::string> groups) :
+ preloader(preloader),
+ groups(std::move(groups)),
+ resourceCount(0),
+ readCount(0),
+ uploadedCount(0),
+ failedCount(0),
+ done(false)
+{
+}
+
+float AnnResourcePreload::getProgress() const
+{
+	if(done) return 1;
+	if(resourceCount == 0) return 0;
+	return 0.5f * float(readCount + uploadedCount + failedCount) / float(resourceCount);
+}
+
+bool AnnResourcePreload::isDone() const
+{
+	return done;
+}
+
+size_t AnnResourcePreload::getResourceCount() const
+{
+	return resourceCount;
+}
+
+size_t AnnResourcePreload::getUploadedCount() const
+{
+	return uploadedCount;
+}
+
+size_t AnnResourcePreload::getFailedCount() const
+{
+	return failedCount;
+}
+
+const std::vector<std::string>& AnnResourcePreload::getGroups() const
+{
+	return groups;
+}
+
+void AnnResourcePreload::wait()
+{
+	while(!done)
+	{
+		if(preloader->hasWork())
+			preloader->upload(preloader->getUploadBudget());
+		else
+			std::this_thread::yield();
+	}
+}
+
+AnnResourcePreloader::AnnResourcePreloader(size_t workerCount) :
+ running(true),
+ uploadBudget(4)
+{
+	if(workerCount == 0)
+		workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+	workerCount = std::max<size_t>(1, workerCount);
+
+	AnnDebug() << "Starting " << workerCount << " resource loading threads";
+	for(size_t i{ 0 }; i < workerCount; ++i)
+		workers.emplace_back(&AnnResourcePreloader::workerLoop, this);
+}
+
+AnnResourcePreloader::~AnnResourcePreloader()
+{
+	{
+		std::lock_guard<std::mutex> lock(readMutex);
+		running = false;
+		readQueue.clear();
+	}
+	readCondition.notify_all();
+
+	for(auto& worker : workers)
+		worker.join();
+}
+
+AnnResourcePreloadPtr AnnResourcePreloader::load(const std::vector<std::string>& groups)
+{
+	auto resourceGroupManager = Ogre::ResourceGroupManager::getSingletonPtr();
+	auto preload			  = std::make_shared<AnnResourcePreload>(this, groups);
+
+	std::vector<std::unique_ptr<Job>> jobs;
+	for(const auto& group : groups)
+	{
+		if(resourceGroupManager->isResourceGroupLoaded(group)) continue;
+
+		//Parse the scripts of the group (materials, HLMS datablocks...) now, meshes refer to them
+		if(!resourceGroupManager->isResourceGroupInitialised(group))
+			resourceGroupManager->initialiseResourceGroup(group);
+
+		const auto files = resourceGroupManager->findResourceFileInfo(group, "*");
+		for(const auto& file : *files)
+		{
+			ResourceKind kind;
+			if(!getResourceKind(file.filename, kind)) continue;
+
+			auto job	 = std::make_unique<Job>();
+			job->preload = preload;
+			job->name	= file.filename;
+			job->group   = group;
+			job->archive = file.archive;
+			job->kind	= kind;
+
+			//Files on the file system can be read concurrently, files inside an archive share it's state
+			job->archiveMutex = file.archive->getType() == "FileSystem" ? nullptr : &archiveMutexes[file.archive];
+			jobs.push_back(std::move(job));
+		}
+	}
+
+	preload->resourceCount = jobs.size();
+	AnnDebug() << "Preloading " << jobs.size() << " resources in the background";
+
+	if(jobs.empty())
+	{
+		finish(*preload);
+		return preload;
+	}
+
+	inProgress.push_back(preload);
+	{
+		std::lock_guard<std::mutex> lock(readMutex);
+		for(auto& job : jobs)
+			readQueue.push_back(std::move(job));
+	}
+	readCondition.notify_all();
+
+	return preload;
+}
+
+void AnnResourcePreloader::upload(double budget)
+{
+	const auto start = std::chrono::high_resolution_clock::now();
+	const std::chrono::duration<double, std::milli> limit(budget);
+
+	do
+	{
+		std::unique_ptr<Job> job;
+		{
+			std::lock_guard<std::mutex> lock(uploadMutex);
+			if(uploadQueue.empty()) break;
+			job = std::move(uploadQueue.front());
+			uploadQueue.pop_front();
+		}
+
+		auto& preload = *job->preload;
+		if(!job->failed && uploadResource(*job))
+			++preload.uploadedCount;
+		else
+			++preload.failedCount;
+	} while(std::chrono::high_resolution_clock::now() - start < limit);
+
+	//Finish the loads that have everything uploaded
+	for(auto& preload : inProgress)
+		if(preload->uploadedCount + preload->failedCount == preload->resourceCount)
+			finish(*preload);
+
+	inProgress.erase(std::remove_if(inProgress.begin(), inProgress.end(), [](const AnnResourcePreloadPtr& preload) { return preload->done; }),
+					 inProgress.end());
+}
+
+bool AnnResourcePreloader::hasWork() const
+{
+	return !inProgress.empty();
+}
+
+void AnnResourcePreloader::setUploadBudget(double milliseconds)
+{
+	uploadBudget = milliseconds;
+}
+
+double AnnResourcePreloader::getUploadBudget() const
+{
+	return uploadBudget;
+}
+
+size_t AnnResourcePreloader::getWorkerCount() const
+{
+	return workers.size();
+}
+
+bool AnnResourcePreloader::getResourceKind(const std::string& fileName, ResourceKind& kind)
+{
+	const auto dot = fileName.find_last_of('.');
+	if(dot == std::string::npos) return false;
+	auto extension = fileName.substr(dot + 1);
+	Ogre::StringUtil::toLowerCase(extension);
+
+	if(extension == "mesh")
+		kind = ResourceKind::mesh;
+	else if(extension == "wav" || extension == "ogg" || extension == "flac")
+		kind = ResourceKind::sound;
+	else if(Ogre::Codec::isCodecRegistered(extension) && Ogre::Codec::getCodec(extension)->getDataType() == "ImageData")
+		kind = ResourceKind::texture;
+	else
+		return false;
+
+	return true;
+}
+
+void AnnResourcePreloader::workerLoop()
+{
+	for(;;)
+	{
+		std::unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(readMutex);
+			readCondition.wait(lock, [this] { return !running || !readQueue.empty(); });
+			if(!running) return;
+			job = std::move(readQueue.front());
+			readQueue.pop_front();
+		}
+
+		read(*job);
+		++job->preload->readCount;
+
+		std::lock_guard<std::mutex> lock(uploadMutex);
+		uploadQueue.push_back(std::move(job));
+	}
+}
+
+void AnnResourcePreloader::read(Job& job)
+{
+	try
+	{
+		{
+			std::unique_lock<std::mutex> lock;
+			if(job.archiveMutex) lock = std::unique_lock<std::mutex>(*job.archiveMutex);
+
+			auto stream = job.archive->open(job.name, true);
+			job.data	= Ogre::DataStreamPtr(OGRE_NEW Ogre::MemoryDataStream(job.name, stream));
+		}
+
+		//Decoding doesn't need the archive
+		if(job.kind == ResourceKind::texture)
+		{
+			const auto extension = job.name.substr(job.name.find_last_of('.') + 1);
+			job.image.load(job.data, extension);
+			job.data.setNull();
+		}
+	}
+	catch(const Ogre::Exception& e)
+	{
+		//Ogre will try again, and report it, when the group is loaded
+		job.failed = true;
+		job.data.setNull();
+		AnnDebug() << "Could not preload " << job.name << " : " << e.getDescription();
+	}
+}
+
+bool AnnResourcePreloader::uploadResource(Job& job)
+{
+	try
+	{
+		const auto start = AnnTrace::now();
+		switch(job.kind)
+		{
+			case ResourceKind::texture:
+				if(!Ogre::TextureManager::getSingleton().resourceExists(job.name))
+					Ogre::TextureManager::getSingleton().loadImage(job.name, job.group, job.image);
+				break;
+			case ResourceKind::mesh:
+			{
+				Ogre::v1::MeshPtr v1Mesh;
+				Ogre::MeshPtr v2Mesh;
+				AnnGetGameObjectManager()->getAndConvertFromV1Mesh(job.name.c_str(), v1Mesh, v2Mesh, job.data);
+				break;
+			}
+			case ResourceKind::sound:
+				AnnGetAudioEngine()->preLoadBuffer(job.name, job.group, job.data);
+				break;
+		}
+
+		if(AnnTrace::isRecording())
+		{
+			//Textures were decoded by the workers, count what was uploaded
+			const auto bytes = job.kind == ResourceKind::texture ? job.image.getSize() : job.data.isNull() ? 0 : job.data->size();
+			AnnTrace::resourceLoad(job.name, job.group, uint32_t(job.kind), bytes, start, AnnTrace::now());
+		}
+		return true;
+	}
+	catch(const Ogre::Exception& e)
+	{
+		AnnDebug() << "Could not upload " << job.name << " : " << e.getDescription();
+		return false;
+	}
+}
+
+void AnnResourcePreloader::finish(AnnResourcePreload& preload)
+{
+	auto resourceGroupManager = Ogre::ResourceGroupManager::getSingletonPtr();
+	for(const auto& group : preload.groups)
+		if(!resourceGroupManager->isResourceGroupLoaded(group))
+			resourceGroupManager->loadResourceGroup(group);
+
+	AnnDebug() << "Preloaded " << preload.uploadedCount << " resources, " << preload.failedCount << " failed";
+	preload.done = true;
+}
@@ -0,0 +1,466 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnScriptManager.hpp"
+#include "AnnLogger.hpp"
+#include "AnnGameObject.hpp"
+#include "AnnTrace.hpp"
+
+using namespace Annwvyn;
+
+namespace
+{
+	///Command buffer of the concurrent domain updating on this thread, if any
+	thread_local AnnScriptCommandBuffer* recordingCommandBuffer{ nullptr };
+}
+
+constexpr const char* const AnnScriptDomain::fileErrorPrefix;
+constexpr const char* const AnnScriptDomain::scriptRevisionMarker;
+
+std::atomic<AnnScriptDomain::AnnScriptID> AnnScriptDomain::ID{ 0 };
+
+void AnnScriptCommandBuffer::push(std::function<void()> command)
+{
+	commands.push_back(std::move(command));
+}
+
+void AnnScriptCommandBuffer::apply()
+{
+	for(auto& command : commands) command();
+	commands.clear();
+}
+
+AnnScriptDomain::AnnScriptDomain(const std::string& domainName, bool concurrent) :
+ name{ domainName },
+ updateRequested{ false },
+ stopRequested{ false }
+{
+	if(concurrent)
+		worker = std::thread(&AnnScriptDomain::workerLoop, this);
+}
+
+AnnScriptDomain::~AnnScriptDomain()
+{
+	if(!worker.joinable()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		stopRequested = true;
+	}
+	workerCondition.notify_all();
+	worker.join();
+}
+
+std::string AnnScriptDomain::getName() const
+{
+	return name;
+}
+
+bool AnnScriptDomain::isConcurrent() const
+{
+	return worker.joinable();
+}
+
+chaiscript::ChaiScript* AnnScriptDomain::_getEngine()
+{
+	return &chai;
+}
+
+void AnnScriptDomain::evalString(const std::string& chaiCode)
+{
+	chai.eval(chaiCode);
+}
+
+bool AnnScriptDomain::evalFile(const std::string& file)
+{
+	try
+	{
+		chai.eval_file(file);
+	}
+	catch(const chaiscript::exception::file_not_found_error& fnfe)
+	{
+		AnnDebug() << fileErrorPrefix << fnfe.what();
+		return false;
+	}
+	catch(const chaiscript::exception::eval_error& ee)
+	{
+		AnnDebug() << fileErrorPrefix << ee.pretty_print();
+		AnnTrace::scriptError(file, ee.what());
+		return false;
+	}
+	return true;
+}
+
+void AnnScriptDomain::tryAndGetEventHooks()
+{
+	//Forgive me.
+	try
+	{
+		callKeyEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnKeyEvent)>>("KeyEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callKeyEventOnScriptInstance = nullptr;
+	}
+
+	//Yes. I'm doing this.
+	try
+	{
+		callMouseEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnMouseEvent)>>("MouseEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callMouseEventOnScriptInstance = nullptr;
+	}
+
+	//Yes, there's 6 of them
+	try
+	{
+		callStickEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnControllerEvent)>>("ControllerEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callStickEventOnScriptInstance = nullptr;
+	}
+
+	//And yes, it's probable that something will be thrown, unless a script already have this function
+	try
+	{
+		callTimeEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnTimeEvent)>>("TimeEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callTimeEventOnScriptInstance = nullptr;
+	}
+
+	//And it's also possible than the result is not usable with this script and will throw later at eval time
+	try
+	{
+		callTriggerEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnTriggerEvent)>>("TriggerEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callTriggerEventOnScriptInstance = nullptr;
+	}
+
+	//Like I said. Please forgive me.
+	try
+	{
+		callHandControllertOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnHandControllerEvent)>>("HandControllerEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callHandControllertOnScriptInstance = nullptr;
+	}
+	try
+	{
+		callCollisionEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnCollisionEvent)>>("CollisionEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callCollisionEventOnScriptInstance = nullptr;
+	}
+	try
+	{
+		callPlayerCollisionEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnPlayerCollisionEvent)>>("PlayerCollisionEvent");
+	}
+	catch(const chaiscript::exception::eval_error&)
+	{
+		callPlayerCollisionEventOnScriptInstance = nullptr;
+	}
+}
+
+AnnBehaviorScriptHooks AnnScriptDomain::getEventHooks() const
+{
+	return AnnBehaviorScriptHooks{
+		callKeyEventOnScriptInstance,
+		callMouseEventOnScriptInstance,
+		callStickEventOnScriptInstance,
+		callTimeEventOnScriptInstance,
+		callTriggerEventOnScriptInstance,
+		callHandControllertOnScriptInstance,
+		callCollisionEventOnScriptInstance,
+		callPlayerCollisionEventOnScriptInstance
+	};
+}
+
+chaiscript::Boxed_Value AnnScriptDomain::createScriptInstance(const std::string& className, const std::string& ownerTag)
+{
+	//Increment ID
+	const auto scriptID = std::to_string(++ID);
+
+	//This may looks odd but it's good enough for what we're doing:
+	//Copy the template of the init code to a string
+	std::string ChaiCode{ scriptTemplate };
+
+	//To "boot" the script, there's a little sniped of ChaiScript that is run from the C++ side. This code is generated from a string,
+	//And contains a few fixed tags to be replaced with the script name and an unique ID
+	ChaiCode.replace(ChaiCode.find(std::string(scriptNameMarker)), nameMarkerLen, className);
+	ChaiCode.replace(ChaiCode.find(std::string(scriptNameMarker)), nameMarkerLen, className);
+	ChaiCode.replace(ChaiCode.find(std::string(scriptObjectID)), scriptIDMarkerLen, scriptID);
+	ChaiCode.replace(ChaiCode.find(std::string(scriptObjectID)), scriptIDMarkerLen, scriptID);
+	ChaiCode.replace(ChaiCode.find(std::string(scriptObjectID)), scriptIDMarkerLen, scriptID);
+
+	//This will add a global function in ChaiScript, that will create and return the script instance
+	chai.eval(ChaiCode);
+	//Get a way to call this function
+	auto creatorFunction = chai.eval<std::function<chaiscript::Boxed_Value(std::string)>>("create" + className + scriptID);
+
+	//This return the ScriptInstance, as a Boxed_Value. We're only interested at calling something on
+	//this object, so don't need to try to unbox it. It's literally a black box for us
+	return creatorFunction(ownerTag);
+}
+
+bool AnnScriptDomain::hasLoaded(const std::string& scriptName) const
+{
+	return loadedScripts.count(scriptName) != 0;
+}
+
+std::shared_ptr<AnnBehaviorScript> AnnScriptDomain::getBehaviorScript(const AnnScriptFilePtr& scriptFile, const std::string& scriptName, AnnGameObject* owner)
+{
+	//Evaluate the file containing the script class if unknown to this interpreter yet
+	if(loadedScripts.insert(scriptName).second)
+	{
+		AnnDebug() << "now loading " << scriptFile->getName() << " into the script domain " << name;
+		chai.eval(scriptFile->getSourceCode());
+	}
+
+	//A script that has been hot-reloaded is defined by a class with a different name
+	const auto reloadedClass = scriptClassNames.find(scriptName);
+	const auto& className	= reloadedClass != scriptClassNames.end() ? reloadedClass->second : scriptName;
+
+	//Get the name of the owner of this script, if relevant;
+	std::string ownerTag = owner ? owner->getName() : "";
+
+	//This is the ugly bit, this will try to see if the methods functions have been declared somewhere. Note that this doesn't tell if a script has a specific method implemented.
+	//It just permit to know if "a function" with that name exist. Script themselve will deal with knowing if they own theses functions, by attempting to call them, and setting flags
+	//if exception occurs.
+	tryAndGetEventHooks();
+
+	//Now we need to get some hook to call the update on the file
+	auto script = std::make_shared<AnnBehaviorScript>(
+		scriptName,
+		//Function to call to update the script. Update is mandatory
+		chai.eval<std::function<void(chaiscript::Boxed_Value&)>>("update"),
+		//Eventual event hooks
+		getEventHooks(),
+		createScriptInstance(className, ownerTag));
+
+	//Keep track of the script to be able to update it, and to migrate it if the file is reloaded
+	auto& instances = liveScripts[scriptName];
+	instances.erase(std::remove_if(instances.begin(), instances.end(), [](const AnnLiveBehaviorScript& instance) { return instance.script.expired(); }), instances.end());
+	instances.push_back({ script, ownerTag });
+
+	return script;
+}
+
+std::string AnnScriptDomain::renameScriptClass(const std::string& source, const std::string& from, const std::string& to)
+{
+	const auto isIdentifierCharacter = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+	std::string output;
+	output.reserve(source.size());
+
+	for(size_t i{ 0 }; i < source.size();)
+	{
+		//Copy string literals as-is
+		if(source[i] == '"')
+		{
+			auto end = i + 1;
+			while(end < source.size() && source[end] != '"')
+				end += source[end] == '\\' ? 2 : 1;
+			end = std::min(end + 1, source.size());
+			output.append(source, i, end - i);
+			i = end;
+			continue;
+		}
+
+		//Copy identifiers, replacing the ones that match the class name
+		if(isIdentifierCharacter(source[i]))
+		{
+			auto end = i;
+			while(end < source.size() && isIdentifierCharacter(source[end])) ++end;
+			if(source.compare(i, end - i, from) == 0)
+				output.append(to);
+			else
+				output.append(source, i, end - i);
+			i = end;
+			continue;
+		}
+
+		output.push_back(source[i++]);
+	}
+
+	return output;
+}
+
+void AnnScriptDomain::migrateScriptState(const chaiscript::Boxed_Value& from, chaiscript::Boxed_Value& to)
+{
+	try
+	{
+		const auto& oldObject = chaiscript::boxed_cast<const chaiscript::dispatch::Dynamic_Object&>(from);
+		auto& newObject		  = chaiscript::boxed_cast<chaiscript::dispatch::Dynamic_Object&>(to);
+
+		for(const auto& attribute : oldObject.get_attrs())
+			newObject.get_attr(attribute.first) = attribute.second;
+	}
+	catch(const chaiscript::exception::bad_boxed_cast&)
+	{
+		AnnDebug() << "Cannot migrate the state of a script instance that is not a ChaiScript object";
+	}
+}
+
+bool AnnScriptDomain::reloadScript(const std::string& scriptName, const std::string& sourceCode)
+{
+	//ChaiScript refuses to redefine the methods of an existing class. The new code is evaluated under a new class name instead
+	const auto className = scriptName + scriptRevisionMarker + std::to_string(scriptRevisions[scriptName] + 1);
+	try
+	{
+		chai.eval(renameScriptClass(sourceCode, scriptName, className));
+	}
+	catch(const chaiscript::exception::eval_error& ee)
+	{
+		AnnDebug() << "Error during evaluation of reloaded behavior script " << scriptName << " in domain " << name << ". Keeping the previous version";
+		AnnDebug() << ee.pretty_print();
+		AnnTrace::scriptError(scriptName, ee.what());
+		return false;
+	}
+
+	++scriptRevisions[scriptName];
+	scriptClassNames[scriptName] = className;
+
+	//The dispatch functions retrieved from ChaiScript don't know about the methods that have just been added
+	tryAndGetEventHooks();
+	const auto updateHook = chai.eval<std::function<void(chaiscript::Boxed_Value&)>>("update");
+	const auto hooks	  = getEventHooks();
+
+	auto& instances = liveScripts[scriptName];
+	instances.erase(std::remove_if(instances.begin(), instances.end(), [](const AnnLiveBehaviorScript& instance) { return instance.script.expired(); }), instances.end());
+
+	for(const auto& instance : instances)
+	{
+		auto script = instance.script.lock();
+		try
+		{
+			auto newInstance = createScriptInstance(className, instance.ownerTag);
+			migrateScriptState(script->_getScriptObjectInstance(), newInstance);
+			script->_hotSwap(updateHook, hooks, newInstance);
+		}
+		catch(const chaiscript::exception::eval_error& ee)
+		{
+			AnnDebug() << "Cannot migrate an instance of " << scriptName << " owned by \"" << instance.ownerTag << "\"";
+			AnnDebug() << ee.pretty_print();
+			AnnTrace::scriptError(scriptName, ee.what());
+		}
+	}
+
+	AnnDebug() << scriptName << " reloaded in domain " << name << ". " << instances.size() << " living instances migrated";
+	return true;
+}
+
+void AnnScriptDomain::updateScripts()
+{
+	for(auto& scriptClass : liveScripts)
+		for(auto& instance : scriptClass.second)
+			if(auto script = instance.script.lock())
+				script->update();
+}
+
+void AnnScriptDomain::workerLoop()
+{
+	recordingCommandBuffer = &commands;
+
+	std::unique_lock<std::mutex> lock(workerMutex);
+	while(true)
+	{
+		workerCondition.wait(lock, [this] { return updateRequested || stopRequested; });
+		if(stopRequested) return;
+
+		lock.unlock();
+		updateScripts();
+		lock.lock();
+
+		updateRequested = false;
+		workerCondition.notify_all();
+	}
+}
+
+void AnnScriptDomain::beginUpdate()
+{
+	{
+		std::lock_guard<std::mutex> lock(workerMutex);
+		updateRequested = true;
+	}
+	workerCondition.notify_all();
+}
+
+void AnnScriptDomain::waitUpdate()
+{
+	std::unique_lock<std::mutex> lock(workerMutex);
+	workerCondition.wait(lock, [this] { return !updateRequested; });
+}
+
+void AnnScriptDomain::applyCommands()
+{
+	commands.apply();
+}
+
+void AnnScriptDomain::endProfilingFrame()
+{
+	for(auto& scriptClass : liveScripts)
+	{
+		auto& classProfile = scriptProfiles[scriptClass.first];
+		classProfile.name  = scriptClass.first;
+
+		//Dead instances are only forgotten here, their past timings are already in the class totals
+		AnnScriptProfile frame;
+		for(auto& instance : scriptClass.second)
+			if(auto script = instance.script.lock())
+			{
+				const auto instanceFrame = script->_endProfilingFrame();
+				++frame.instances;
+				frame.lastFrameTime += instanceFrame.lastFrameTime;
+				frame.updateCalls += instanceFrame.updateCalls;
+				frame.eventCalls += instanceFrame.eventCalls;
+			}
+
+		classProfile.instances	   = frame.instances;
+		classProfile.lastFrameTime = frame.lastFrameTime;
+		classProfile.peakFrameTime = std::max(classProfile.peakFrameTime, frame.lastFrameTime);
+		classProfile.totalTime += frame.lastFrameTime;
+		classProfile.updateCalls += frame.updateCalls;
+		classProfile.eventCalls += frame.eventCalls;
+	}
+}
+
+const std::unordered_map<std::string, AnnScriptProfile>& AnnScriptDomain::getScriptProfiles() const
+{
+	return scriptProfiles;
+}
+
+std::vector<AnnScriptProfile> AnnScriptDomain::getScriptInstanceProfiles() const
+{
+	std::vector<AnnScriptProfile> profiles;
+	for(const auto& scriptClass : liveScripts)
+		for(const auto& instance : scriptClass.second)
+			if(auto script = instance.script.lock())
+			{
+				profiles.push_back(script->getProfile());
+				profiles.back().name = scriptClass.first + " (" + (instance.ownerTag.empty() ? "no owner" : instance.ownerTag) + ")";
+			}
+
+	return profiles;
+}
+
+void AnnScriptDomain::runOnMainThread(std::function<void()> command)
+{
+	if(recordingCommandBuffer)
+		recordingCommandBuffer->push(std::move(command));
+	else
+		command();
+}
+
+bool AnnScriptDomain::isRecordingCommands()
+{
+	return recordingCommandBuffer != nullptr;
+}
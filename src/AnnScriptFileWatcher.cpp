@@ -0,0 +1,132 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnScriptFileWatcher.hpp"
+#include "AnnLogger.hpp"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
+using namespace Annwvyn;
+
+std::pair<std::string, std::string> AnnScriptFileWatcher::splitPath(const std::string& path)
+{
+	const auto separator = path.find_last_of("/\\");
+	if(separator == std::string::npos) return { ".", path };
+	return { path.substr(0, separator), path.substr(separator + 1) };
+}
+
+#ifdef __linux__
+
+AnnScriptFileWatcher::AnnScriptFileWatcher() :
+ inotifyDescriptor{ inotify_init1(IN_NONBLOCK | IN_CLOEXEC) }
+{
+	if(inotifyDescriptor < 0)
+		AnnDebug() << "Cannot initialize inotify, script files will not be watched";
+}
+
+AnnScriptFileWatcher::~AnnScriptFileWatcher()
+{
+	if(inotifyDescriptor >= 0) close(inotifyDescriptor);
+}
+
+void AnnScriptFileWatcher::watch(const std::string& path)
+{
+	if(inotifyDescriptor < 0) return;
+	if(!watchedFiles.insert(path).second) return;
+
+	//Editors often save by writing a new file and moving it over the old one. Watching the directory catch both cases
+	const auto directory	   = splitPath(path).first;
+	const auto watchDescriptor = inotify_add_watch(inotifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if(watchDescriptor < 0)
+	{
+		AnnDebug() << "Cannot watch directory " << directory;
+		return;
+	}
+
+	//inotify returns the same descriptor when a directory is added twice
+	watchedDirectories[watchDescriptor] = directory;
+	AnnDebug() << "Watching " << path << " for modifications";
+}
+
+std::vector<std::string> AnnScriptFileWatcher::getModifiedFiles()
+{
+	std::vector<std::string> modifiedFiles;
+	if(inotifyDescriptor < 0) return modifiedFiles;
+
+	alignas(inotify_event) char buffer[4096];
+	ssize_t length;
+	while((length = read(inotifyDescriptor, buffer, sizeof buffer)) > 0)
+	{
+		for(auto cursor = buffer; cursor < buffer + length;)
+		{
+			const auto event = reinterpret_cast<const inotify_event*>(cursor);
+			cursor += sizeof(inotify_event) + event->len;
+
+			if(event->len == 0) continue;
+			const auto directory = watchedDirectories.find(event->wd);
+			if(directory == watchedDirectories.end()) continue;
+
+			const auto path = directory->second + "/" + event->name;
+			if(watchedFiles.count(path) == 0) continue;
+			if(std::find(modifiedFiles.begin(), modifiedFiles.end(), path) == modifiedFiles.end())
+				modifiedFiles.push_back(path);
+		}
+	}
+
+	return modifiedFiles;
+}
+
+#else
+
+constexpr const std::chrono::milliseconds AnnScriptFileWatcher::pollInterval;
+
+AnnScriptFileWatcher::AnnScriptFileWatcher() :
+ lastPoll{ std::chrono::steady_clock::now() }
+{
+}
+
+AnnScriptFileWatcher::~AnnScriptFileWatcher() = default;
+
+time_t AnnScriptFileWatcher::getModificationTime(const std::string& path)
+{
+	struct stat fileStatus;
+	if(stat(path.c_str(), &fileStatus) != 0) return 0;
+	return fileStatus.st_mtime;
+}
+
+void AnnScriptFileWatcher::watch(const std::string& path)
+{
+	if(watchedFiles.count(path) != 0) return;
+	watchedFiles[path] = getModificationTime(path);
+	AnnDebug() << "Watching " << path << " for modifications";
+}
+
+std::vector<std::string> AnnScriptFileWatcher::getModifiedFiles()
+{
+	std::vector<std::string> modifiedFiles;
+
+	//stat() is not free, don't do it every frame
+	const auto now = std::chrono::steady_clock::now();
+	if(now - lastPoll < pollInterval) return modifiedFiles;
+	lastPoll = now;
+
+	for(auto& watchedFile : watchedFiles)
+	{
+		const auto modificationTime = getModificationTime(watchedFile.first);
+		if(modificationTime == 0 || modificationTime == watchedFile.second) continue;
+		watchedFile.second = modificationTime;
+		modifiedFiles.push_back(watchedFile.first);
+	}
+
+	return modifiedFiles;
+}
+
+#endif
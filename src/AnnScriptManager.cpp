@@ -7,562 +7,662 @@
 #include "AnnGameObjectManager.hpp"
 #include "AnnEngine.hpp"
 #include "AnnGetter.hpp"
+#include "AnnTrace.hpp"
 #include "Annwvyn.h"
 
 using namespace Annwvyn;
 
-constexpr const char* const AnnScriptManager::fileErrorPrefix;
 constexpr const char* const AnnScriptManager::logFromScript;
+constexpr const char* const AnnScriptManager::scriptExtension;
 
 AnnScriptManager::AnnScriptManager() :
  AnnSubSystem("ScriptManager"),
+ mainDomain(std::make_shared<AnnScriptDomain>("main", false)),
  scriptFileManager(nullptr)
 {
-	registerApi();
+	registerApi(*mainDomain->_getEngine());
 	AnnDebug() << "Using ChaiScript version 6.0";
 	registerResourceManager();
 }
 
-void AnnScriptManager::registerApi()
+namespace
+{
+	///Run a command on a game object. When recorded by a concurrent script domain, the object is resolved again from it's handle
+	///when the command is applied, as it may have been removed in between
+	void onGameObject(AnnGameObject* object, std::function<void(AnnGameObject*)> command)
+	{
+		if(!object) return;
+		if(!AnnScriptDomain::isRecordingCommands()) return command(object);
+
+		AnnScriptDomain::runOnMainThread([handle = object->getHandle(), command] {
+			if(auto gameObject = handle.get())
+				command(gameObject);
+		});
+	}
+
+	///Run a command on a light object. Same as onGameObject()
+	void onLightObject(AnnLightObject* object, std::function<void(AnnLightObject*)> command)
+	{
+		if(!object) return;
+		if(!AnnScriptDomain::isRecordingCommands()) return command(object);
+
+		AnnScriptDomain::runOnMainThread([name = object->getName(), command] {
+			if(auto lightObject = AnnGetGameObjectManager()->getLightObject(name))
+				command(lightObject.get());
+		});
+	}
+}
+
+chaiscript::ModulePtr AnnScriptManager::buildApiModule()
 {
 	using namespace Ogre;
 	using namespace chaiscript;
 	using namespace std;
 
 	// TODO ISSUE Add to chai all the useful types (angles, vectors, quaternions...)
-	try
+	auto module = std::make_shared<Module>();
 	{
 		//Random maths
-		chai.add(var(&Math::PI), "PI");
-		chai.add(var(&Math::HALF_PI), "HALF_PI");
-		chai.add(var(&Math::LOG2), "LOG2");
-		chai.add(var(&Math::TWO_PI), "TWO_PI");
-		chai.add(fun([](const Vector3& a, const Vector3& b, float w) { return Math::lerp(a, b, w); }), "lerp");
-		chai.add(fun([](float a, float b, float w) { return Math::lerp(a, b, w); }), "lerp");
-		chai.add(fun([](float fT, const Quaternion& rkP, const Quaternion& rkQ) { return Quaternion::Slerp(fT, rkP, rkQ); }), "slerp");
-		chai.add(fun([](float f) { return sin(f); }), "sin");
-		chai.add(fun([](float f) { return cos(f); }), "cos");
-		chai.add(fun([](float f) { return tan(f); }), "tan");
-		chai.add(fun([](float f) { return asin(f); }), "asin");
-		chai.add(fun([](float f) { return acos(f); }), "acos");
-		chai.add(fun([](float f) { return atan(f); }), "atan");
-		chai.add(fun([](float y, float x) { return atan2(y, x); }), "atan2");
-
-		chai.add(fun([] { return AnnGetEngine()->getTimeFromStartUp(); }), "getTimeFromStartUp");
+		module->add_global_const(const_var(Math::PI), "PI");
+		module->add_global_const(const_var(Math::HALF_PI), "HALF_PI");
+		module->add_global_const(const_var(Math::LOG2), "LOG2");
+		module->add_global_const(const_var(Math::TWO_PI), "TWO_PI");
+		module->add(fun([](const Vector3& a, const Vector3& b, float w) { return Math::lerp(a, b, w); }), "lerp");
+		module->add(fun([](float a, float b, float w) { return Math::lerp(a, b, w); }), "lerp");
+		module->add(fun([](float fT, const Quaternion& rkP, const Quaternion& rkQ) { return Quaternion::Slerp(fT, rkP, rkQ); }), "slerp");
+		module->add(fun([](float f) { return sin(f); }), "sin");
+		module->add(fun([](float f) { return cos(f); }), "cos");
+		module->add(fun([](float f) { return tan(f); }), "tan");
+		module->add(fun([](float f) { return asin(f); }), "asin");
+		module->add(fun([](float f) { return acos(f); }), "acos");
+		module->add(fun([](float f) { return atan(f); }), "atan");
+		module->add(fun([](float y, float x) { return atan2(y, x); }), "atan2");
+
+		module->add(fun([] { return AnnGetEngine()->getTimeFromStartUp(); }), "getTimeFromStartUp");
 
 		// 3D vector
-		chai.add(user_type<Vector3>(), "AnnVect3");
-		chai.add(constructor<Vector3()>(), "AnnVect3");
-		chai.add(constructor<Vector3(const float, const float, const float)>(), "AnnVect3");
-		chai.add(constructor<Vector3(const float[3])>(), "AnnVect3");
-		chai.add(constructor<Vector3(const Vector3&)>(), "AnnVect3");
-		chai.add(fun(&Vector3::x), "x");
-		chai.add(fun(&Vector3::y), "y");
-		chai.add(fun(&Vector3::z), "z");
-		chai.add(fun([](Vector3& u, const Vector3& v) { u = v; }), "=");
-		chai.add(fun([](Vector3& u, const Real s) { u = s; }), "=");
-		chai.add(fun<Vector3>(&Vector3::operator+), "+");
-		chai.add(fun([](const Vector3& v) { return -v; }), "-");
-		chai.add(fun([](const Vector3& v, Vector3 w) { return v - w; }), "-");
-		chai.add(fun([](const Vector3& v, const Real w) { return v - w; }), "-");
-		chai.add(fun([](const Real& v, const Vector3& w) { return v - w; }), "-");
-		chai.add(fun([](const Vector3& vector, Real scalar) { return scalar * vector; }), "*");
-		chai.add(fun([](Real scalar, const Vector3& vector) { return scalar * vector; }), "*");
-		chai.add(fun([](const Vector3& v1, const Vector3& v2) { return v1 * v2; }), "*");
-		chai.add(fun([](const Vector3& vector, Real scalar) { return scalar / vector; }), "/");
-		chai.add(fun([](const Vector3& v1, const Vector3& v2) { return v1 / v2; }), "/");
-		chai.add(fun([](Vector3& u, Vector3 v) { u *= v; }), "*=");
-		chai.add(fun([](Vector3& u, Vector3 v) { u /= v; }), "/=");
-		chai.add(fun([](Vector3& u, Vector3 v) { u += v; }), "+=");
-		chai.add(fun([](Vector3& u, Vector3 v) { u -= v; }), "-=");
-		chai.add(fun([](Vector3& vector, Real scalar) { vector *= scalar; }), "*=");
-		chai.add(fun([](Vector3& vector, Real scalar) { vector /= scalar; }), "/=");
-		chai.add(fun([](Vector3& vector, Real scalar) { vector += scalar; }), "+=");
-		chai.add(fun([](Vector3& vector, Real scalar) { vector -= scalar; }), "-=");
-		chai.add(fun([](const Vector3& v1, const Vector3& v2) { return v1 == v2; }), "==");
-		chai.add(fun([](const Vector3& v1, const Vector3& v2) { return v1 != v2; }), "!=");
-		chai.add(fun([](const Vector3& v1, const Vector3& v2) { return v1 < v2; }), "<");
-		chai.add(fun([](const Vector3& v1, const Vector3& v2) { return v1 > v2; }), ">");
-		chai.add(fun([](const Vector3& v, const size_t i) { return v[i]; }), "[]");
-		chai.add(fun([](Vector3& u, Vector3& v) { u.swap(v); }), "swap");
-		chai.add(fun([](const Vector3& v) { return v.length(); }), "length");
-		chai.add(fun([](const Vector3& v) { return v.normalisedCopy(); }), "normalisedCopy");
-		chai.add(fun([](const Vector3& v) { return v.squaredLength(); }), "squaredLength");
-		chai.add(fun([](const Vector3& v) { return v.perpendicular(); }), "perpendicular");
-		chai.add(fun([](const Vector3& v) { return v.primaryAxis(); }), "primaryAxis");
-		chai.add(fun([](const Vector3& v) { return v.isZeroLength(); }), "isZeroLength");
-		chai.add(fun([](const Vector3& v) { return v.isNaN(); }), "isNaN");
-		chai.add(fun([](Vector3& v) { return v.normalise(); }), "normalise");
-		chai.add(var(&Vector3::UNIT_X), "AnnVect3_UNIT_X");
-		chai.add(var(&Vector3::UNIT_Y), "AnnVect3_UNIT_Y");
-		chai.add(var(&Vector3::UNIT_Z), "AnnVect3_UNIT_Z");
-		chai.add(var(&Vector3::NEGATIVE_UNIT_X), "AnnVect3_NEGATIVE_UNIT_X");
-		chai.add(var(&Vector3::NEGATIVE_UNIT_Y), "AnnVect3_NEGATIVE_UNIT_Y");
-		chai.add(var(&Vector3::NEGATIVE_UNIT_Z), "AnnVect3_NEGATIVE_UNIT_Z");
-		chai.add(var(&Vector3::UNIT_SCALE), "AnnVect3_UNIT_SCALE");
+		module->add(user_type<Vector3>(), "AnnVect3");
+		module->add(constructor<Vector3()>(), "AnnVect3");
+		module->add(constructor<Vector3(const float, const float, const float)>(), "AnnVect3");
+		module->add(constructor<Vector3(const float[3])>(), "AnnVect3");
+		module->add(constructor<Vector3(const Vector3&)>(), "AnnVect3");
+		module->add(fun(&Vector3::x), "x");
+		module->add(fun(&Vector3::y), "y");
+		module->add(fun(&Vector3::z), "z");
+		module->add(fun([](Vector3& u, const Vector3& v) { u = v; }), "=");
+		module->add(fun([](Vector3& u, const Real s) { u = s; }), "=");
+		module->add(fun<Vector3>(&Vector3::operator+), "+");
+		module->add(fun([](const Vector3& v) { return -v; }), "-");
+		module->add(fun([](const Vector3& v, Vector3 w) { return v - w; }), "-");
+		module->add(fun([](const Vector3& v, const Real w) { return v - w; }), "-");
+		module->add(fun([](const Real& v, const Vector3& w) { return v - w; }), "-");
+		module->add(fun([](const Vector3& vector, Real scalar) { return scalar * vector; }), "*");
+		module->add(fun([](Real scalar, const Vector3& vector) { return scalar * vector; }), "*");
+		module->add(fun([](const Vector3& v1, const Vector3& v2) { return v1 * v2; }), "*");
+		module->add(fun([](const Vector3& vector, Real scalar) { return scalar / vector; }), "/");
+		module->add(fun([](const Vector3& v1, const Vector3& v2) { return v1 / v2; }), "/");
+		module->add(fun([](Vector3& u, Vector3 v) { u *= v; }), "*=");
+		module->add(fun([](Vector3& u, Vector3 v) { u /= v; }), "/=");
+		module->add(fun([](Vector3& u, Vector3 v) { u += v; }), "+=");
+		module->add(fun([](Vector3& u, Vector3 v) { u -= v; }), "-=");
+		module->add(fun([](Vector3& vector, Real scalar) { vector *= scalar; }), "*=");
+		module->add(fun([](Vector3& vector, Real scalar) { vector /= scalar; }), "/=");
+		module->add(fun([](Vector3& vector, Real scalar) { vector += scalar; }), "+=");
+		module->add(fun([](Vector3& vector, Real scalar) { vector -= scalar; }), "-=");
+		module->add(fun([](const Vector3& v1, const Vector3& v2) { return v1 == v2; }), "==");
+		module->add(fun([](const Vector3& v1, const Vector3& v2) { return v1 != v2; }), "!=");
+		module->add(fun([](const Vector3& v1, const Vector3& v2) { return v1 < v2; }), "<");
+		module->add(fun([](const Vector3& v1, const Vector3& v2) { return v1 > v2; }), ">");
+		module->add(fun([](const Vector3& v, const size_t i) { return v[i]; }), "[]");
+		module->add(fun([](Vector3& u, Vector3& v) { u.swap(v); }), "swap");
+		module->add(fun([](const Vector3& v) { return v.length(); }), "length");
+		module->add(fun([](const Vector3& v) { return v.normalisedCopy(); }), "normalisedCopy");
+		module->add(fun([](const Vector3& v) { return v.squaredLength(); }), "squaredLength");
+		module->add(fun([](const Vector3& v) { return v.perpendicular(); }), "perpendicular");
+		module->add(fun([](const Vector3& v) { return v.primaryAxis(); }), "primaryAxis");
+		module->add(fun([](const Vector3& v) { return v.isZeroLength(); }), "isZeroLength");
+		module->add(fun([](const Vector3& v) { return v.isNaN(); }), "isNaN");
+		module->add(fun([](Vector3& v) { return v.normalise(); }), "normalise");
+		module->add_global_const(const_var(Vector3::UNIT_X), "AnnVect3_UNIT_X");
+		module->add_global_const(const_var(Vector3::UNIT_Y), "AnnVect3_UNIT_Y");
+		module->add_global_const(const_var(Vector3::UNIT_Z), "AnnVect3_UNIT_Z");
+		module->add_global_const(const_var(Vector3::NEGATIVE_UNIT_X), "AnnVect3_NEGATIVE_UNIT_X");
+		module->add_global_const(const_var(Vector3::NEGATIVE_UNIT_Y), "AnnVect3_NEGATIVE_UNIT_Y");
+		module->add_global_const(const_var(Vector3::NEGATIVE_UNIT_Z), "AnnVect3_NEGATIVE_UNIT_Z");
+		module->add_global_const(const_var(Vector3::UNIT_SCALE), "AnnVect3_UNIT_SCALE");
 
 		//Angles
-		chai.add(user_type<Radian>(), "AnnRadian");
-		chai.add(user_type<Degree>(), "AnnDegree");
-		chai.add(constructor<Radian(Real)>(), "AnnRadian");
-		chai.add(constructor<Degree(Real)>(), "AnnDegree");
-		chai.add(constructor<Radian(const Degree&)>(), "AnnRadian");
-		chai.add(constructor<Degree(const Radian&)>(), "AnnDegree");
-		chai.add(fun([](const Degree& d) { return +d; }), "+");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 + d2; }), "+");
-		chai.add(fun([](const Degree& d1, const Radian& d2) { return d1 + d2; }), "+");
-		chai.add(fun([](Degree& d1, const Degree& d2) { d1 += d2; }), "+=");
-		chai.add(fun([](const Degree& d) { return -d; }), "-");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 - d2; }), "-");
-		chai.add(fun([](const Degree& d1, const Radian& d2) { return d1 - d2; }), "-");
-		chai.add(fun([](Degree& d1, const Degree& d2) { d1 -= d2; }), "-=");
-		chai.add(fun([](Degree& d1, const Radian& d2) { d1 -= d2; }), "-=");
-		chai.add(fun([](const Degree& d, Real f) { return d * f; }), "*");
-		chai.add(fun([](Degree& d, Real f) { d *= f; }), "*=");
-		chai.add(fun([](const Degree& d, Real f) { return d / f; }), "/");
-		chai.add(fun([](Degree& d, Real f) { d /= f; }), "/=");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 < d2; }), "<");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 > d2; }), ">");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 <= d2; }), "<=");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 >= d2; }), ">=");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 == d2; }), "==");
-		chai.add(fun([](const Degree& d1, const Degree& d2) { return d1 != d2; }), "!=");
-		chai.add(fun([](const Radian& d) { return +d; }), "+");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 + r2; }), "+");
-		chai.add(fun([](const Radian& r1, const Degree& r2) { return r1 + r2; }), "+");
-		chai.add(fun([](Radian& r1, const Radian& r2) { r1 += r2; }), "+=");
-		chai.add(fun([](const Radian& d) { return -d; }), "-");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 - r2; }), "-");
-		chai.add(fun([](const Radian& r1, const Degree& r2) { return r1 - r2; }), "-");
-		chai.add(fun([](Radian& r1, const Radian& r2) { r1 -= r2; }), "-=");
-		chai.add(fun([](Radian& r1, const Degree& r2) { r1 -= r2; }), "-=");
-		chai.add(fun([](const Radian& d, Real f) { return d * f; }), "*");
-		chai.add(fun([](Radian& d, Real f) { d *= f; }), "*=");
-		chai.add(fun([](const Radian& d, Real f) { return d / f; }), "/");
-		chai.add(fun([](Radian& d, Real f) { d /= f; }), "/=");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 < r2; }), "<");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 > r2; }), ">");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 <= r2; }), "<=");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 >= r2; }), ">=");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 == r2; }), "==");
-		chai.add(fun([](const Radian& r1, const Radian& r2) { return r1 != r2; }), "!=");
+		module->add(user_type<Radian>(), "AnnRadian");
+		module->add(user_type<Degree>(), "AnnDegree");
+		module->add(constructor<Radian(Real)>(), "AnnRadian");
+		module->add(constructor<Degree(Real)>(), "AnnDegree");
+		module->add(constructor<Radian(const Degree&)>(), "AnnRadian");
+		module->add(constructor<Degree(const Radian&)>(), "AnnDegree");
+		module->add(fun([](const Degree& d) { return +d; }), "+");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 + d2; }), "+");
+		module->add(fun([](const Degree& d1, const Radian& d2) { return d1 + d2; }), "+");
+		module->add(fun([](Degree& d1, const Degree& d2) { d1 += d2; }), "+=");
+		module->add(fun([](const Degree& d) { return -d; }), "-");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 - d2; }), "-");
+		module->add(fun([](const Degree& d1, const Radian& d2) { return d1 - d2; }), "-");
+		module->add(fun([](Degree& d1, const Degree& d2) { d1 -= d2; }), "-=");
+		module->add(fun([](Degree& d1, const Radian& d2) { d1 -= d2; }), "-=");
+		module->add(fun([](const Degree& d, Real f) { return d * f; }), "*");
+		module->add(fun([](Degree& d, Real f) { d *= f; }), "*=");
+		module->add(fun([](const Degree& d, Real f) { return d / f; }), "/");
+		module->add(fun([](Degree& d, Real f) { d /= f; }), "/=");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 < d2; }), "<");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 > d2; }), ">");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 <= d2; }), "<=");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 >= d2; }), ">=");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 == d2; }), "==");
+		module->add(fun([](const Degree& d1, const Degree& d2) { return d1 != d2; }), "!=");
+		module->add(fun([](const Radian& d) { return +d; }), "+");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 + r2; }), "+");
+		module->add(fun([](const Radian& r1, const Degree& r2) { return r1 + r2; }), "+");
+		module->add(fun([](Radian& r1, const Radian& r2) { r1 += r2; }), "+=");
+		module->add(fun([](const Radian& d) { return -d; }), "-");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 - r2; }), "-");
+		module->add(fun([](const Radian& r1, const Degree& r2) { return r1 - r2; }), "-");
+		module->add(fun([](Radian& r1, const Radian& r2) { r1 -= r2; }), "-=");
+		module->add(fun([](Radian& r1, const Degree& r2) { r1 -= r2; }), "-=");
+		module->add(fun([](const Radian& d, Real f) { return d * f; }), "*");
+		module->add(fun([](Radian& d, Real f) { d *= f; }), "*=");
+		module->add(fun([](const Radian& d, Real f) { return d / f; }), "/");
+		module->add(fun([](Radian& d, Real f) { d /= f; }), "/=");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 < r2; }), "<");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 > r2; }), ">");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 <= r2; }), "<=");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 >= r2; }), ">=");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 == r2; }), "==");
+		module->add(fun([](const Radian& r1, const Radian& r2) { return r1 != r2; }), "!=");
 
 		//Quaternions
-		chai.add(user_type<Quaternion>(), "AnnQuaternion");
-		chai.add(constructor<Quaternion()>(), "AnnQuaternion");
-		chai.add(constructor<Quaternion(const float, const float, const float, const float)>(), "AnnQuaternion");
-		chai.add(constructor<Quaternion(Radian, Vector3)>(), "AnnQuaternion");
-		chai.add(constructor<Quaternion(Vector3, Vector3, Vector3)>(), "AnnQuaternion");
-		chai.add(fun(&Quaternion::x), "x");
-		chai.add(fun(&Quaternion::y), "y");
-		chai.add(fun(&Quaternion::z), "z");
-		chai.add(fun(&Quaternion::w), "w");
-		chai.add(fun([](const Quaternion& q, const Vector3 v) { return q * v; }), "*");
-		chai.add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 * q2; }), "*");
-		chai.add(fun([](const Quaternion& q, const Real& scalar) { return q * scalar; }), "*");
-		chai.add(fun([](const Quaternion& q, size_t i) { return q[i]; }), "[]");
-		chai.add(fun([](Quaternion& q1, const Quaternion& q2) { q1 = q2; }), "=");
-		chai.add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 + q2; }), "+");
-		chai.add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 - q2; }), "-");
-		chai.add(fun([](const Quaternion& q) { return -q; }), "-");
-		chai.add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 == q2; }), "==");
-		chai.add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 != q2; }), "!=");
-		chai.add(fun([](const Quaternion& q) { return q.xAxis(); }), "xAxis");
-		chai.add(fun([](const Quaternion& q) { return q.yAxis(); }), "yAxis");
-		chai.add(fun([](const Quaternion& q) { return q.zAxis(); }), "zAxis");
-		chai.add(fun([](const Quaternion& q) { return q.getRoll(); }), "getRoll");
-		chai.add(fun([](const Quaternion& q) { return q.getPitch(); }), "getPitch");
-		chai.add(fun([](const Quaternion& q) { return q.getYaw(); }), "getYaw");
-		chai.add(fun([](const Quaternion& q) { return q.isNaN(); }), "isNaN");
-		chai.add(var(&Quaternion::ZERO), "AnnQuaternion_ZERO");
-		chai.add(var(&Quaternion::IDENTITY), "AnnQuaternion_IDENTITY");
-
-		chai.add(user_type<AnnGameObject>(), "AnnGameObject");
-		chai.add(fun([](AnnGameObject* o, Vector3 v) { o->setPosition(v); }), "setPosition");
-		chai.add(fun([](AnnGameObject* o, Quaternion q) { o->setOrientation(q); }), "setOrientation");
-		chai.add(fun([](AnnGameObject* o, Vector3 v) { o->setScale(v); }), "setScale");
-		chai.add(fun([](AnnGameObject* o) -> Vector3 { return o->getPosition(); }), "getPosition");
-		chai.add(fun([](AnnGameObject* o) -> Quaternion { return o->getOrientation(); }), "getOrientation");
-		chai.add(fun([](AnnGameObject* o) -> Vector3 { return o->getScale(); }), "getScale");
-		chai.add(fun([](AnnGameObject* o, const string& s) { o->playSound(s); }), "playSound");
-		chai.add(fun([](AnnGameObject* o, const string& s) { o->playSound(s, true); }), "playSoundLoop");
-		chai.add(fun([](AnnGameObject* o) { return o->getName(); }), "getName");
-		chai.add(fun([](AnnGameObject* o, const string& animName) { o->setAnimation(animName); }), "setAnimation");
-		chai.add(fun([](AnnGameObject* o) { o->playAnimation(); }), "playAnimation");
-		chai.add(fun([](AnnGameObject* o, bool play) { o->playAnimation(play); }), "playAnimation");
-		chai.add(fun([](AnnGameObject* o) { o->loopAnimation(); }), "loopAnimation");
-		chai.add(fun([](AnnGameObject* o, bool play) { o->loopAnimation(play); }), "loopAnimation");
-		chai.add(fun([](AnnGameObject* o) { return o->getName(); }), "getName");
-
-		chai.add(user_type<AnnLightObject>(), "AnnLightObject");
-		chai.add(fun([](AnnLightObject* o, Vector3 v) { o->setPosition(v); }), "setPosition");
-		chai.add(fun([](AnnLightObject* o, Vector3 v) { o->setDirection(v); }), "setDirection");
-		chai.add(fun([](AnnLightObject* o, AnnColor c) { o->setDiffuseColor(c); }), "setDiffuseColor");
-		chai.add(fun([](AnnLightObject* o, AnnColor c) { o->setSpecularColor(c); }), "setSpecularColor");
-		chai.add(fun([](AnnLightObject* o, float lumens) { o->setPower(lumens); }), "setPower");
-		chai.add(fun([](AnnLightObject* o) -> Vector3 { return o->getPosition(); }), "getPosition");
-		chai.add(fun([](AnnLightObject* o) -> Vector3 { return o->getDirection(); }), "getDirection");
-		chai.add(fun([](AnnLightObject* o) -> AnnColor { return o->getSpecularColor(); }), "getSpecularColor");
-		chai.add(fun([](AnnLightObject* o) -> AnnColor { return o->getDiffuseColor(); }), "getDiffuseColor");
-		chai.add(fun([](AnnLightObject* o) { return o->getName(); }), "getName");
+		module->add(user_type<Quaternion>(), "AnnQuaternion");
+		module->add(constructor<Quaternion()>(), "AnnQuaternion");
+		module->add(constructor<Quaternion(const float, const float, const float, const float)>(), "AnnQuaternion");
+		module->add(constructor<Quaternion(Radian, Vector3)>(), "AnnQuaternion");
+		module->add(constructor<Quaternion(Vector3, Vector3, Vector3)>(), "AnnQuaternion");
+		module->add(fun(&Quaternion::x), "x");
+		module->add(fun(&Quaternion::y), "y");
+		module->add(fun(&Quaternion::z), "z");
+		module->add(fun(&Quaternion::w), "w");
+		module->add(fun([](const Quaternion& q, const Vector3 v) { return q * v; }), "*");
+		module->add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 * q2; }), "*");
+		module->add(fun([](const Quaternion& q, const Real& scalar) { return q * scalar; }), "*");
+		module->add(fun([](const Quaternion& q, size_t i) { return q[i]; }), "[]");
+		module->add(fun([](Quaternion& q1, const Quaternion& q2) { q1 = q2; }), "=");
+		module->add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 + q2; }), "+");
+		module->add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 - q2; }), "-");
+		module->add(fun([](const Quaternion& q) { return -q; }), "-");
+		module->add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 == q2; }), "==");
+		module->add(fun([](const Quaternion& q1, const Quaternion& q2) { return q1 != q2; }), "!=");
+		module->add(fun([](const Quaternion& q) { return q.xAxis(); }), "xAxis");
+		module->add(fun([](const Quaternion& q) { return q.yAxis(); }), "yAxis");
+		module->add(fun([](const Quaternion& q) { return q.zAxis(); }), "zAxis");
+		module->add(fun([](const Quaternion& q) { return q.getRoll(); }), "getRoll");
+		module->add(fun([](const Quaternion& q) { return q.getPitch(); }), "getPitch");
+		module->add(fun([](const Quaternion& q) { return q.getYaw(); }), "getYaw");
+		module->add(fun([](const Quaternion& q) { return q.isNaN(); }), "isNaN");
+		module->add_global_const(const_var(Quaternion::ZERO), "AnnQuaternion_ZERO");
+		module->add_global_const(const_var(Quaternion::IDENTITY), "AnnQuaternion_IDENTITY");
+
+		module->add(user_type<AnnGameObject>(), "AnnGameObject");
+		module->add(fun([](AnnGameObject* o, Vector3 v) { onGameObject(o, [=](AnnGameObject* g) { g->setPosition(v); }); }), "setPosition");
+		module->add(fun([](AnnGameObject* o, Quaternion q) { onGameObject(o, [=](AnnGameObject* g) { g->setOrientation(q); }); }), "setOrientation");
+		module->add(fun([](AnnGameObject* o, Vector3 v) { onGameObject(o, [=](AnnGameObject* g) { g->setScale(v); }); }), "setScale");
+		module->add(fun([](AnnGameObject* o) -> Vector3 { return o->getPosition(); }), "getPosition");
+		module->add(fun([](AnnGameObject* o) -> Quaternion { return o->getOrientation(); }), "getOrientation");
+		module->add(fun([](AnnGameObject* o) -> Vector3 { return o->getScale(); }), "getScale");
+		module->add(fun([](AnnGameObject* o, const string& s) { onGameObject(o, [=](AnnGameObject* g) { g->playSound(s); }); }), "playSound");
+		module->add(fun([](AnnGameObject* o, const string& s) { onGameObject(o, [=](AnnGameObject* g) { g->playSound(s, true); }); }), "playSoundLoop");
+		module->add(fun([](AnnGameObject* o) { return o->getName(); }), "getName");
+		module->add(fun([](AnnGameObject* o) { return o->getHandle(); }), "getHandle");
+		module->add(fun([](AnnGameObject* o, const string& animName) { onGameObject(o, [=](AnnGameObject* g) { g->setAnimation(animName); }); }), "setAnimation");
+		module->add(fun([](AnnGameObject* o) { onGameObject(o, [](AnnGameObject* g) { g->playAnimation(); }); }), "playAnimation");
+		module->add(fun([](AnnGameObject* o, bool play) { onGameObject(o, [=](AnnGameObject* g) { g->playAnimation(play); }); }), "playAnimation");
+		module->add(fun([](AnnGameObject* o) { onGameObject(o, [](AnnGameObject* g) { g->loopAnimation(); }); }), "loopAnimation");
+		module->add(fun([](AnnGameObject* o, bool play) { onGameObject(o, [=](AnnGameObject* g) { g->loopAnimation(play); }); }), "loopAnimation");
+		module->add(fun([](AnnGameObject* o) { return o->getName(); }), "getName");
+
+		module->add(user_type<AnnLightObject>(), "AnnLightObject");
+		module->add(fun([](AnnLightObject* o, Vector3 v) { onLightObject(o, [=](AnnLightObject* l) { l->setPosition(v); }); }), "setPosition");
+		module->add(fun([](AnnLightObject* o, Vector3 v) { onLightObject(o, [=](AnnLightObject* l) { l->setDirection(v); }); }), "setDirection");
+		module->add(fun([](AnnLightObject* o, AnnColor c) { onLightObject(o, [=](AnnLightObject* l) { l->setDiffuseColor(c); }); }), "setDiffuseColor");
+		module->add(fun([](AnnLightObject* o, AnnColor c) { onLightObject(o, [=](AnnLightObject* l) { l->setSpecularColor(c); }); }), "setSpecularColor");
+		module->add(fun([](AnnLightObject* o, float lumens) { onLightObject(o, [=](AnnLightObject* l) { l->setPower(lumens); }); }), "setPower");
+		module->add(fun([](AnnLightObject* o) -> Vector3 { return o->getPosition(); }), "getPosition");
+		module->add(fun([](AnnLightObject* o) -> Vector3 { return o->getDirection(); }), "getDirection");
+		module->add(fun([](AnnLightObject* o) -> AnnColor { return o->getSpecularColor(); }), "getSpecularColor");
+		module->add(fun([](AnnLightObject* o) -> AnnColor { return o->getDiffuseColor(); }), "getDiffuseColor");
+		module->add(fun([](AnnLightObject* o) { return o->getName(); }), "getName");
 
 		//Color
-		chai.add(user_type<AnnColor>(), "AnnColor");
-		chai.add(constructor<AnnColor(float, float, float, float)>(), "AnnColor");
-		chai.add(constructor<AnnColor(const ColourValue&)>(), "AnnColor");
-		chai.add(constructor<AnnColor(const AnnColor&)>(), "AnnColor");
-		chai.add(fun([](AnnColor& c1, AnnColor& c2) { c1 = c2; }), "=");
-		chai.add(fun([](AnnColor& color) { return color.getRed(); }), "getRed");
-		chai.add(fun([](AnnColor& color) { return color.getGreen(); }), "getGreen");
-		chai.add(fun([](AnnColor& color) { return color.getBlue(); }), "getBlue");
-		chai.add(fun([](AnnColor& color) { return color.getAlpha(); }), "getAlpha");
-		chai.add(fun([](AnnColor& color, float value) { return color.setRed(value); }), "setRed");
-		chai.add(fun([](AnnColor& color, float value) { return color.setGreen(value); }), "setGreen");
-		chai.add(fun([](AnnColor& color, float value) { return color.setBlue(value); }), "setBlue");
-		chai.add(fun([](AnnColor& color, float value) { return color.setAlpha(value); }), "setAlpha");
+		module->add(user_type<AnnColor>(), "AnnColor");
+		module->add(constructor<AnnColor(float, float, float, float)>(), "AnnColor");
+		module->add(constructor<AnnColor(const ColourValue&)>(), "AnnColor");
+		module->add(constructor<AnnColor(const AnnColor&)>(), "AnnColor");
+		module->add(fun([](AnnColor& c1, AnnColor& c2) { c1 = c2; }), "=");
+		module->add(fun([](AnnColor& color) { return color.getRed(); }), "getRed");
+		module->add(fun([](AnnColor& color) { return color.getGreen(); }), "getGreen");
+		module->add(fun([](AnnColor& color) { return color.getBlue(); }), "getBlue");
+		module->add(fun([](AnnColor& color) { return color.getAlpha(); }), "getAlpha");
+		module->add(fun([](AnnColor& color, float value) { return color.setRed(value); }), "setRed");
+		module->add(fun([](AnnColor& color, float value) { return color.setGreen(value); }), "setGreen");
+		module->add(fun([](AnnColor& color, float value) { return color.setBlue(value); }), "setBlue");
+		module->add(fun([](AnnColor& color, float value) { return color.setAlpha(value); }), "setAlpha");
+
+		//Handles stay safe to keep between frames, they resolve to null once the object is removed
+		module->add(user_type<AnnGameObjectHandle>(), "AnnGameObjectHandle");
+		module->add(constructor<AnnGameObjectHandle()>(), "AnnGameObjectHandle");
+		module->add(constructor<AnnGameObjectHandle(const AnnGameObjectHandle&)>(), "AnnGameObjectHandle");
+		module->add(fun([](AnnGameObjectHandle& a, const AnnGameObjectHandle& b) -> AnnGameObjectHandle& { return a = b; }), "=");
+		module->add(fun([](const AnnGameObjectHandle& a, const AnnGameObjectHandle& b) { return a == b; }), "==");
+		module->add(fun([](const AnnGameObjectHandle& handle) { return handle.get(); }), "get");
+		module->add(fun([](const AnnGameObjectHandle& handle) { return handle.isValid(); }), "isValid");
 
 		//Object getter
-		chai.add(fun([](string id) { return AnnGetGameObjectManager()->getGameObject(id).get(); }), "AnnGetGameObject");
-		chai.add(fun([](string id) { return AnnGetGameObjectManager()->getLightObject(id).get(); }), "AnnGetLightObject");
+		module->add(fun([](string id) { return AnnGetGameObjectManager()->getGameObject(id).get(); }), "AnnGetGameObject");
+		module->add(fun([](const string& id) { return AnnGetGameObjectManager()->getGameObjectHandle(id); }), "AnnGetGameObjectHandle");
+		module->add(fun([](string id) { return AnnGetGameObjectManager()->getLightObject(id).get(); }), "AnnGetLightObject");
 
 		//Level jumper
-		chai.add(fun([](AnnLevelID id) { AnnGetLevelManager()->switchToLevel(id); }), "AnnJumpLevel");
+		module->add(fun([](AnnLevelID id) { AnnScriptDomain::runOnMainThread([=] { AnnGetLevelManager()->switchToLevel(id); }); }), "AnnJumpLevel");
+		module->add(fun([](AnnLevelID id) { AnnScriptDomain::runOnMainThread([=] { AnnGetLevelManager()->switchToLevelAsync(id); }); }), "AnnJumpLevelAsync");
 
 		//Create a GameObject form ChaiScript
-		chai.add(fun([](const string& mesh, const string& objectName) {
-					 AnnGetLevelManager()->addToCurrentLevel(
-						 AnnGetGameObjectManager()->createGameObject(mesh.c_str(), objectName));
+		module->add(fun([](const string& mesh, const string& objectName) {
+					 AnnScriptDomain::runOnMainThread([=] {
+						 AnnGetLevelManager()->addToCurrentLevel(
+							 AnnGetGameObjectManager()->createGameObject(mesh.c_str(), objectName));
+					 });
 				 }),
 				 "AnnCreateGameObject");
 		//Remove object
-		chai.add(fun([](const string& objectName) {
-					 auto obj = AnnGetGameObjectManager()->getGameObject(objectName);
-					 if(!obj) return;
-					 AnnGetGameObjectManager()->removeGameObject(obj);
-					 AnnGetLevelManager()->removeFromCurrentLevel(obj);
+		module->add(fun([](const string& objectName) {
+					 AnnScriptDomain::runOnMainThread([=] {
+						 auto obj = AnnGetGameObjectManager()->getGameObject(objectName);
+						 if(!obj) return;
+						 AnnGetGameObjectManager()->removeGameObject(obj);
+						 AnnGetLevelManager()->removeFromCurrentLevel(obj);
+					 });
 				 }),
 				 "AnnRemoveGameObject");
 
 		//Change the gravity
-		chai.add(fun([](const Vector3& gravity) { AnnGetPhysicsEngine()->changeGravity(gravity); }), "AnnChangeGravity");
+		module->add(fun([](const Vector3& gravity) { AnnScriptDomain::runOnMainThread([=] { AnnGetPhysicsEngine()->changeGravity(gravity); }); }), "AnnChangeGravity");
 		//Restore the default gravity vector
-		chai.add(fun([]() { AnnGetPhysicsEngine()->resetGravity(); }), "AnnRestoreGravity");
+		module->add(fun([]() { AnnScriptDomain::runOnMainThread([] { AnnGetPhysicsEngine()->resetGravity(); }); }), "AnnRestoreGravity");
 
 		//Add the types of the event representation object
-		chai.add(user_type<AnnKeyEvent>(), "AnnKeyEvent");
-		chai.add(user_type<AnnMouseEvent>(), "AnnMouseEvent");
-		chai.add(user_type<AnnControllerEvent>(), "AnnControllerEvent");
-		chai.add(user_type<AnnTimeEvent>(), "AnnTimeEvent");
-		chai.add(user_type<AnnTriggerEvent>(), "AnnTriggerEvent");
-		chai.add(user_type<AnnHandControllerEvent>(), "AnnHandControllerEvent");
-		chai.add(user_type<AnnMouseAxis>(), "AnnMouseAxis");
-		chai.add(user_type<MouseAxisID>(), "MouseAxisID");
-		chai.add(user_type<MouseButtonId>(), "MouseButtonId");
-		chai.add(user_type<AnnControllerAxis>(), "AnnControllerAxis");
-		chai.add(user_type<AnnControllerPov>(), "AnnControllerPov");
-		chai.add(user_type<AnnTimerID>(), "AnnTimerID");
-		chai.add(user_type<AnnCollisionEvent>(), "AnnCollisionEvent");
-		chai.add(user_type<AnnPlayerCollisionEvent>(), "AnnPlayerCollisionEvent");
-
-		chai.add(fun([](AnnKeyEvent e) { return e.isPressed(); }), "isPressed");
-		chai.add(fun([](AnnKeyEvent e) { return e.isReleased(); }), "isReleased");
-		chai.add(fun([](AnnKeyEvent e) { return e.getKey(); }), "getKey");
-
-		chai.add(fun([](AnnMouseEvent e, /*MouseAxisID*/ const int a) { return e.getAxis(MouseAxisID(a)); }), "getAxis");
-		chai.add(fun([](AnnMouseEvent e, /*MouseButtonId*/ const int b) { return e.getButtonState(MouseButtonId(b)); }), "getButtonState");
-		chai.add(fun([](AnnMouseAxis a) { return a.getRelValue(); }), "getRelValue");
-		chai.add(fun([](AnnMouseAxis a) { return a.getAbsValue(); }), "getAbsValue");
-
-		chai.add(fun([](AnnControllerEvent e) { return e.getNbButtons(); }), "getNbButtons");
-		chai.add(fun([](AnnControllerEvent e) { return e.getAxisCount(); }), "getAxisCount");
-		chai.add(fun([](AnnControllerEvent e) { return e.getPovCount(); }), "getPovCount");
-		chai.add(fun([](AnnControllerEvent e) { return e.getVendor(); }), "getVendor");
-		chai.add(fun([](AnnControllerEvent e) { return e.getControllerID(); }), "getControllerID");
-		chai.add(fun([](AnnControllerEvent e) { return e.isXboxController(); }), "isXboxController");
-		chai.add(fun([](AnnControllerEvent e, const int i) { return e.isPressed(i); }), "isPressed");
-		chai.add(fun([](AnnControllerEvent e, const int i) { return e.isReleased(i); }), "isReleased");
-		chai.add(fun([](AnnControllerEvent e, const int i) { return e.isDown(i); }), "isDown");
-		chai.add(fun([](AnnControllerEvent e, const int i) { return e.getAxis(i); }), "getAxis");
-		chai.add(fun([](AnnControllerEvent e, const int i) { return e.getPov(i); }), "getPov");
-
-		chai.add(fun([](AnnControllerPov pov) { return pov.getNorth(); }), "getNorth");
-		chai.add(fun([](AnnControllerPov pov) { return pov.getSouth(); }), "getSouth");
-		chai.add(fun([](AnnControllerPov pov) { return pov.getEast(); }), "getEast");
-		chai.add(fun([](AnnControllerPov pov) { return pov.getWest(); }), "getWest");
-		chai.add(fun([](AnnControllerPov pov) { return pov.getNorthEast(); }), "getNorthEast");
-		chai.add(fun([](AnnControllerPov pov) { return pov.getNorthWest(); }), "getNorthWest");
-		chai.add(fun([](AnnControllerPov pov) { return pov.getSouthEast(); }), "getSouthEast");
-		chai.add(fun([](AnnControllerPov pov) { return pov.getSouthWest(); }), "getSouthWest");
-
-		chai.add(fun([](AnnControllerAxis a) { return a.getAxisId(); }), "getAxisId");
-		chai.add(fun([](AnnControllerAxis a) { return a.getRelValue(); }), "getRelValue");
-		chai.add(fun([](AnnControllerAxis a) { return a.getAbsValue(); }), "getAbsValue");
-
-		chai.add(fun([](AnnTimeEvent t) { return t.getID(); }), "getID");
-
-		chai.add(fun([](AnnTriggerEvent e) { return e.getContactStatus(); }), "getContactStatus");
-		chai.add(fun([](AnnTriggerEvent e) { return e.getSender(); }), "getSender");
+		module->add(user_type<AnnKeyEvent>(), "AnnKeyEvent");
+		module->add(user_type<AnnMouseEvent>(), "AnnMouseEvent");
+		module->add(user_type<AnnControllerEvent>(), "AnnControllerEvent");
+		module->add(user_type<AnnTimeEvent>(), "AnnTimeEvent");
+		module->add(user_type<AnnTriggerEvent>(), "AnnTriggerEvent");
+		module->add(user_type<AnnHandControllerEvent>(), "AnnHandControllerEvent");
+		module->add(user_type<AnnMouseAxis>(), "AnnMouseAxis");
+		module->add(user_type<MouseAxisID>(), "MouseAxisID");
+		module->add(user_type<MouseButtonId>(), "MouseButtonId");
+		module->add(user_type<AnnControllerAxis>(), "AnnControllerAxis");
+		module->add(user_type<AnnControllerPov>(), "AnnControllerPov");
+		module->add(user_type<AnnTimerID>(), "AnnTimerID");
+		module->add(user_type<AnnCollisionEvent>(), "AnnCollisionEvent");
+		module->add(user_type<AnnPlayerCollisionEvent>(), "AnnPlayerCollisionEvent");
+
+		module->add(fun([](const AnnKeyEvent& e) { return e.isPressed(); }), "isPressed");
+		module->add(fun([](const AnnKeyEvent& e) { return e.isReleased(); }), "isReleased");
+		module->add(fun([](const AnnKeyEvent& e) { return e.getKey(); }), "getKey");
+
+		module->add(fun([](const AnnMouseEvent& e, /*MouseAxisID*/ const int a) { return e.getAxis(MouseAxisID(a)); }), "getAxis");
+		module->add(fun([](const AnnMouseEvent& e, /*MouseButtonId*/ const int b) { return e.getButtonState(MouseButtonId(b)); }), "getButtonState");
+		module->add(fun([](AnnMouseAxis a) { return a.getRelValue(); }), "getRelValue");
+		module->add(fun([](AnnMouseAxis a) { return a.getAbsValue(); }), "getAbsValue");
+
+		module->add(fun([](const AnnControllerEvent& e) { return e.getNbButtons(); }), "getNbButtons");
+		module->add(fun([](const AnnControllerEvent& e) { return e.getAxisCount(); }), "getAxisCount");
+		module->add(fun([](const AnnControllerEvent& e) { return e.getPovCount(); }), "getPovCount");
+		module->add(fun([](const AnnControllerEvent& e) { return e.getVendor(); }), "getVendor");
+		module->add(fun([](const AnnControllerEvent& e) { return e.getControllerID(); }), "getControllerID");
+		module->add(fun([](const AnnControllerEvent& e) { return e.isXboxController(); }), "isXboxController");
+		module->add(fun([](const AnnControllerEvent& e, const int i) { return e.isPressed(i); }), "isPressed");
+		module->add(fun([](const AnnControllerEvent& e, const int i) { return e.isReleased(i); }), "isReleased");
+		module->add(fun([](const AnnControllerEvent& e, const int i) { return e.isDown(i); }), "isDown");
+		module->add(fun([](const AnnControllerEvent& e, const int i) { return e.getAxis(i); }), "getAxis");
+		module->add(fun([](const AnnControllerEvent& e, const int i) { return e.getPov(i); }), "getPov");
+
+		module->add(fun([](AnnControllerPov pov) { return pov.getNorth(); }), "getNorth");
+		module->add(fun([](AnnControllerPov pov) { return pov.getSouth(); }), "getSouth");
+		module->add(fun([](AnnControllerPov pov) { return pov.getEast(); }), "getEast");
+		module->add(fun([](AnnControllerPov pov) { return pov.getWest(); }), "getWest");
+		module->add(fun([](AnnControllerPov pov) { return pov.getNorthEast(); }), "getNorthEast");
+		module->add(fun([](AnnControllerPov pov) { return pov.getNorthWest(); }), "getNorthWest");
+		module->add(fun([](AnnControllerPov pov) { return pov.getSouthEast(); }), "getSouthEast");
+		module->add(fun([](AnnControllerPov pov) { return pov.getSouthWest(); }), "getSouthWest");
+
+		module->add(fun([](AnnControllerAxis a) { return a.getAxisId(); }), "getAxisId");
+		module->add(fun([](AnnControllerAxis a) { return a.getRelValue(); }), "getRelValue");
+		module->add(fun([](AnnControllerAxis a) { return a.getAbsValue(); }), "getAbsValue");
+
+		module->add(fun([](const AnnTimeEvent& t) { return t.getID(); }), "getID");
+
+		module->add(fun([](const AnnTriggerEvent& e) { return e.getContactStatus(); }), "getContactStatus");
+		module->add(fun([](const AnnTriggerEvent& e) { return e.getSender(); }), "getSender");
 
 		// TODO ISSUE the hand controller event interface is not finished
-		chai.add(user_type<AnnHandController>(), "AnnHandController");
-		chai.add(user_type<AnnHandControllerAxis>(), "AnnHandControllerAxis");
-		chai.add(user_type<AnnHandController::AnnHandControllerSide>(), "AnnHandControllerSide");
-		chai.add(user_type<AnnHandController::AnnHandControllerTypeHash>(), "AnnHandControllerTypeHash");
-		chai.add(user_type<AnnHandController::AnnHandControllerGestureHash>(), "AnnHandControllerGestureHash");
-		chai.add(var(AnnHandController::AnnHandControllerSide::leftHandController), "leftHandController");
-		chai.add(var(AnnHandController::AnnHandControllerSide::rightHandController), "rightHandController");
-		chai.add(var(AnnHandController::AnnHandControllerSide::invalidHandController), "invalidHandController");
-
-		chai.add(fun([](AnnHandControllerEvent e) -> Vector3 { return e.getPosition(); }), "getPosition");
-		chai.add(fun([](AnnHandControllerEvent e) -> Quaternion { return e.getOrientation(); }), "getOrientation");
-		chai.add(fun([](AnnHandControllerEvent e) -> Vector3 { return e.getPointingDirection(); }), "getOrientation");
-		chai.add(fun([](AnnHandControllerEvent e) -> Vector3 { return e.getLinearSpeed(); }), "getLinearSpeed");
-		chai.add(fun([](AnnHandControllerEvent e) -> Vector3 { return e.getAngularSpeed(); }), "getAngularSpeed");
-		chai.add(fun([](AnnHandControllerEvent e, const uint8_t id) { return e.getAxis(id); }), "getAxis");
-		chai.add(fun([](AnnHandControllerEvent e) { return e.getAxisCount(); }), "getAxisCount");
-		chai.add(fun([](AnnHandControllerEvent e) { return e.getButtonCount(); }), "getButtonCount");
-		chai.add(fun([](AnnHandControllerEvent e, const uint8_t id) { return e.buttonPressed(id); }), "buttonPressed");
-		chai.add(fun([](AnnHandControllerEvent e, const uint8_t id) { return e.buttonReleased(id); }), "buttonReleased");
-		chai.add(fun([](AnnHandControllerEvent e, const uint8_t id) { return e.buttonState(id); }), "buttonState");
-		chai.add(fun([](AnnHandControllerEvent e) { return e.getSide(); }), "getSide");
-		chai.add(fun([](AnnHandControllerEvent e) { return e.getType(); }), "getType");
-
-		chai.add(fun([](AnnPlayerCollisionEvent e) { return e.getObject(); }), "getObject");
-		chai.add(fun([](AnnPlayerCollisionEvent e) { return e.getObject()->getName(); }), "getObjectName");
-
-		chai.add(fun([](AnnCollisionEvent e) { return e.getA(); }), "getAObject");
-		chai.add(fun([](AnnCollisionEvent e) { return e.getB(); }), "getBObject");
-		chai.add(fun([](AnnCollisionEvent e) { return e.getA()->getName(); }), "getAObjectName");
-		chai.add(fun([](AnnCollisionEvent e) { return e.getB()->getName(); }), "getBObjectName");
-		chai.add(fun([](AnnCollisionEvent e) -> Vector3 { return e.getPosition(); }), "getPosition");
-		chai.add(fun([](AnnCollisionEvent e) -> Vector3 { return e.getNormal(); }), "getNormal");
-		chai.add(fun([](AnnCollisionEvent e) { return e.isCeilingCollision(); }), "isCeilingCollision");
-		chai.add(fun([](AnnCollisionEvent e) { return e.isGroundCollision(); }), "isGroundCollision");
-		chai.add(fun([](AnnCollisionEvent e) { return e.isWallCollision(); }), "isWallCollision");
+		module->add(user_type<AnnHandController>(), "AnnHandController");
+		module->add(user_type<AnnHandControllerAxis>(), "AnnHandControllerAxis");
+		module->add(user_type<AnnHandController::AnnHandControllerSide>(), "AnnHandControllerSide");
+		module->add(user_type<AnnHandController::AnnHandControllerTypeHash>(), "AnnHandControllerTypeHash");
+		module->add(user_type<AnnHandController::AnnHandControllerGestureHash>(), "AnnHandControllerGestureHash");
+		module->add_global_const(const_var(AnnHandController::AnnHandControllerSide::leftHandController), "leftHandController");
+		module->add_global_const(const_var(AnnHandController::AnnHandControllerSide::rightHandController), "rightHandController");
+		module->add_global_const(const_var(AnnHandController::AnnHandControllerSide::invalidHandController), "invalidHandController");
+
+		module->add(fun([](const AnnHandControllerEvent& e) -> Vector3 { return e.getPosition(); }), "getPosition");
+		module->add(fun([](const AnnHandControllerEvent& e) -> Quaternion { return e.getOrientation(); }), "getOrientation");
+		module->add(fun([](const AnnHandControllerEvent& e) -> Vector3 { return e.getPointingDirection(); }), "getOrientation");
+		module->add(fun([](const AnnHandControllerEvent& e) -> Vector3 { return e.getLinearSpeed(); }), "getLinearSpeed");
+		module->add(fun([](const AnnHandControllerEvent& e) -> Vector3 { return e.getAngularSpeed(); }), "getAngularSpeed");
+		module->add(fun([](const AnnHandControllerEvent& e, const uint8_t id) { return e.getAxis(id); }), "getAxis");
+		module->add(fun([](const AnnHandControllerEvent& e) { return e.getAxisCount(); }), "getAxisCount");
+		module->add(fun([](const AnnHandControllerEvent& e) { return e.getButtonCount(); }), "getButtonCount");
+		module->add(fun([](const AnnHandControllerEvent& e, const uint8_t id) { return e.buttonPressed(id); }), "buttonPressed");
+		module->add(fun([](const AnnHandControllerEvent& e, const uint8_t id) { return e.buttonReleased(id); }), "buttonReleased");
+		module->add(fun([](const AnnHandControllerEvent& e, const uint8_t id) { return e.buttonState(id); }), "buttonState");
+		module->add(fun([](const AnnHandControllerEvent& e) { return e.getSide(); }), "getSide");
+		module->add(fun([](const AnnHandControllerEvent& e) { return e.getType(); }), "getType");
+
+		module->add(fun([](const AnnPlayerCollisionEvent& e) { return e.getObject(); }), "getObject");
+		module->add(fun([](const AnnPlayerCollisionEvent& e) { return e.getObjectHandle(); }), "getObjectHandle");
+		module->add(fun([](const AnnPlayerCollisionEvent& e) { return e.getObject() ? e.getObject()->getName() : string{}; }), "getObjectName");
+
+		module->add(fun([](const AnnCollisionEvent& e) { return e.getA(); }), "getAObject");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.getB(); }), "getBObject");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.getHandleA(); }), "getAObjectHandle");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.getHandleB(); }), "getBObjectHandle");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.getA() ? e.getA()->getName() : string{}; }), "getAObjectName");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.getB() ? e.getB()->getName() : string{}; }), "getBObjectName");
+		module->add(fun([](const AnnCollisionEvent& e) -> Vector3 { return e.getPosition(); }), "getPosition");
+		module->add(fun([](const AnnCollisionEvent& e) -> Vector3 { return e.getNormal(); }), "getNormal");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.isCeilingCollision(); }), "isCeilingCollision");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.isGroundCollision(); }), "isGroundCollision");
+		module->add(fun([](const AnnCollisionEvent& e) { return e.isWallCollision(); }), "isWallCollision");
 
 		//There's capacitive touch surfaces and haptic feedback that aren't available right now on the AnnHandController class
 
 		//Register an accessors to the engine's log
-		chai.add(fun([](const string& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
-		chai.add(fun([](const Vector3& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
-		chai.add(fun([](const Vector2& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
-		chai.add(fun([](const Quaternion& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
-		chai.add(fun([](const Radian& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
-		chai.add(fun([](const Degree& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
-		chai.add(fun([](const AnnColor& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
-		chai.add(fun([](KeyCode::code c) { AnnDebug() << logFromScript << "keycode:" << c; }), "AnnDebugLog");
-		chai.add(fun([](MouseAxisID c) { AnnDebug() << logFromScript << "mouseAxis:" << c; }), "AnnDebugLog");
-		chai.add(fun([](bool b) {string s("true"); if (!b) { s = "false"; } AnnDebug() << logFromScript << "bool:" << s; }), "AnnDebugLog");
-		chai.add(fun([](int i) { AnnDebug() << logFromScript << "int:" << i; }), "AnnDebugLog");
-		chai.add(fun([](float f) { AnnDebug() << logFromScript << "float:" << f; }), "AnnDebugLog");
+		module->add(fun([](const string& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
+		module->add(fun([](const Vector3& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
+		module->add(fun([](const Vector2& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
+		module->add(fun([](const Quaternion& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
+		module->add(fun([](const Radian& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
+		module->add(fun([](const Degree& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
+		module->add(fun([](const AnnColor& s) { AnnDebug() << logFromScript << s; }), "AnnDebugLog");
+		module->add(fun([](KeyCode::code c) { AnnDebug() << logFromScript << "keycode:" << c; }), "AnnDebugLog");
+		module->add(fun([](MouseAxisID c) { AnnDebug() << logFromScript << "mouseAxis:" << c; }), "AnnDebugLog");
+		module->add(fun([](bool b) {string s("true"); if (!b) { s = "false"; } AnnDebug() << logFromScript << "bool:" << s; }), "AnnDebugLog");
+		module->add(fun([](int i) { AnnDebug() << logFromScript << "int:" << i; }), "AnnDebugLog");
+		module->add(fun([](float f) { AnnDebug() << logFromScript << "float:" << f; }), "AnnDebugLog");
 
 		///Clear the console
-		chai.add(fun([]() { AnnGetOnScreenConsole()->bufferClear(); }), "AnnClearConsole");
-		chai.add(fun([]() { AnnEngine::setProcessPriorityHigh(); }), "AnnSetProcessPriorityHigh");
-		chai.add(fun([]() { AnnEngine::setProcessPriorityNormal(); }), "AnnSetProcessPriorityNormal");
+		module->add(fun([]() { AnnScriptDomain::runOnMainThread([] { AnnGetOnScreenConsole()->bufferClear(); }); }), "AnnClearConsole");
+		module->add(fun([]() { AnnEngine::setProcessPriorityHigh(); }), "AnnSetProcessPriorityHigh");
+		module->add(fun([]() { AnnEngine::setProcessPriorityNormal(); }), "AnnSetProcessPriorityNormal");
+
+		module->add(fun([]() { AnnScriptDomain::runOnMainThread([] { AnnGetEngine()->requestQuit(); }); }), "AnnQuit");
+		module->add(fun([](const float& multiplier) { AnnScriptDomain::runOnMainThread([=] { AnnGetPhysicsEngine()->setDebugDrawerColorMultiplier(multiplier); }); }), "AnnSetDebugDrawerColorMultiplier");
+		module->add(fun([](const float& ev, const float& minEv, const float& maxEv) { AnnScriptDomain::runOnMainThread([=] { AnnGetSceneryManager()->setExposure(ev, minEv, maxEv); }); }), "AnnSetExposure");
+		module->add(fun([](const float& threshold) { AnnScriptDomain::runOnMainThread([=] { AnnGetSceneryManager()->setBloomThreshold(threshold); }); }), "AnnSetBloomThreshold");
+		module->add(fun([](AnnColor& color, float& multiplier) { AnnScriptDomain::runOnMainThread([=] { AnnGetSceneryManager()->setSkyColor(color, multiplier); }); }), "AnnSetSkyColor");
+		module->add(fun([](const AnnColor& ucolor, const float umul, const AnnColor& lcolor, const float lmul, const Vector3& dir, const float envMapScaling) { AnnScriptDomain::runOnMainThread([=] { AnnGetSceneryManager()->setAmbientLight(ucolor, umul, lcolor, lmul, dir, envMapScaling); }); }), "AnnSetAmbientLight");
+
+		module->add(fun([](int AA) { AnnScriptDomain::runOnMainThread([=] { AnnOgreVRRenderer::setAntiAliasingLevel(uint8_t(AA)); }); }), "AnnSetAA");
+	}
 
-		chai.add(fun([]() { AnnGetEngine()->requestQuit(); }), "AnnQuit");
-		chai.add(fun([](const float& multiplier) { AnnGetPhysicsEngine()->setDebugDrawerColorMultiplier(multiplier); }), "AnnSetDebugDrawerColorMultiplier");
-		chai.add(fun([](const float& ev, const float& minEv, const float& maxEv) { AnnGetSceneryManager()->setExposure(ev, minEv, maxEv); }), "AnnSetExposure");
-		chai.add(fun([](const float& threshold) { AnnGetSceneryManager()->setBloomThreshold(threshold); }), "AnnSetBloomThreshold");
-		chai.add(fun([](AnnColor& color, float& multiplier) { AnnGetSceneryManager()->setSkyColor(color, multiplier); }), "AnnSetSkyColor");
-		chai.add(fun([](const AnnColor& ucolor, const float umul, const AnnColor& lcolor, const float lmul, const Vector3& dir, const float envMapScaling) { AnnGetSceneryManager()->setAmbientLight(ucolor, umul, lcolor, lmul, dir, envMapScaling); }), "AnnSetAmbientLight");
+	return module;
+}
 
-		chai.add(fun([](int AA) { AnnOgreVRRenderer::setAntiAliasingLevel(uint8_t(AA)); }), "AnnSetAA");
-	}
-	catch(const chaiscript::exception::name_conflict_error& e)
-	{
-		throw AnnInitializationError(ANN_ERR_NOTINIT, "Cannot initialize script manager. Trhowed exception when binding APIs:\n" + string(e.what()));
-	}
+chaiscript::ModulePtr AnnScriptManager::getApiModule()
+{
+	//Built once, on first use, and shared by every interpreter
+	static const auto module = [] {
+		const auto start = std::chrono::steady_clock::now();
+		auto builtModule = buildApiModule();
+		AnnDebug() << "Script API module built in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << "ms";
+		return builtModule;
+	}();
+
+	return module;
 }
 
-void AnnScriptManager::tryAndGetEventHooks()
+void AnnScriptManager::registerApi(chaiscript::ChaiScript& chai)
 {
-	//Forgive me.
+	const auto& module = getApiModule();
+	const auto start   = std::chrono::steady_clock::now();
 	try
 	{
-		callKeyEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnKeyEvent)>>("KeyEvent");
+		chai.add(module);
 	}
-	catch(const chaiscript::exception::eval_error&)
+	catch(const chaiscript::exception::name_conflict_error& e)
 	{
-		callKeyEventOnScriptInstance = nullptr;
+		throw AnnInitializationError(ANN_ERR_NOTINIT, "Cannot initialize script manager. Trhowed exception when binding APIs:\n" + std::string(e.what()));
 	}
+	AnnDebug() << "Script API module imported in " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << "ms";
+}
 
-	//Yes. I'm doing this.
-	try
-	{
-		callMouseEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnMouseEvent)>>("MouseEvent");
-	}
-	catch(const chaiscript::exception::eval_error&)
+std::string AnnScriptManager::getScriptFilePath(const AnnScriptFilePtr& scriptFile)
+{
+	for(auto location : Ogre::ResourceGroupManager::getSingleton().getResourceLocationList(scriptFile->getGroup()))
 	{
-		callMouseEventOnScriptInstance = nullptr;
-	}
+		auto archive = location->archive;
+		if(archive->getType() != "FileSystem") continue;
 
-	//Yes, there's 6 of them
-	try
-	{
-		callStickEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnControllerEvent)>>("ControllerEvent");
-	}
-	catch(const chaiscript::exception::eval_error&)
-	{
-		callStickEventOnScriptInstance = nullptr;
+		auto found = archive->find(scriptFile->getName(), location->recursive);
+		if(!found->empty()) return archive->getName() + "/" + found->front();
 	}
 
-	//And yes, it's probable that something will be thrown, unless a script already have this function
-	try
-	{
-		callTimeEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnTimeEvent)>>("TimeEvent");
-	}
-	catch(const chaiscript::exception::eval_error&)
-	{
-		callTimeEventOnScriptInstance = nullptr;
-	}
+	return {};
+}
 
-	//And it's also possible than the result is not usable with this script and will throw later at eval time
-	try
-	{
-		callTriggerEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnTriggerEvent)>>("TriggerEvent");
-	}
-	catch(const chaiscript::exception::eval_error&)
-	{
-		callTriggerEventOnScriptInstance = nullptr;
-	}
+void AnnScriptManager::watchScriptFile(const std::string& scriptName, const std::string& path)
+{
+	scriptFilePaths[path] = scriptName;
+	if(fileWatcher) fileWatcher->watch(path);
+}
 
-	//Like I said. Please forgive me.
-	try
+void AnnScriptManager::setHotReload(bool state)
+{
+	if(state == isHotReloadEnabled()) return;
+
+	if(!state)
 	{
-		callHandControllertOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnHandControllerEvent)>>("HandControllerEvent");
+		fileWatcher.reset();
+		return;
 	}
-	catch(const chaiscript::exception::eval_error&)
+
+	fileWatcher = std::make_unique<AnnScriptFileWatcher>();
+	for(const auto& scriptFile : scriptFilePaths)
+		fileWatcher->watch(scriptFile.first);
+}
+
+bool AnnScriptManager::isHotReloadEnabled() const
+{
+	return fileWatcher != nullptr;
+}
+
+void AnnScriptManager::update()
+{
+	if(fileWatcher)
+		for(const auto& path : fileWatcher->getModifiedFiles())
+		{
+			const auto script = scriptFilePaths.find(path);
+			if(script != scriptFilePaths.end())
+				reloadScript(script->second);
+		}
+
+	//Domains update in parallel. Nothing else touches the scene while they run
+	for(auto& domain : domains) domain.second->beginUpdate();
+	for(auto& domain : domains) domain.second->waitUpdate();
+	for(auto& domain : domains) domain.second->applyCommands();
+
+	mainDomain->endProfilingFrame();
+	for(auto& domain : domains) domain.second->endProfilingFrame();
+}
+
+namespace
+{
+	///Sort profiles by decreasing time spent in the last frame
+	void sortProfiles(std::vector<AnnScriptProfile>& profiles)
 	{
-		callHandControllertOnScriptInstance = nullptr;
+		std::sort(profiles.begin(), profiles.end(), [](const AnnScriptProfile& a, const AnnScriptProfile& b) { return a.lastFrameTime > b.lastFrameTime; });
 	}
-	try
+}
+
+std::vector<AnnScriptProfile> AnnScriptManager::getScriptProfiles() const
+{
+	//The same script class can live in multiple domains
+	std::unordered_map<std::string, AnnScriptProfile> merged;
+	const auto merge = [&](const AnnScriptDomainPtr& domain) {
+		for(const auto& classProfile : domain->getScriptProfiles())
+		{
+			auto& profile = merged[classProfile.first];
+			profile.name  = classProfile.first;
+			profile.instances += classProfile.second.instances;
+			profile.lastFrameTime += classProfile.second.lastFrameTime;
+			profile.peakFrameTime = std::max(profile.peakFrameTime, classProfile.second.peakFrameTime);
+			profile.totalTime += classProfile.second.totalTime;
+			profile.updateCalls += classProfile.second.updateCalls;
+			profile.eventCalls += classProfile.second.eventCalls;
+		}
+	};
+
+	merge(mainDomain);
+	for(const auto& domain : domains) merge(domain.second);
+
+	std::vector<AnnScriptProfile> profiles;
+	profiles.reserve(merged.size());
+	for(const auto& profile : merged) profiles.push_back(profile.second);
+	sortProfiles(profiles);
+	return profiles;
+}
+
+std::vector<AnnScriptProfile> AnnScriptManager::getScriptInstanceProfiles() const
+{
+	auto profiles = mainDomain->getScriptInstanceProfiles();
+	for(const auto& domain : domains)
 	{
-		callCollisionEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnCollisionEvent)>>("CollisionEvent");
+		const auto domainProfiles = domain.second->getScriptInstanceProfiles();
+		profiles.insert(profiles.end(), domainProfiles.begin(), domainProfiles.end());
 	}
-	catch(const chaiscript::exception::eval_error&)
+
+	sortProfiles(profiles);
+	return profiles;
+}
+
+bool AnnScriptManager::reloadScript(const std::string& scriptName)
+{
+	const auto file{ scriptName + scriptExtension };
+
+	auto rawScript = scriptFileManager->getResourceByName(file).staticCast<AnnScriptFile>();
+	if(!rawScript || !rawScript->loadedInChaiscriptInterpretor())
 	{
-		callCollisionEventOnScriptInstance = nullptr;
+		AnnDebug() << "Cannot reload " << file << ", it has not been loaded by the script manager";
+		return false;
 	}
-	try
+
+	AnnDebug() << "Reloading " << file;
+	rawScript->reload();
+
+	auto reloaded = false;
+	if(mainDomain->hasLoaded(scriptName))
+		reloaded = mainDomain->reloadScript(scriptName, rawScript->getSourceCode());
+	for(auto& domain : domains)
+		if(domain.second->hasLoaded(scriptName))
+			reloaded = domain.second->reloadScript(scriptName, rawScript->getSourceCode()) || reloaded;
+
+	return reloaded;
+}
+
+AnnScriptFilePtr AnnScriptManager::getScriptFile(const std::string& scriptName)
+{
+	const auto file{ scriptName + scriptExtension };
+
+	auto rawScript = scriptFileManager->getResourceByName(file).staticCast<AnnScriptFile>();
+	if(!rawScript)
 	{
-		callPlayerCollisionEventOnScriptInstance = chai.eval<std::function<void(chaiscript::Boxed_Value&, AnnPlayerCollisionEvent)>>("PlayerCollisionEvent");
+		rawScript = scriptFileManager->load(file, AnnResourceManager::getDefaultResourceGroupName());
+		if(!rawScript)
+			throw chaiscript::exception::file_not_found_error(file);
 	}
-	catch(const chaiscript::exception::eval_error&)
+
+	if(!rawScript->loadedInChaiscriptInterpretor())
 	{
-		callPlayerCollisionEventOnScriptInstance = nullptr;
+		rawScript->signalLoadedInChaiscript();
+
+		const auto path = getScriptFilePath(rawScript);
+		if(!path.empty()) watchScriptFile(scriptName, path);
 	}
+
+	return rawScript;
 }
 
-bool AnnScriptManager::evalFile(const std::string& file)
+std::shared_ptr<AnnBehaviorScript> AnnScriptManager::getBehaviorScript(const std::string& scriptName, AnnGameObject* owner)
 {
 	try
 	{
-		chai.eval_file(file);
+		return mainDomain->getBehaviorScript(getScriptFile(scriptName), scriptName, owner);
 	}
 	catch(const chaiscript::exception::file_not_found_error& fnfe)
 	{
-		AnnDebug() << fileErrorPrefix << fnfe.what();
-		return false;
+		AnnDebug() << "Cannot find behavior script " << scriptName << scriptExtension;
+		AnnDebug() << AnnScriptDomain::fileErrorPrefix << fnfe.what();
 	}
 	catch(const chaiscript::exception::eval_error& ee)
 	{
-		AnnDebug() << fileErrorPrefix << ee.pretty_print();
-		return false;
+		AnnDebug() << "Error during evaluation of behavior script " << scriptName << scriptExtension;
+		AnnDebug() << ee.pretty_print();
+		AnnTrace::scriptError(scriptName, ee.what());
 	}
-	return true;
-}
 
-AnnScriptManager::AnnScriptID AnnScriptManager::ID{ 0 };
+	//The user should test if this script is "valid" or not. And should not do it in a loop, obviously
+	return std::make_shared<AnnBehaviorScript>();
+}
 
-std::shared_ptr<AnnBehaviorScript> AnnScriptManager::getBehaviorScript(const std::string& scriptName, AnnGameObject* owner)
+std::shared_ptr<AnnBehaviorScript> AnnScriptManager::getBehaviorScript(const std::string& scriptName, AnnGameObject* owner, const std::string& domainName)
 {
-	auto file{ scriptName + scriptExtension };
-
 	try
 	{
-		//Evaluate the file containing the script class if unknown to ChaiScript yet
-
-		auto rawScript = scriptFileManager->getResourceByName(file).staticCast<AnnScriptFile>();
-		if(!rawScript)
-		{
-			rawScript = scriptFileManager->load(file, AnnResourceManager::getDefaultResourceGroupName());
-			if(!rawScript)
-				throw chaiscript::exception::file_not_found_error(file);
-		}
-
-		if(!rawScript->loadedInChaiscriptInterpretor())
-		{
-			AnnDebug() << "now loading " << file << " into the script manager";
-			rawScript->signalLoadedInChaiscript();
-			chai.eval(rawScript->getSourceCode());
-		}
-
-		//Increment ID
-		ID++;
-
-		//Get the name of the owner of this script, if relevant;
-		std::string ownerTag = owner ? owner->getName() : "";
-
-		//This may looks odd but it's good enough for what we're doing:
-		//Copy the template of the init code to a string
-		std::string ChaiCode{ scriptTemplate };
-
-		//To "boot" the script, there's a little sniped of ChaiScript that is run from the C++ side. This code is generated from a string,
-		//And contains a few fixed tags to be replaced with the script name and an unique ID
-		ChaiCode.replace(ChaiCode.find(std::string(scriptNameMarker)), nameMarkerLen, scriptName);
-		ChaiCode.replace(ChaiCode.find(std::string(scriptNameMarker)), nameMarkerLen, scriptName);
-		ChaiCode.replace(ChaiCode.find(std::string(scriptObjectID)), scriptIDMarkerLen, std::to_string(ID));
-		ChaiCode.replace(ChaiCode.find(std::string(scriptObjectID)), scriptIDMarkerLen, std::to_string(ID));
-		ChaiCode.replace(ChaiCode.find(std::string(scriptObjectID)), scriptIDMarkerLen, std::to_string(ID));
-
-		//This is the ugly bit, this will try to see if the methods functions have been declared somewhere. Note that this doesn't tell if a script has a specific method implemented.
-		//It just permit to know if "a function" with that name exist. Script themselve will deal with knowing if they own theses functions, by attempting to call them, and setting flags
-		//if exception occurs.
-		tryAndGetEventHooks();
-
-		//This will add a global function in ChaiScript, that will create and return the script instance
-		chai.eval(ChaiCode);
-		//Get a way to call this function
-		auto creatorFunction = chai.eval<std::function<chaiscript::Boxed_Value(std::string)>>("create" + scriptName + std::to_string(ID));
-
-		//Now we need to get some hook to call the update on the file
-		return std::make_shared<AnnBehaviorScript>(
-			scriptName,
-			//Function to call to update the script. Update is mandatory
-			chai.eval<std::function<void(chaiscript::Boxed_Value&)>>("update"),
-
-			//Eventual event hooks
-			tie(
-				callKeyEventOnScriptInstance,
-				callMouseEventOnScriptInstance,
-				callStickEventOnScriptInstance,
-				callTimeEventOnScriptInstance,
-				callTriggerEventOnScriptInstance,
-				callHandControllertOnScriptInstance,
-				callCollisionEventOnScriptInstance,
-				callPlayerCollisionEventOnScriptInstance),
-			//This return the ScriptInstance, as a Boxed_Value. We're only interested at calling something on
-			//this object, so don't need to try to unbox it. It's literally a black box for us
-			creatorFunction(ownerTag));
+		return getScriptDomain(domainName)->getBehaviorScript(getScriptFile(scriptName), scriptName, owner);
 	}
-
 	catch(const chaiscript::exception::file_not_found_error& fnfe)
 	{
-		AnnDebug() << "Cannot find behavior script " << file;
-		AnnDebug() << fileErrorPrefix << fnfe.what();
+		AnnDebug() << "Cannot find behavior script " << scriptName << scriptExtension;
+		AnnDebug() << AnnScriptDomain::fileErrorPrefix << fnfe.what();
 	}
 	catch(const chaiscript::exception::eval_error& ee)
 	{
-		AnnDebug() << "Error during evaluation of behavior script " << file;
+		AnnDebug() << "Error during evaluation of behavior script " << scriptName << scriptExtension << " in domain " << domainName;
 		AnnDebug() << ee.pretty_print();
+		AnnTrace::scriptError(scriptName, ee.what());
 	}
 
-	//The user should test if this script is "valid" or not. And should not do it in a loop, obviously
 	return std::make_shared<AnnBehaviorScript>();
 }
 
+AnnScriptDomainPtr AnnScriptManager::getScriptDomain(const std::string& domainName)
+{
+	auto& domain = domains[domainName];
+	if(!domain)
+	{
+		AnnDebug() << "Creating script domain " << domainName;
+		domain = std::make_shared<AnnScriptDomain>(domainName, true);
+		registerApi(*domain->_getEngine());
+	}
+
+	return domain;
+}
+
 AnnBehaviorScript::AnnBehaviorScript() :
  valid(false),
  cannotKey(false),
@@ -572,7 +672,10 @@ AnnBehaviorScript::AnnBehaviorScript() :
  cannotTrigger(false),
  cannotHand(false),
  cannotCollision{ false },
- cannotPlayerCollision{ false }
+ cannotPlayerCollision{ false },
+ frameTime{ 0 },
+ frameUpdateCalls{ 0 },
+ frameEventCalls{ 0 }
 {
 	AnnDebug() << "Invalid script object created";
 }
@@ -601,8 +704,12 @@ AnnBehaviorScript::AnnBehaviorScript(const std::string& scriptName,
  cannotTrigger{ false },
  cannotHand{ false },
  cannotCollision{ false },
- cannotPlayerCollision{ false }
+ cannotPlayerCollision{ false },
+ frameTime{ 0 },
+ frameUpdateCalls{ 0 },
+ frameEventCalls{ 0 }
 {
+	profile.name = name;
 }
 
 AnnBehaviorScript::~AnnBehaviorScript()
@@ -610,10 +717,77 @@ AnnBehaviorScript::~AnnBehaviorScript()
 	AnnDebug() << "Destructing " << name << "Script";
 }
 
+void AnnBehaviorScript::_hotSwap(std::function<void(chaiscript::Boxed_Value&)> updateHook,
+								 AnnBehaviorScriptHooks hooks,
+								 chaiscript::Boxed_Value scriptObjectInstance)
+{
+	ScriptObjectInstance						= scriptObjectInstance;
+	callUpdateOnScriptInstance					= updateHook;
+	callKeyEventOnScriptInstance				= std::get<KeyHook>(hooks);
+	callMouseEventOnScriptInstance				= std::get<MouseHook>(hooks);
+	callStickEventOnScriptInstance				= std::get<ControllerHook>(hooks);
+	callTimeEventOnScriptInstance				= std::get<TimeHook>(hooks);
+	callTriggerEventOnScriptInstance			= std::get<TriggerHook>(hooks);
+	callHandControllertOnScriptInstance			= std::get<HandHook>(hooks);
+	callCollisionEventOnScriptInstance			= std::get<CollisionHook>(hooks);
+	callPlayerCollisionEventOnScriptInstance	= std::get<PlayerCollisionHook>(hooks);
+
+	//The new definition may implement events the old one didn't have
+	cannotKey = cannotMouse = cannotStick = cannotTime = cannotTrigger = cannotHand = cannotCollision = cannotPlayerCollision = false;
+}
+
+chaiscript::Boxed_Value AnnBehaviorScript::_getScriptObjectInstance() const
+{
+	return ScriptObjectInstance;
+}
+
+const AnnScriptProfile& AnnBehaviorScript::getProfile() const
+{
+	return profile;
+}
+
+AnnScriptProfile AnnBehaviorScript::_endProfilingFrame()
+{
+	AnnScriptProfile frame;
+	frame.name			= name;
+	frame.instances		= 1;
+	frame.lastFrameTime = std::chrono::duration<double, std::milli>(frameTime).count();
+	frame.totalTime		= frame.lastFrameTime;
+	frame.peakFrameTime = frame.lastFrameTime;
+	frame.updateCalls	= frameUpdateCalls;
+	frame.eventCalls	= frameEventCalls;
+
+	profile.instances	  = 1;
+	profile.lastFrameTime = frame.lastFrameTime;
+	profile.peakFrameTime = std::max(profile.peakFrameTime, frame.lastFrameTime);
+	profile.totalTime += frame.lastFrameTime;
+	profile.updateCalls += frameUpdateCalls;
+	profile.eventCalls += frameEventCalls;
+
+	frameTime		 = std::chrono::steady_clock::duration{ 0 };
+	frameUpdateCalls = 0;
+	frameEventCalls	 = 0;
+
+	return frame;
+}
+
+void AnnBehaviorScript::setEnabled(bool state)
+{
+	enabled = state;
+}
+
+bool AnnBehaviorScript::isEnabled() const
+{
+	return enabled;
+}
+
 void AnnBehaviorScript::update()
 {
+	if(!enabled) return;
+
 	try
 	{
+		const ProfileScope measure(frameTime, frameUpdateCalls);
 		callUpdateOnScript();
 	}
 	catch(const chaiscript::exception::eval_error& ee)
@@ -622,6 +796,7 @@ void AnnBehaviorScript::update()
 				   << name
 				   << " script update - "
 				   << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 		//will not crash here.
 	}
 }
@@ -642,12 +817,15 @@ void AnnBehaviorScript::unregisterAsListener()
 	AnnGetEventManager()->removeListener(getSharedListener());
 }
 
-void AnnBehaviorScript::KeyEvent(AnnKeyEvent e)
+void AnnBehaviorScript::KeyEvent(const AnnKeyEvent& e)
 {
 	try
 	{
 		if(callKeyEventOnScriptInstance && !cannotKey)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callKeyEventOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -656,15 +834,19 @@ void AnnBehaviorScript::KeyEvent(AnnKeyEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
 
-void AnnBehaviorScript::MouseEvent(AnnMouseEvent e)
+void AnnBehaviorScript::MouseEvent(const AnnMouseEvent& e)
 {
 	try
 	{
 		if(callMouseEventOnScriptInstance && !cannotMouse)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callMouseEventOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -673,15 +855,19 @@ void AnnBehaviorScript::MouseEvent(AnnMouseEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
 
-void AnnBehaviorScript::ControllerEvent(AnnControllerEvent e)
+void AnnBehaviorScript::ControllerEvent(const AnnControllerEvent& e)
 {
 	try
 	{
 		if(callStickEventOnScriptInstance && !cannotStick)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callStickEventOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -690,15 +876,19 @@ void AnnBehaviorScript::ControllerEvent(AnnControllerEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
 
-void AnnBehaviorScript::TimeEvent(AnnTimeEvent e)
+void AnnBehaviorScript::TimeEvent(const AnnTimeEvent& e)
 {
 	try
 	{
 		if(callTimeEventOnScriptInstance && !cannotTime)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callTimeEventOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -707,15 +897,19 @@ void AnnBehaviorScript::TimeEvent(AnnTimeEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
 
-void AnnBehaviorScript::TriggerEvent(AnnTriggerEvent e)
+void AnnBehaviorScript::TriggerEvent(const AnnTriggerEvent& e)
 {
 	try
 	{
 		if(callTriggerEventOnScriptInstance && !cannotTrigger)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callTriggerEventOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -724,15 +918,19 @@ void AnnBehaviorScript::TriggerEvent(AnnTriggerEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
 
-void AnnBehaviorScript::HandControllerEvent(AnnHandControllerEvent e)
+void AnnBehaviorScript::HandControllerEvent(const AnnHandControllerEvent& e)
 {
 	try
 	{
 		if(callHandControllertOnScriptInstance && !cannotHand)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callHandControllertOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -741,15 +939,19 @@ void AnnBehaviorScript::HandControllerEvent(AnnHandControllerEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
 
-void AnnBehaviorScript::CollisionEvent(AnnCollisionEvent e)
+void AnnBehaviorScript::CollisionEvent(const AnnCollisionEvent& e)
 {
 	try
 	{
 		if(callCollisionEventOnScriptInstance && !cannotCollision)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callCollisionEventOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -758,15 +960,19 @@ void AnnBehaviorScript::CollisionEvent(AnnCollisionEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
-void AnnBehaviorScript::PlayerCollisionEvent(AnnPlayerCollisionEvent e)
+void AnnBehaviorScript::PlayerCollisionEvent(const AnnPlayerCollisionEvent& e)
 {
 	//AnnDebug() << "player collision on script...";
 	try
 	{
 		if(callPlayerCollisionEventOnScriptInstance && !cannotPlayerCollision)
+		{
+			const ProfileScope measure(frameTime, frameEventCalls);
 			callPlayerCollisionEventOnScriptInstance(ScriptObjectInstance, e);
+		}
 	}
 	catch(const chaiscript::exception::dispatch_error&)
 	{
@@ -775,12 +981,36 @@ void AnnBehaviorScript::PlayerCollisionEvent(AnnPlayerCollisionEvent e)
 	catch(const chaiscript::exception::eval_error& ee)
 	{
 		AnnDebug() << "Event script error " << ee.pretty_print();
+		AnnTrace::scriptError(name, ee.what());
 	}
 }
 
+bool AnnScriptManager::isNativeBehavior(const std::string& name) const
+{
+	return nativeBehaviors.find(name) != nativeBehaviors.end();
+}
+
+AnnNativeBehaviorPtr AnnScriptManager::createNativeBehavior(const std::string& name, AnnGameObject* owner)
+{
+	const auto pool = nativeBehaviors.find(name);
+	if(pool == nativeBehaviors.end()) return nullptr;
+	return pool->second->create(owner);
+}
+
+void AnnScriptManager::updateNativeBehaviors()
+{
+	for(auto& pool : nativeBehaviors)
+		pool.second->updateAll();
+}
+
+bool AnnScriptManager::evalFile(const std::string& file)
+{
+	return mainDomain->evalFile(file);
+}
+
 void AnnScriptManager::evalString(const std::string& chaiCode)
 {
-	chai.eval(chaiCode);
+	mainDomain->evalString(chaiCode);
 }
 
 void AnnScriptManager::registerResourceManager()
@@ -801,5 +1031,5 @@ AnnScriptManager::~AnnScriptManager()
 
 chaiscript::ChaiScript* AnnScriptManager::_getEngine()
 {
-	return &chai;
+	return mainDomain->_getEngine();
 }
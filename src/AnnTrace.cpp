@@ -0,0 +1,167 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "stdafx.h"
+#include "AnnTrace.hpp"
+#include "AnnLogger.hpp"
+
+#include <cstring>
+
+using namespace Annwvyn;
+
+std::atomic<bool> AnnTrace::recording{ false };
+std::mutex AnnTrace::mutex;
+std::ofstream AnnTrace::file;
+std::vector<char> AnnTrace::buffer;
+std::unordered_map<std::string, uint32_t> AnnTrace::strings;
+AnnTrace::TimePoint AnnTrace::startTime;
+uint64_t AnnTrace::frameCount{ 0 };
+
+namespace
+{
+	///The buffer is written to the file when it gets bigger than this
+	constexpr size_t bufferFlushSize{ 64 * 1024 };
+
+	///A record payload must fit in RecordHeader::size
+	constexpr size_t maxPayloadSize{ 0xFFFF };
+}
+
+bool AnnTrace::start(const std::string& fileName)
+{
+	stop();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	file.open(fileName, std::ios::binary | std::ios::trunc);
+	if(!file.is_open())
+	{
+		AnnDebug(AnnLogLevel::warning) << "Cannot open trace file " << fileName;
+		return false;
+	}
+
+	startTime  = now();
+	frameCount = 0;
+	strings.clear();
+	buffer.reserve(bufferFlushSize + 1024);
+
+	AnnTraceFormat::Header header{};
+	memcpy(header.magic, AnnTraceFormat::magic, sizeof header.magic);
+	header.version   = AnnTraceFormat::version;
+	header.startTime = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+	file.write(reinterpret_cast<const char*>(&header), sizeof header);
+
+	recording = true;
+	AnnDebug() << "Recording a performance trace to " << fileName;
+	return true;
+}
+
+void AnnTrace::stop()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!recording) return;
+
+	recording = false;
+	writeBuffer();
+	file.close();
+	strings.clear();
+	AnnDebug() << "Performance trace stopped after " << frameCount << " frames";
+}
+
+void AnnTrace::frameBegin()
+{
+	if(!isRecording()) return;
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!recording) return;
+
+	append(AnnTraceFormat::frameBegin, AnnTraceFormat::FrameRecord{ toTraceTime(now()), frameCount++ });
+}
+
+void AnnTrace::frameEnd()
+{
+	if(!isRecording()) return;
+	std::lock_guard<std::mutex> lock(mutex);
+	//The trace may have started during this frame
+	if(!recording || frameCount == 0) return;
+
+	append(AnnTraceFormat::frameEnd, AnnTraceFormat::FrameRecord{ toTraceTime(now()), frameCount - 1 });
+
+	//Only touch the file between frames
+	if(buffer.size() >= bufferFlushSize) writeBuffer();
+}
+
+void AnnTrace::subsystem(const std::string& name, TimePoint start, TimePoint end)
+{
+	if(!isRecording()) return;
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!recording) return;
+
+	append(AnnTraceFormat::subsystem, AnnTraceFormat::SubsystemRecord{ toTraceTime(start), toDuration(start, end), intern(name) });
+}
+
+void AnnTrace::levelPhase(const std::string& level, AnnTraceFormat::LevelPhase phase)
+{
+	if(!isRecording()) return;
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!recording) return;
+
+	append(AnnTraceFormat::levelPhase, AnnTraceFormat::LevelPhaseRecord{ toTraceTime(now()), intern(level), phase });
+}
+
+void AnnTrace::resourceLoad(const std::string& name, const std::string& group, uint32_t kind, uint64_t bytes, TimePoint start, TimePoint end)
+{
+	if(!isRecording()) return;
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!recording) return;
+
+	append(AnnTraceFormat::resourceLoad, AnnTraceFormat::ResourceLoadRecord{ toTraceTime(start), bytes, toDuration(start, end), intern(name), intern(group), kind });
+}
+
+void AnnTrace::scriptError(const std::string& script, const std::string& message)
+{
+	if(!isRecording()) return;
+	std::lock_guard<std::mutex> lock(mutex);
+	if(!recording) return;
+
+	append(AnnTraceFormat::scriptError, AnnTraceFormat::ScriptErrorRecord{ toTraceTime(now()), intern(script), intern(message) });
+}
+
+uint64_t AnnTrace::toTraceTime(TimePoint time)
+{
+	if(time < startTime) return 0;
+	return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(time - startTime).count());
+}
+
+uint32_t AnnTrace::toDuration(TimePoint start, TimePoint end)
+{
+	const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	return uint32_t(std::min<decltype(duration)>(std::max<decltype(duration)>(duration, 0), 0xFFFFFFFF));
+}
+
+uint32_t AnnTrace::intern(const std::string& text)
+{
+	const auto known = strings.find(text);
+	if(known != strings.end()) return known->second;
+
+	const auto id = uint32_t(strings.size());
+	strings.emplace(text, id);
+
+	const AnnTraceFormat::StringRecord record{ id };
+	append(AnnTraceFormat::string, &record, sizeof record, text.data(), std::min(text.size(), maxPayloadSize - sizeof record));
+	return id;
+}
+
+void AnnTrace::append(AnnTraceFormat::RecordType type, const void* payload, size_t size, const void* extra, size_t extraSize)
+{
+	const AnnTraceFormat::RecordHeader header{ type, uint16_t(size + extraSize) };
+
+	const auto offset = buffer.size();
+	buffer.resize(offset + sizeof header + size + extraSize);
+	memcpy(&buffer[offset], &header, sizeof header);
+	memcpy(&buffer[offset + sizeof header], payload, size);
+	if(extraSize) memcpy(&buffer[offset + sizeof header + size], extra, extraSize);
+}
+
+void AnnTrace::writeBuffer()
+{
+	file.write(buffer.data(), std::streamsize(buffer.size()));
+	file.flush();
+	buffer.clear();
+}
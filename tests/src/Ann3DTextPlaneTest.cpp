@@ -1,5 +1,9 @@
 #include "stdafx.h"
 #include "engineBootstrap.hpp"
+#include "AnnGlyphAtlas.hpp"
+#include "AnnDistanceFieldFont.hpp"
+
+#include <Overlay/OgreFontManager.h>
 
 namespace Annwvyn
 {
@@ -18,4 +22,92 @@ namespace Annwvyn
 			GameEngine->refresh();
 		}
 	}
+
+	TEST_CASE("Glyph blending")
+	{
+		//Opaque text replaces the pixel, transparent text leaves it untouched
+		std::vector<uint8_t> pixels{ 10, 20, 30, 40, 10, 20, 30, 40 };
+		const std::vector<uint8_t> coverage{ 255, 0 };
+		const uint32_t color{ 0xFFFFFFFF };
+		AnnGlyphAtlas::blendRow(pixels.data(), coverage.data(), 2, color, 255);
+		REQUIRE(pixels == std::vector<uint8_t>{ 255, 255, 255, 255, 10, 20, 30, 40 });
+
+		//The vectorized path gives the same result as the scalar one, for any width
+		std::vector<uint8_t> vectorized(4 * 37), scalar, rowCoverage(37);
+		for(size_t i{ 0 }; i < vectorized.size(); ++i) vectorized[i] = uint8_t(i * 7);
+		for(size_t i{ 0 }; i < rowCoverage.size(); ++i) rowCoverage[i] = uint8_t(i * 13);
+		scalar = vectorized;
+
+		for(size_t count{ 0 }; count <= rowCoverage.size(); ++count)
+		{
+			AnnGlyphAtlas::blendRow(vectorized.data(), rowCoverage.data(), count, 0x80402010, 200);
+			AnnGlyphAtlas::blendRowScalar(scalar.data(), rowCoverage.data(), count, 0x80402010, 200);
+			REQUIRE(vectorized == scalar);
+		}
+	}
+
+	TEST_CASE("Glyph atlas is built once per font")
+	{
+		auto GameEngine = bootstrapTestEngine("Test3DTextPlane");
+
+		auto textPlane = std::make_shared<Ann3DTextPlane>(2.0f, 1.5f, "Atlas", 200, 50.f, "SomeFont");
+		textPlane->update();
+
+		auto font		  = Ogre::FontManager::getSingleton().getByName("SomeFont").staticCast<Ogre::Font>();
+		const auto& atlas = AnnGlyphAtlas::get(font.getPointer());
+		REQUIRE(&AnnGlyphAtlas::get(font.getPointer()) == &atlas);
+		REQUIRE(atlas.getGlyph('A').width > 0);
+		REQUIRE(atlas.getGlyph('A').height > 0);
+
+		AnnGlyphAtlas::clearCache();
+	}
+
+	TEST_CASE("Signed distance field of a glyph")
+	{
+		//A 4x4 square in a 8x8 glyph
+		const size_t size{ 8 };
+		const uint16_t spread{ 4 };
+		std::vector<uint8_t> coverage(size * size, 0);
+		for(size_t y{ 2 }; y < 6; ++y)
+			for(size_t x{ 2 }; x < 6; ++x)
+				coverage[y * size + x] = 255;
+
+		const auto fieldSize = size + 2 * spread;
+		std::vector<uint8_t> field(fieldSize * fieldSize);
+		AnnDistanceFieldFont::computeDistanceField(coverage.data(), size, size, spread, field.data());
+
+		const auto at = [&](size_t x, size_t y) { return field[(y + spread) * fieldSize + x + spread]; };
+		REQUIRE(at(3, 3) > 128);
+		REQUIRE(at(2, 3) > 128);
+		REQUIRE(at(1, 3) < 128);
+		REQUIRE(at(3, 3) > at(2, 3));
+		REQUIRE(field[0] == 0);
+	}
+
+	TEST_CASE("Distance field text plane")
+	{
+		auto GameEngine = bootstrapTestEngine("Test3DTextPlane");
+
+		auto textPlane = std::make_shared<Ann3DTextPlane>(2.0f, 1.5f, "Score : 0", 200, 50.f, "SomeFont", "VeraMono.ttf", Ann3DTextPlane::RENDER_DISTANCE_FIELD);
+		REQUIRE(textPlane->getRenderMode() == Ann3DTextPlane::RENDER_DISTANCE_FIELD);
+		textPlane->setBackgroundColor(AnnColor{ 0, 0, 0, 0.5f });
+		textPlane->setPosition(AnnVect3{ 0, 1.5, 8 });
+		textPlane->setAutoUpdate(true);
+
+		//Changing the caption only rewrites the glyph quads, the buffer grows when the text gets longer
+		const auto capacity = textPlane->getGlyphCapacity();
+		for(auto i{ 0 }; i < 60; ++i)
+		{
+			textPlane->setCaption("Score : " + std::to_string(i));
+			GameEngine->refresh();
+		}
+		REQUIRE(textPlane->getGlyphCapacity() == capacity);
+
+		textPlane->setCaption(std::string(40, 'W'));
+		REQUIRE(textPlane->getGlyphCapacity() > capacity);
+		GameEngine->refresh();
+
+		textPlane.reset();
+		AnnDistanceFieldFont::clearCache();
+	}
 }
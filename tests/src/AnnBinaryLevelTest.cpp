@@ -0,0 +1,162 @@
+#include <stdafx.h>
+#include <engineBootstrap.hpp>
+#include "AnnBinaryLevel.hpp"
+#include "AnnChunkedLevel.hpp"
+
+#include <fstream>
+
+namespace Annwvyn
+{
+	TEST_CASE("Compile and load a binary level")
+	{
+		auto GameEngine = bootstrapEmptyEngine("BinaryLevel");
+
+		const auto compiled = AnnBinaryLevel::compile(R"JSON(
+{
+	"name":"BinaryTestLevel",
+
+	"player":{
+		"startPosition":[0.0, 0.0, 10.0],
+		"startOrientation":[0.0, 0.0, 0.0, 1.0]
+	},
+
+	"content" : [{
+		"name":"Sinbad",
+		"mesh":"Sinbad.mesh",
+		"position":[0.0, 1.0, 0.0],
+		"orientation":[0.0, 0.0, 0.0, 1.0],
+		"scale":[0.5, 0.5, 0.5],
+		"hasPhysics":false,
+		"scripts":["GoUpBehavior"]
+	},
+	{
+		"name":"Floor",
+		"mesh":"floorplane.mesh",
+		"position":[0.0, 0.0, 0.0],
+		"orientation":[0.0, 0.0, 0.0, 1.0],
+		"scale":[1.0, 1.0, 1.0],
+		"hasPhysics":true,
+		"physics" : {
+			"shape":"static",
+			"mass":0,
+			"playerColide":true
+		},
+		"scripts":null
+	}],
+
+	"lighting":[{
+		"name":"sun",
+		"type":"directional",
+		"power":97,
+		"direction":[-1.0, -1.5, -1.0]
+	}],
+
+	"instances":[{
+		"name":"penguinCrowd",
+		"mesh":"penguin.mesh",
+		"transforms":[
+			{ "position":[-2, 1.5, -2], "scale":[0.1, 0.1, 0.1] },
+			{ "position":[-1, 1.5, -2], "orientation":[0, 1, 0, 0] }
+		]
+	}]
+}
+)JSON");
+
+		REQUIRE(compiled.size() > sizeof(AnnBinaryLevelFormat::Header));
+
+		const std::string path{ "./BinaryTestLevel.annlevel" };
+		std::ofstream(path, std::ios::binary).write(compiled.data(), compiled.size());
+
+		SECTION("Load the compiled level")
+		{
+			AnnGetResourceManager()->addFileLocation("./unitTestScripts");
+			AnnGetResourceManager()->initResources();
+
+			auto LevelManager = AnnGetLevelManager();
+			LevelManager->addLevel<AnnBinaryLevel>(path);
+			LevelManager->switchToFirstLoadedLevel();
+
+			for(auto i{ 0 }; i < 60; ++i)
+				if(!GameEngine->refresh())
+					break;
+
+			auto sinbad = AnnGetGameObjectManager()->getGameObject("Sinbad");
+			REQUIRE(sinbad);
+			REQUIRE(sinbad->getPosition().y > 1);
+			REQUIRE(AnnGetGameObjectManager()->getGameObject("Floor"));
+			REQUIRE(LevelManager->getCurrentLevel()->getContent().size() == 2);
+			REQUIRE(LevelManager->getCurrentLevel()->getLights().size() == 1);
+
+			const auto& instancedMeshes = LevelManager->getCurrentLevel()->getInstancedMeshes();
+			REQUIRE(instancedMeshes.size() == 1);
+			REQUIRE(instancedMeshes.front()->size() == 2);
+			REQUIRE(instancedMeshes.front()->isStatic());
+			REQUIRE(instancedMeshes.front()->getTransform(1).scale == AnnVect3::UNIT_SCALE);
+		}
+
+		SECTION("Refuse a truncated file")
+		{
+			const std::string truncatedPath{ "./TruncatedTestLevel.annlevel" };
+			std::ofstream(truncatedPath, std::ios::binary).write(compiled.data(), compiled.size() / 2);
+			REQUIRE_THROWS_AS(AnnBinaryLevel(truncatedPath), AnnInitializationError);
+		}
+	}
+
+	TEST_CASE("Stream the cells of a chunked level")
+	{
+		auto GameEngine = bootstrapEmptyEngine("ChunkedLevel");
+
+		const auto compiled = AnnBinaryLevel::compile(R"JSON(
+{
+	"name":"ChunkedTestLevel",
+	"cellSize":10,
+
+	"player":{
+		"startPosition":[0.0, 0.0, 0.0],
+		"startOrientation":[0.0, 0.0, 0.0, 1.0]
+	},
+
+	"content" : [{
+		"name":"Far",
+		"mesh":"Sinbad.mesh",
+		"position":[101.0, 0.0, 1.0],
+		"orientation":[0.0, 0.0, 0.0, 1.0],
+		"scale":[1.0, 1.0, 1.0],
+		"hasPhysics":false
+	},
+	{
+		"name":"Near",
+		"mesh":"Sinbad.mesh",
+		"position":[1.0, 0.0, 1.0],
+		"orientation":[0.0, 0.0, 0.0, 1.0],
+		"scale":[1.0, 1.0, 1.0],
+		"hasPhysics":false
+	}]
+}
+)JSON");
+
+		const std::string path{ "./ChunkedTestLevel.annlevel" };
+		std::ofstream(path, std::ios::binary).write(compiled.data(), compiled.size());
+
+		auto LevelManager	  = AnnGetLevelManager();
+		auto gameObjectManager = AnnGetGameObjectManager();
+		auto level			  = LevelManager->addLevel<AnnChunkedLevel>(path, 20.0f, 30.0f, 4);
+		LevelManager->switchToFirstLoadedLevel();
+
+		for(auto i{ 0 }; i < 5; ++i)
+			GameEngine->refresh();
+
+		REQUIRE(gameObjectManager->getGameObject("Near"));
+		REQUIRE_FALSE(gameObjectManager->getGameObject("Far"));
+		REQUIRE(level->getContent().size() == 1);
+
+		AnnGetPlayer()->setPosition({ 100, 0, 0 });
+		for(auto i{ 0 }; i < 5; ++i)
+			GameEngine->refresh();
+
+		REQUIRE(gameObjectManager->getGameObject("Far"));
+		REQUIRE_FALSE(gameObjectManager->getGameObject("Near"));
+		REQUIRE(level->getLoadedCellCount() == 1);
+		REQUIRE(level->getPendingCellCount() == 0);
+	}
+}
@@ -0,0 +1,32 @@
+#include "stdafx.h"
+#include "engineBootstrap.hpp"
+
+namespace Annwvyn
+{
+	TEST_CASE("Console scrolls while logging every frame")
+	{
+		auto GameEngine = bootstrapTestEngine("ConsoleTest");
+		auto console	= AnnGetOnScreenConsole();
+		console->setVisible(true);
+
+		//One line per frame, then several per frame, then more than the console can show in one frame
+		for(auto i{ 0 }; i < 60; ++i)
+		{
+			AnnDebug() << "Line " << i;
+			GameEngine->refresh();
+		}
+
+		for(auto i{ 0 }; i < 20; ++i)
+		{
+			for(auto j{ 0 }; j < 3; ++j) AnnDebug() << "Frame " << i << " line " << j;
+			GameEngine->refresh();
+		}
+
+		for(auto i{ 0 }; i < 2 * AnnConsole::CONSOLE_BUFFER + 1; ++i) AnnDebug() << "Burst " << i;
+		GameEngine->refresh();
+
+		console->bufferClear();
+		GameEngine->refresh();
+		console->setVisible(false);
+	}
+}
@@ -35,6 +35,196 @@ namespace Annwvyn
 		for(auto i = 0; i < 60; ++i) GameEngine->refresh();
 	}
 
+	TEST_CASE("Game object recycling")
+	{
+		auto GameEngine = bootstrapTestEngine("GameObjectManagerTest");
+
+		auto manager = AnnGetGameObjectManager();
+		manager->setObjectRecycling(true);
+
+		Ogre::SceneNode* node{ nullptr };
+		{
+			auto object = manager->createGameObject("Sinbad.mesh", "Sinbad");
+			object->setPosition({ 1, 2, 3 });
+			node = object->getNode();
+			manager->removeGameObject(object);
+		}
+
+		REQUIRE(manager->getRecycledObjectCount() == 1);
+
+		//Another mesh doesn't take it
+		auto floor = manager->createGameObject("floorplane.mesh", "Floor");
+		REQUIRE(manager->getRecycledObjectCount() == 1);
+
+		auto recycled = manager->createGameObject("Sinbad.mesh", "RecycledSinbad");
+		REQUIRE(manager->getRecycledObjectCount() == 0);
+		REQUIRE(recycled->getNode() == node);
+		REQUIRE(recycled->getPosition() == AnnVect3::ZERO);
+		REQUIRE(recycled->getMeshName() == "Sinbad.mesh");
+
+		for(auto i = 0; i < 10; ++i) GameEngine->refresh();
+
+		manager->setObjectRecycling(false);
+	}
+
+	TEST_CASE("Game object handles")
+	{
+		auto GameEngine = bootstrapTestEngine("GameObjectManagerTest");
+		auto manager	= AnnGetGameObjectManager();
+
+		auto object		 = manager->createGameObject("Sinbad.mesh", "Sinbad");
+		const auto handle = object->getHandle();
+
+		REQUIRE(handle.isValid());
+		REQUIRE(handle.get() == object.get());
+		REQUIRE(manager->getGameObjectHandle("Sinbad") == handle);
+		REQUIRE(handle.lock() == object);
+
+		manager->removeGameObject(handle);
+		REQUIRE_FALSE(handle.isValid());
+		REQUIRE(handle.get() == nullptr);
+		REQUIRE_FALSE(manager->getGameObject("Sinbad"));
+		REQUIRE_THROWS_AS(handle->getName(), AnnNullGameObjectError);
+
+		//A new object in the same slot doesn't answer to the old handle
+		auto other = manager->createGameObject("Sinbad.mesh", "Sinbad");
+		REQUIRE(other->getHandle().getSlot().index == handle.getSlot().index);
+		REQUIRE(other->getHandle() != handle);
+		REQUIRE(handle.get() == nullptr);
+	}
+
+	TEST_CASE("Prefab spawn and despawn")
+	{
+		auto GameEngine = bootstrapTestEngine("GameObjectManagerTest");
+		auto manager	= AnnGetGameObjectManager();
+
+		AnnPrefab crate;
+		crate.mesh		 = "Sinbad.mesh";
+		crate.hasPhysics = true;
+		crate.mass		 = 1;
+		crate.shape		 = convexShape;
+		manager->registerPrefab("crate", crate, 4);
+		REQUIRE_THROWS_AS(manager->registerPrefab("crate", crate), AnnInitializationError);
+		REQUIRE_THROWS_AS(manager->spawn("barrel", AnnVect3::ZERO), AnnInitializationError);
+
+		const auto pool = manager->getPrefabPool("crate");
+		REQUIRE(pool);
+		REQUIRE(pool->getAvailableCount() == 4);
+		REQUIRE(pool->getActiveCount() == 0);
+
+		//Preallocated instances are not in the game
+		auto object = manager->spawn("crate", { 0, 5, -5 });
+		REQUIRE(object->isActive());
+		REQUIRE(object->getPosition() == AnnVect3(0, 5, -5));
+		REQUIRE(object->getHandle().isValid());
+		REQUIRE(manager->getGameObject(object->getName()) == object);
+		REQUIRE(pool->getActiveCount() == 1);
+
+		for(auto i = 0; i < 30; ++i) GameEngine->refresh();
+
+		const auto handle = object->getHandle();
+		manager->despawn(object);
+		REQUIRE_FALSE(object->isActive());
+		REQUIRE_FALSE(handle.isValid());
+		REQUIRE_FALSE(manager->getGameObject(object->getName()));
+		REQUIRE(pool->getAvailableCount() == 4);
+
+		//The same instance comes back, at it's new place
+		auto again = manager->spawn("crate", { 2, 5, -5 });
+		REQUIRE(again == object);
+		REQUIRE(again->getPosition() == AnnVect3(2, 5, -5));
+
+		//The pool grows when every instance is used
+		std::vector<AnnGameObjectPtr> spawned;
+		for(auto i = 0; i < 5; ++i) spawned.push_back(manager->spawn("crate", AnnVect3::ZERO));
+		REQUIRE(pool->getActiveCount() == 6);
+		REQUIRE(pool->getAvailableCount() == 0);
+
+		//Removing an instance gives it back to the pool
+		manager->removeGameObject(spawned.back());
+		REQUIRE(pool->getAvailableCount() == 1);
+
+		for(auto i = 0; i < 30; ++i) GameEngine->refresh();
+	}
+
+	TEST_CASE("Instanced meshes")
+	{
+		auto GameEngine = bootstrapTestEngine("GameObjectManagerTest");
+		auto manager	= AnnGetGameObjectManager();
+
+		for(const auto isStatic : { true, false })
+		{
+			auto crowd = manager->createInstancedMesh("Sinbad.mesh", "crowd", isStatic);
+			REQUIRE(manager->getInstancedMesh("crowd") == crowd);
+			REQUIRE(crowd->isStatic() == isStatic);
+
+			for(auto i = 0; i < 100; ++i)
+			{
+				AnnInstanceTransform transform;
+				transform.position = { float(i % 10), 0, -float(i / 10) };
+				crowd->addInstance(transform);
+			}
+			REQUIRE(crowd->size() == 100);
+
+			for(auto i = 0; i < 10; ++i) GameEngine->refresh();
+
+			//Move every instance from the buffer
+			const auto transforms = crowd->getTransforms();
+			for(size_t i{ 0 }; i < crowd->size(); ++i)
+				transforms[i].position.y += 1;
+			crowd->markDirty(0, crowd->size());
+
+			//The last instance takes the place of a removed one
+			const auto last = crowd->getTransform(99).position;
+			crowd->removeInstance(10);
+			REQUIRE(crowd->size() == 99);
+			REQUIRE(crowd->getTransform(10).position == last);
+
+			for(auto i = 0; i < 10; ++i) GameEngine->refresh();
+
+			manager->removeInstancedMesh(crowd);
+			REQUIRE_FALSE(manager->getInstancedMesh("crowd"));
+		}
+	}
+
+	TEST_CASE("Mesh conversion cache")
+	{
+		auto GameEngine = bootstrapTestEngine("GameObjectManagerTest");
+
+		//FNV-1a reference values
+		REQUIRE(AnnMeshCache::hash("", 0) == AnnMeshCache::hashSeed);
+		REQUIRE(AnnMeshCache::hash("a", 1) == 0xaf63dc4c8601ec8cull);
+		REQUIRE(AnnMeshCache::hash("bar", 3, AnnMeshCache::hash("foo", 3)) == AnnMeshCache::hash("foobar", 6));
+
+		AnnFilesystemManager::createDirectory("./MeshCacheTest");
+		AnnMeshCache cache("./MeshCacheTest");
+		const auto group = AnnResourceManager::getDefaultResourceGroupName();
+		const AnnMeshCache::ImportFlags flags{ true, true, true };
+
+		//The cache may already be filled by a previous run
+		auto mesh			   = cache.load("penguin.mesh", "penguinCacheTest", group, flags);
+		const auto subMeshCount = mesh->getNumSubMeshes();
+		REQUIRE(subMeshCount > 0);
+		REQUIRE(cache.getHitCount() + cache.getMissCount() == 1);
+		REQUIRE_FALSE(Ogre::v1::MeshManager::getSingleton().getByName("penguin.mesh"));
+
+		//The second load comes from the disk
+		Ogre::MeshManager::getSingleton().remove(mesh->getHandle());
+		mesh.setNull();
+		const auto hits = cache.getHitCount();
+		mesh			= cache.load("penguin.mesh", "penguinCacheTest", group, flags);
+		REQUIRE(cache.getHitCount() == hits + 1);
+		REQUIRE(mesh->getNumSubMeshes() == subMeshCount);
+
+		//Other conversion parameters don't share the cached file
+		Ogre::MeshManager::getSingleton().remove(mesh->getHandle());
+		mesh.setNull();
+		const auto misses = cache.getMissCount();
+		mesh			  = cache.load("penguin.mesh", "penguinCacheTest", group, { false, false, false });
+		REQUIRE(cache.getMissCount() == misses + 1);
+		Ogre::MeshManager::getSingleton().remove(mesh->getHandle());
+	}
+
 	TEST_CASE("Light Object name storage")
 	{
 		//Init
@@ -0,0 +1,85 @@
+#include "stdafx.h"
+#include "engineBootstrap.hpp"
+#include "AnnInputRecorder.hpp"
+#include "AnnInputReplay.hpp"
+
+namespace Annwvyn
+{
+	TEST_CASE("Record and read back input")
+	{
+		auto GameEngine = bootstrapEmptyEngine("InputRecordingTest");
+		const std::string recordingFile{ "InputRecordingTest.anninput" };
+
+		SECTION("Frames recorded by the event manager")
+		{
+			REQUIRE(AnnGetEventManager()->startInputRecording(recordingFile));
+			REQUIRE(AnnGetEventManager()->isRecordingInput());
+			REQUIRE_FALSE(AnnGetEventManager()->isReplayingInput());
+
+			for(auto i{ 0 }; i < 3; ++i) GameEngine->refresh();
+
+			//The engine time doesn't move during a recorded frame
+			double clock;
+			REQUIRE(AnnGetEventManager()->getRecordedClock(clock));
+			const auto time = GameEngine->getTimeFromStartUp();
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			REQUIRE(GameEngine->getTimeFromStartUp() == time);
+
+			AnnGetEventManager()->stopInputRecording();
+			REQUIRE_FALSE(AnnGetEventManager()->isRecordingInput());
+
+			AnnInputReplay replay;
+			REQUIRE(replay.open(recordingFile));
+
+			uint32_t frames{ 0 };
+			while(replay.nextFrame())
+			{
+				REQUIRE(replay.getFrame().frame == frames++);
+				REQUIRE(replay.getFrame().delta >= 0);
+				REQUIRE(replay.getFrame().time > 0);
+			}
+			REQUIRE(frames == 3);
+			REQUIRE(replay.isFinished());
+		}
+
+		SECTION("Input changes come back in their frame")
+		{
+			AnnInputRecorder recorder;
+			REQUIRE(recorder.start(recordingFile));
+
+			const AnnPose head{ { 1, 2, 3 }, AnnQuaternion::IDENTITY };
+			const std::array<AnnHandControllerPtr, MAX_CONTROLLER_NUMBER> noHands{};
+
+			recorder.frame(0.01, 1.0, head, noHands);
+			recorder.input({ AnnInputSample::key, true, 0, uint32_t(KeyCode::a), 'a', {}, {} }, 1.995);
+			recorder.input({ AnnInputSample::stickAxis, false, 1, 2, 0, { 1000, -50 }, {} }, 2.0);
+			recorder.frame(0.02, 2.0, head, noHands);
+			recorder.stop();
+
+			AnnInputReplay replay;
+			REQUIRE(replay.open(recordingFile));
+
+			REQUIRE(replay.nextFrame());
+			REQUIRE(replay.getInputs().empty());
+			REQUIRE(replay.getFrame().headPosition[1] == 2);
+			REQUIRE(replay.getFrame().time == 1.0);
+
+			REQUIRE(replay.nextFrame());
+			REQUIRE(replay.getFrame().delta == 0.02);
+			REQUIRE(replay.getFrame().time == 2.0);
+			const auto& inputs = replay.getInputs();
+			REQUIRE(inputs.size() == 2);
+			REQUIRE(inputs[0].sample.kind == AnnInputSample::key);
+			REQUIRE(inputs[0].sample.pressed);
+			REQUIRE(inputs[0].sample.text == 'a');
+			REQUIRE(inputs[0].age == Approx(0.005f));
+			REQUIRE(inputs[1].sample.kind == AnnInputSample::stickAxis);
+			REQUIRE(inputs[1].sample.stick == 1);
+			REQUIRE(inputs[1].sample.values[0] == 1000);
+			REQUIRE(inputs[1].sample.values[1] == -50);
+
+			REQUIRE_FALSE(replay.nextFrame());
+			REQUIRE(replay.isFinished());
+		}
+	}
+}
@@ -75,6 +75,17 @@ namespace Annwvyn
 		"position":[0,1,1],
 		"power":50
 
+	}],
+
+	"instances":[{
+		"name":"penguinCrowd",
+		"mesh":"penguin.mesh",
+		"static":true,
+		"transforms":[
+			{ "position":[-3, 1.5, -2], "scale":[0.1, 0.1, 0.1] },
+			{ "position":[-2, 1.5, -2], "scale":[0.1, 0.1, 0.1] },
+			{ "position":[-1, 1.5, -2], "orientation":[0, 1, 0, 0], "scale":[0.1, 0.1, 0.1] }
+		]
 	}]
 
 }
@@ -86,5 +97,10 @@ namespace Annwvyn
 		for(auto i{ 0 }; i < 3 * 60; ++i)
 			if(!GameEngine->refresh())
 				break;
+
+		const auto crowd = AnnGetGameObjectManager()->getInstancedMesh("penguinCrowd");
+		REQUIRE(crowd);
+		REQUIRE(crowd->size() == 3);
+		REQUIRE(crowd->isStatic());
 	}
 }
@@ -174,4 +174,75 @@ namespace Annwvyn
 		REQUIRE(result != std::end(levelContent));
 		REQUIRE(*result == sinbad);
 	}
+
+	TEST_CASE("Level manager asynchronous load")
+	{
+		class TestLevelAsync : LEVEL
+		{
+		public:
+			TestLevelAsync() :
+			 constructLevel(),
+			 preparedOnWorker(false),
+			 created(0)
+			{}
+
+			void prepare() override
+			{
+				preparedOnWorker = std::this_thread::get_id() != mainThread;
+			}
+
+			void load() override
+			{
+				while(!loadIncrementally(0))
+					;
+			}
+
+			//One object per frame, whatever the budget is
+			bool loadIncrementally(double) override
+			{
+				if(created == 3) return true;
+				addGameObject("Sinbad.mesh", "Sinbad" + std::to_string(created++));
+				return false;
+			}
+
+			float getLoadingProgress() const override
+			{
+				return created / 3.0f;
+			}
+
+			void runLogic() override {}
+
+			const std::thread::id mainThread{ std::this_thread::get_id() };
+			bool preparedOnWorker;
+			int created;
+		};
+
+		auto GameEngine   = bootstrapEmptyEngine("TestLevel");
+		auto levelManager = AnnGetLevelManager();
+		auto first		  = levelManager->addLevel<TestLevel>();
+		auto second		  = levelManager->addLevel<TestLevelAsync>();
+
+		levelManager->switchToFirstLoadedLevel();
+		GameEngine->refresh();
+		REQUIRE(levelManager->getCurrentLevel() == first);
+
+		levelManager->switchToLevelAsync(second);
+		REQUIRE(levelManager->isLoading());
+		REQUIRE(levelManager->getLoadingProgress() == 0);
+
+		auto frames{ 0 };
+		auto progress{ 0.0f };
+		while(levelManager->isLoading() && frames++ < 600)
+		{
+			GameEngine->refresh();
+			REQUIRE(levelManager->getLoadingProgress() >= progress);
+			progress = levelManager->getLoadingProgress();
+		}
+
+		REQUIRE_FALSE(levelManager->isLoading());
+		REQUIRE(levelManager->getCurrentLevel() == second);
+		REQUIRE(second->preparedOnWorker);
+		REQUIRE(second->getContent().size() == 3);
+		REQUIRE(frames >= 3);
+	}
 }
@@ -0,0 +1,75 @@
+#include "stdafx.h"
+#include "engineBootstrap.hpp"
+
+namespace Annwvyn
+{
+	TEST_CASE("Log from several threads")
+	{
+		auto GameEngine = bootstrapEmptyEngine("LoggerTest");
+
+		AnnLogger::flush();
+		const auto written = AnnLogger::getWrittenCount();
+
+		std::vector<std::thread> threads;
+		for(auto i{ 0 }; i < 4; ++i)
+			threads.emplace_back([i] {
+				for(auto j{ 0 }; j < 100; ++j) AnnDebug() << "Thread " << i << " message " << j;
+			});
+		for(auto& thread : threads) thread.join();
+
+		AnnLogger::flush();
+		REQUIRE(AnnLogger::getWrittenCount() - written >= 400);
+
+		//The console gets the messages at the next frame
+		GameEngine->refresh();
+		REQUIRE(AnnLogger::takeConsoleMessages().empty());
+	}
+
+	TEST_CASE("Log objects destroyed out of order")
+	{
+		auto GameEngine = bootstrapEmptyEngine("LoggerTest");
+
+		AnnLogger::flush();
+		const auto written = AnnLogger::getWrittenCount();
+
+		//The first one goes away while the second one is still writing
+		auto first  = std::make_unique<AnnDebug>();
+		auto second = std::make_unique<AnnDebug>();
+		*first << "First message";
+		*second << "Second message";
+		first.reset();
+		{
+			AnnDebug third;
+			third << "Third message";
+			*second << ", still the second one";
+		}
+		second.reset();
+
+		AnnLogger::flush();
+		REQUIRE(AnnLogger::getWrittenCount() - written >= 3);
+	}
+
+	TEST_CASE("Disabled log levels are not evaluated")
+	{
+		auto GameEngine = bootstrapEmptyEngine("LoggerTest");
+
+		auto evaluated	= 0;
+		const auto count = [&] { return ++evaluated; };
+
+		AnnLogger::setLevel(AnnLogLevel::warning);
+		REQUIRE_FALSE(AnnLogger::isEnabled(AnnLogLevel::debug));
+		REQUIRE(AnnLogger::isEnabled(AnnLogLevel::error));
+
+		AnnLogger::flush();
+		const auto written = AnnLogger::getWrittenCount();
+
+		ANN_LOG(debug) << "Not evaluated " << count();
+		ANN_LOG(warning) << "Evaluated " << count();
+		AnnLogger::flush();
+
+		REQUIRE(evaluated == 1);
+		REQUIRE(AnnLogger::getWrittenCount() - written >= 1);
+
+		AnnLogger::setLevel(AnnLogLevel::debug);
+	}
+}
@@ -0,0 +1,33 @@
+#include "stdafx.h"
+#include "engineBootstrap.hpp"
+
+namespace Annwvyn
+{
+	TEST_CASE("Background resource group loading")
+	{
+		auto GameEngine		 = bootstrapEmptyEngine("ResourceManagerTest");
+		auto resourceManager = AnnGetResourceManager();
+		resourceManager->addZipLocation("./TestLevel.zip", "PreloadTest");
+
+		auto preload = resourceManager->loadGroupAsync("PreloadTest");
+		REQUIRE(preload);
+		REQUIRE(preload->getResourceCount() > 0);
+
+		//Progress only goes forward, while the engine keeps rendering frames
+		auto progress{ 0.f };
+		for(auto i{ 0 }; i < 600 && !preload->isDone(); ++i)
+		{
+			GameEngine->refresh();
+			REQUIRE(preload->getProgress() >= progress);
+			progress = preload->getProgress();
+		}
+
+		REQUIRE(preload->isDone());
+		REQUIRE(preload->getProgress() == 1);
+		REQUIRE(preload->getUploadedCount() + preload->getFailedCount() == preload->getResourceCount());
+		REQUIRE(Ogre::ResourceGroupManager::getSingleton().isResourceGroupLoaded("PreloadTest"));
+
+		//Nothing to do for a loaded group
+		REQUIRE(resourceManager->loadGroupAsync("PreloadTest")->isDone());
+	}
+}
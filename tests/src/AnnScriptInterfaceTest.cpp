@@ -33,6 +33,147 @@ namespace Annwvyn
 		REQUIRE(ogre->getPosition().y >= 5);
 	}
 
+	TEST_CASE("Run scripts in concurrent script domains")
+	{
+		auto GameEngine = bootstrapEmptyEngine("TestScriptDomains");
+
+		auto ResourceManager = AnnGetResourceManager();
+		ResourceManager->addFileLocation("./unitTestScripts");
+		ResourceManager->initResources();
+
+		auto GameObjectManager = AnnGetGameObjectManager();
+		auto first			   = GameObjectManager->createGameObject("Sinbad.mesh", "FirstOgre");
+		auto second			   = GameObjectManager->createGameObject("Sinbad.mesh", "SecondOgre");
+
+		first->attachScript("GoUpBehavior", "first");
+		second->attachScript("GoUpBehavior", "second");
+		REQUIRE(AnnGetScriptManager()->getScriptDomain("first")->isConcurrent());
+
+		auto counter{ 0 };
+		while(GameEngine->refresh())
+			if(++counter > 250) break;
+
+		//Both domains moved their object, through the command buffers
+		REQUIRE(first->getPosition().y >= 5);
+		REQUIRE(second->getPosition().y >= 5);
+	}
+
+	TEST_CASE("Profile behavior scripts")
+	{
+		auto GameEngine = bootstrapEmptyEngine("TestScriptProfiler");
+
+		auto ResourceManager = AnnGetResourceManager();
+		ResourceManager->addFileLocation("./unitTestScripts");
+		ResourceManager->initResources();
+
+		auto GameObjectManager = AnnGetGameObjectManager();
+		GameObjectManager->createGameObject("Sinbad.mesh", "FirstOgre")->attachScript("GoUpBehavior");
+		GameObjectManager->createGameObject("Sinbad.mesh", "SecondOgre")->attachScript("GoUpBehavior", "profiled");
+
+		auto counter{ 0 };
+		while(GameEngine->refresh())
+			if(++counter > 10) break;
+
+		//Both instances are merged in the profile of the class
+		const auto profiles = AnnGetScriptManager()->getScriptProfiles();
+		REQUIRE(profiles.size() == 1);
+		REQUIRE(profiles.front().name == "GoUpBehavior");
+		REQUIRE(profiles.front().instances == 2);
+		REQUIRE(profiles.front().updateCalls >= 20);
+		REQUIRE(profiles.front().totalTime > 0);
+		REQUIRE(profiles.front().peakFrameTime >= profiles.front().lastFrameTime);
+
+		const auto instanceProfiles = AnnGetScriptManager()->getScriptInstanceProfiles();
+		REQUIRE(instanceProfiles.size() == 2);
+		REQUIRE(instanceProfiles.front().updateCalls >= 10);
+	}
+
+	///Same as GoUpBehavior.chai, in C++
+	class NativeGoUpBehavior : public AnnNativeBehavior
+	{
+	public:
+		NativeGoUpBehavior(AnnGameObject* owner) :
+		 AnnNativeBehavior(owner)
+		{
+		}
+
+		void update()
+		{
+			owner->setPosition(owner->getPosition() + AnnVect3(0, 0.02f, 0));
+		}
+	};
+
+	TEST_CASE("Attach native behavior to object")
+	{
+		auto GameEngine = bootstrapEmptyEngine("TestNativeBehavior");
+
+		AnnGetScriptManager()->registerNativeBehavior<NativeGoUpBehavior>("GoUpBehavior");
+		REQUIRE(AnnGetScriptManager()->isNativeBehavior("GoUpBehavior"));
+
+		auto ogre = AnnGetGameObjectManager()->createGameObject("Sinbad.mesh", "Ogre");
+		ogre->attachScript("GoUpBehavior");
+
+		auto counter{ 0 };
+		while(GameEngine->refresh())
+			if(++counter >= 250) break;
+
+		REQUIRE(ogre->getPosition().y >= 5);
+
+		//The behavior must not be updated anymore once it's owner is gone
+		AnnGetGameObjectManager()->removeGameObject(ogre);
+		ogre.reset();
+		for(counter = 0; counter < 10 && GameEngine->refresh(); ++counter) continue;
+	}
+
+	TEST_CASE("Hot reload a behavior script")
+	{
+		auto GameEngine = bootstrapEmptyEngine("TestScriptReload");
+
+		//Write a script in a directory we can modify
+		const std::string directory{ "./hotReloadTestScripts" };
+		AnnFilesystemManager::createDirectory(directory);
+		const auto writeScript = [&](const std::string& direction) {
+			std::ofstream script(directory + "/HotReloadBehavior.chai");
+			script << "class HotReloadBehavior\n"
+				   << "{\n"
+				   << "    attr OwnerRef\n"
+				   << "    attr counter\n"
+				   << "    def HotReloadBehavior(ownerTag)\n"
+				   << "    {\n"
+				   << "        this.OwnerRef := AnnGetGameObject(ownerTag);\n"
+				   << "        this.counter = 0;\n"
+				   << "    }\n"
+				   << "    def update()\n"
+				   << "    {\n"
+				   << "        this.counter = this.counter + 1;\n"
+				   << "        this.OwnerRef.setPosition(AnnVect3(0, " << direction << " this.counter, 0));\n"
+				   << "    }\n"
+				   << "}\n";
+		};
+		writeScript("");
+
+		auto ResourceManager = AnnGetResourceManager();
+		ResourceManager->addFileLocation(directory);
+		ResourceManager->initResources();
+
+		auto ogre = AnnGetGameObjectManager()->createGameObject("Sinbad.mesh", "Ogre");
+		ogre->attachScript("HotReloadBehavior");
+
+		auto counter{ 0 };
+		while(GameEngine->refresh())
+			if(++counter >= 10) break;
+		REQUIRE(ogre->getPosition().y == 10);
+
+		//Change the script, and reload it. The counter attribute should survive the reload
+		writeScript("-");
+		REQUIRE(AnnGetScriptManager()->reloadScript("HotReloadBehavior"));
+
+		counter = 0;
+		while(GameEngine->refresh())
+			if(++counter >= 10) break;
+		REQUIRE(ogre->getPosition().y == -20);
+	}
+
 	TEST_CASE("Object manipulation via scripting")
 	{
 		//Get the engine components
@@ -62,6 +203,20 @@ namespace Annwvyn
 		renderForSecs();
 	}
 
+	TEST_CASE("Script API is shared between domains")
+	{
+		auto GameEngine = bootstrapEmptyEngine("TestScriptApiModule");
+
+		const auto& timings = GameEngine->getStartupTimings();
+		REQUIRE(std::find_if(timings.begin(), timings.end(), [](const std::pair<std::string, double>& timing) { return timing.first == "ScriptManager"; }) != timings.end());
+
+		auto ScriptManager = AnnGetScriptManager();
+		auto domain		   = ScriptManager->getScriptDomain("api");
+		REQUIRE(ScriptManager->_getEngine()->eval<float>("PI") == Ogre::Math::PI);
+		REQUIRE(domain->_getEngine()->eval<float>("PI") == Ogre::Math::PI);
+		REQUIRE(domain->_getEngine()->eval<Ogre::Vector3>("AnnVect3_UNIT_Y") == Ogre::Vector3::UNIT_Y);
+	}
+
 	TEST_CASE("Test scripting API")
 	{
 		using Ogre::Degree;
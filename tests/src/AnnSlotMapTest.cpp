@@ -0,0 +1,60 @@
+#include "stdafx.h"
+#include "engineBootstrap.hpp"
+#include "AnnSlotMap.hpp"
+
+namespace Annwvyn
+{
+	TEST_CASE("Slot map removal keeps the other handles valid")
+	{
+		AnnSlotMap<int> map;
+		std::vector<AnnSlotHandle> handles;
+		for(auto i{ 0 }; i < 10; ++i)
+			handles.push_back(map.insert(std::make_shared<int>(i)));
+
+		REQUIRE(map.erase(handles[0]));
+		REQUIRE(map.erase(handles[5]));
+		REQUIRE_FALSE(map.erase(handles[5]));
+		REQUIRE(map.size() == 8);
+
+		for(auto i{ 0 }; i < 10; ++i)
+			if(i == 0 || i == 5)
+				REQUIRE(map.get(handles[i]) == nullptr);
+			else
+				REQUIRE(*map.get(handles[i]) == i);
+
+		//A reused slot doesn't answer to the old handle
+		const auto reused = map.insert(std::make_shared<int>(42));
+		REQUIRE(reused.index == handles[5].index);
+		REQUIRE(reused != handles[5]);
+		REQUIRE(map.get(handles[5]) == nullptr);
+		REQUIRE(*map.get(reused) == 42);
+
+		map.clear();
+		REQUIRE(map.empty());
+		REQUIRE(map.get(reused) == nullptr);
+		REQUIRE(map.get(handles[9]) == nullptr);
+	}
+
+	TEST_CASE("Unload a big level")
+	{
+		auto GameEngine = bootstrapTestEngine("SlotMapTest");
+		auto manager	= AnnGetGameObjectManager();
+
+		AnnGameObjectList objects;
+		for(auto i{ 0 }; i < 2000; ++i)
+			objects.push_back(manager->createGameObject("Sinbad.mesh"));
+
+		//Remove every other object, the rest should stay reachable
+		for(size_t i{ 0 }; i < objects.size(); i += 2)
+			manager->removeGameObject(objects[i]);
+
+		for(size_t i{ 0 }; i < objects.size(); ++i)
+			REQUIRE((manager->getGameObject(objects[i]->getName()) != nullptr) == (i % 2 == 1));
+
+		for(size_t i{ 1 }; i < objects.size(); i += 2)
+			manager->removeGameObject(objects[i]);
+
+		REQUIRE(manager->getGameObject(objects.back()->getName()) == nullptr);
+		GameEngine->refresh();
+	}
+}
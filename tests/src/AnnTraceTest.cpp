@@ -0,0 +1,60 @@
+#include "stdafx.h"
+#include "engineBootstrap.hpp"
+#include "AnnTrace.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace Annwvyn
+{
+	TEST_CASE("Record a performance trace")
+	{
+		auto GameEngine = bootstrapEmptyEngine("TraceTest");
+
+		const std::string traceFile{ "TraceTest.anntrace" };
+		REQUIRE(AnnTrace::start(traceFile));
+		REQUIRE(AnnTrace::isRecording());
+
+		for(auto i{ 0 }; i < 3; ++i) GameEngine->refresh();
+		AnnTrace::scriptError("TraceTestScript", "Test error");
+		AnnTrace::stop();
+		REQUIRE_FALSE(AnnTrace::isRecording());
+
+		std::ifstream input(traceFile, std::ios::binary);
+		const std::vector<char> file{ std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>() };
+
+		AnnTraceFormat::Header header{};
+		REQUIRE(file.size() > sizeof header);
+		memcpy(&header, file.data(), sizeof header);
+		REQUIRE(memcmp(header.magic, AnnTraceFormat::magic, sizeof header.magic) == 0);
+		REQUIRE(header.version == AnnTraceFormat::version);
+
+		//Walk the records, every one of them should be complete
+		size_t frameBegins{ 0 }, frameEnds{ 0 }, subsystems{ 0 }, scriptErrors{ 0 }, strings{ 0 };
+		size_t offset{ sizeof header };
+		while(offset < file.size())
+		{
+			AnnTraceFormat::RecordHeader recordHeader{};
+			REQUIRE(offset + sizeof recordHeader <= file.size());
+			memcpy(&recordHeader, &file[offset], sizeof recordHeader);
+			offset += sizeof recordHeader + recordHeader.size;
+			REQUIRE(offset <= file.size());
+
+			switch(recordHeader.type)
+			{
+				case AnnTraceFormat::string: ++strings; break;
+				case AnnTraceFormat::frameBegin: ++frameBegins; break;
+				case AnnTraceFormat::frameEnd: ++frameEnds; break;
+				case AnnTraceFormat::subsystem: ++subsystems; break;
+				case AnnTraceFormat::scriptError: ++scriptErrors; break;
+				default: break;
+			}
+		}
+
+		REQUIRE(frameBegins == 3);
+		REQUIRE(frameEnds == 3);
+		REQUIRE(subsystems >= 3);
+		REQUIRE(scriptErrors == 1);
+		REQUIRE(strings > 0);
+	}
+}
@@ -20,7 +20,7 @@ namespace Annwvyn
 			void setID(AnnTimerID newID) { id = newID; }
 
 			//If we ever get a time event that correspond to the timer we want, set to true
-			void TimeEvent(AnnTimeEvent e) override
+			void TimeEvent(const AnnTimeEvent& e) override
 			{
 				if(e.getID() == id) state = true;
 			}
@@ -72,7 +72,7 @@ namespace Annwvyn
 			 normal{ 0, 0, 0 }
 			{}
 
-			void CollisionEvent(AnnCollisionEvent e) override
+			void CollisionEvent(const AnnCollisionEvent& e) override
 			{
 				auto objectManager = AnnGetGameObjectManager();
 				if(e.hasObject(objectManager->getGameObject("_internal_test_floor").get()) && //you should store a pointer to the object for performance, not search it each time
@@ -168,4 +168,67 @@ namespace Annwvyn
 		REQUIRE(counter == refCounter);
 		REQUIRE(counter == nbFrames);
 	}
+
+	TEST_CASE("Frame arena reuses its memory")
+	{
+		AnnFrameArena arena(64);
+
+		auto first = arena.allocate<unsigned short>(10);
+		REQUIRE(first.size() == 10);
+		for(auto value : first) REQUIRE(value == 0);
+
+		//Bigger than a block
+		const int source[]{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+		auto copy = arena.copy(source, 20);
+		REQUIRE(copy[19] == 20);
+		REQUIRE(reinterpret_cast<uintptr_t>(copy.data()) % alignof(int) == 0);
+
+		const auto capacity = arena.getCapacity();
+		for(auto frame{ 0 }; frame < 100; ++frame)
+		{
+			arena.reset();
+			arena.allocate<unsigned short>(10);
+			arena.copy(source, 20);
+		}
+
+		//Once grown, the arena doesn't ask for more memory
+		REQUIRE(arena.getCapacity() == capacity);
+	}
+
+	TEST_CASE("Single producer single consumer queue")
+	{
+		auto queue = std::make_unique<AnnSpscQueue<size_t, 64>>();
+		const size_t count{ 10000 };
+
+		std::thread producer([&] {
+			for(size_t i{ 0 }; i < count;)
+				if(queue->push(i)) ++i;
+				else std::this_thread::yield();
+		});
+
+		//Every value comes out once, in order
+		size_t expected{ 0 }, value;
+		while(expected < count)
+			if(queue->pop(value)) REQUIRE(value == expected++);
+			else std::this_thread::yield();
+
+		producer.join();
+		REQUIRE_FALSE(queue->pop(value));
+	}
+
+	TEST_CASE("Capture input on the input thread")
+	{
+		auto GameEngine = bootstrapEmptyEngine("InputThreadTest");
+		auto eventManager = AnnGetEventManager();
+
+		REQUIRE_FALSE(eventManager->isInputThreadRunning());
+		eventManager->startInputThread(500);
+		REQUIRE(eventManager->isInputThreadRunning());
+
+		for(auto i{ 0 }; i < 30; ++i) GameEngine->refresh();
+
+		eventManager->stopInputThread();
+		REQUIRE_FALSE(eventManager->isInputThreadRunning());
+		GameEngine->refresh();
+	}
 }
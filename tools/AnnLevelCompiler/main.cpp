@@ -0,0 +1,31 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+//Offline level compiler : turn the JSON levels used by AnnJsonLevel into the compiled format loaded by AnnBinaryLevel
+
+#include <AnnBinaryLevel.hpp>
+
+#include <iostream>
+#include <exception>
+
+int main(int argc, char* argv[])
+{
+	if(argc != 3)
+	{
+		std::cerr << "usage : " << argv[0] << " <level.json> <level.annlevel>\n";
+		return 1;
+	}
+
+	try
+	{
+		Annwvyn::AnnBinaryLevel::compileFile(argv[1], argv[2]);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return 1;
+	}
+
+	std::cout << "Compiled " << argv[1] << " into " << argv[2] << '\n';
+	return 0;
+}
@@ -0,0 +1,261 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+//Offline trace reader : turn the performance traces written by AnnTrace into CSV or JSON, one row per record
+
+#include <AnnTraceFormat.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Annwvyn;
+
+namespace
+{
+	///A record, with its strings resolved
+	struct Row
+	{
+		uint64_t time;
+		const char* record;
+		uint64_t frame;
+		std::string name;
+		std::string detail;
+		uint64_t duration;
+		uint64_t bytes;
+	};
+
+	const char* phaseName(uint32_t phase)
+	{
+		switch(phase)
+		{
+			case AnnTraceFormat::prepareBegin: return "prepare_begin";
+			case AnnTraceFormat::prepareEnd: return "prepare_end";
+			case AnnTraceFormat::unloadBegin: return "unload_begin";
+			case AnnTraceFormat::unloadEnd: return "unload_end";
+			case AnnTraceFormat::loadBegin: return "load_begin";
+			case AnnTraceFormat::loadEnd: return "load_end";
+			default: return "unknown";
+		}
+	}
+
+	const char* resourceKindName(uint32_t kind)
+	{
+		switch(kind)
+		{
+			case 0: return "texture";
+			case 1: return "mesh";
+			case 2: return "sound";
+			default: return "unknown";
+		}
+	}
+
+	std::string escapeCsv(const std::string& text)
+	{
+		if(text.find_first_of(",\"\n\r") == std::string::npos) return text;
+
+		std::string escaped{ "\"" };
+		for(auto c : text)
+		{
+			if(c == '"') escaped += '"';
+			escaped += c;
+		}
+		return escaped + '"';
+	}
+
+	std::string escapeJson(const std::string& text)
+	{
+		std::string escaped{ "\"" };
+		for(auto c : text)
+		{
+			switch(c)
+			{
+				case '"': escaped += "\\\""; break;
+				case '\\': escaped += "\\\\"; break;
+				case '\n': escaped += "\\n"; break;
+				case '\r': escaped += "\\r"; break;
+				case '\t': escaped += "\\t"; break;
+				default:
+					if(uint8_t(c) < 0x20)
+					{
+						char code[8];
+						snprintf(code, sizeof code, "\\u%04x", unsigned(uint8_t(c)));
+						escaped += code;
+					}
+					else
+						escaped += c;
+			}
+		}
+		return escaped + '"';
+	}
+
+	///Read the payload of a record into a struct. Missing bytes, from an older version, are left at zero
+	template <class Record>
+	Record readPayload(const char* payload, size_t size)
+	{
+		Record record{};
+		memcpy(&record, payload, std::min(size, sizeof record));
+		return record;
+	}
+
+	///Decode every record of a trace. Throw if the file isn't a trace
+	std::vector<Row> readTrace(const std::vector<char>& file)
+	{
+		AnnTraceFormat::Header header{};
+		if(file.size() < sizeof header) throw std::runtime_error("File too small to be a trace");
+		memcpy(&header, file.data(), sizeof header);
+		if(memcmp(header.magic, AnnTraceFormat::magic, sizeof header.magic) != 0) throw std::runtime_error("Not a trace file");
+		if(header.version > AnnTraceFormat::version) throw std::runtime_error("Trace written by a newer version of the engine");
+
+		std::unordered_map<uint32_t, std::string> strings;
+		const auto string = [&](uint32_t id) {
+			const auto found = strings.find(id);
+			return found != strings.end() ? found->second : std::string{};
+		};
+
+		std::vector<Row> rows;
+		uint64_t frame{ 0 };
+		size_t offset{ sizeof header };
+		while(offset + sizeof(AnnTraceFormat::RecordHeader) <= file.size())
+		{
+			AnnTraceFormat::RecordHeader recordHeader{};
+			memcpy(&recordHeader, &file[offset], sizeof recordHeader);
+			offset += sizeof recordHeader;
+
+			//The engine may have stopped in the middle of a record
+			if(offset + recordHeader.size > file.size()) break;
+			const auto payload = &file[offset];
+			const size_t size  = recordHeader.size;
+			offset += size;
+
+			switch(recordHeader.type)
+			{
+				case AnnTraceFormat::string:
+				{
+					const auto record = readPayload<AnnTraceFormat::StringRecord>(payload, size);
+					if(size >= sizeof record) strings[record.id].assign(payload + sizeof record, size - sizeof record);
+					break;
+				}
+				case AnnTraceFormat::frameBegin:
+				case AnnTraceFormat::frameEnd:
+				{
+					const auto record = readPayload<AnnTraceFormat::FrameRecord>(payload, size);
+					frame			  = record.frame;
+					rows.push_back({ record.time, recordHeader.type == AnnTraceFormat::frameBegin ? "frame_begin" : "frame_end", frame, {}, {}, 0, 0 });
+					break;
+				}
+				case AnnTraceFormat::subsystem:
+				{
+					const auto record = readPayload<AnnTraceFormat::SubsystemRecord>(payload, size);
+					rows.push_back({ record.time, "subsystem", frame, string(record.name), {}, record.duration, 0 });
+					break;
+				}
+				case AnnTraceFormat::levelPhase:
+				{
+					const auto record = readPayload<AnnTraceFormat::LevelPhaseRecord>(payload, size);
+					rows.push_back({ record.time, "level_phase", frame, string(record.level), phaseName(record.phase), 0, 0 });
+					break;
+				}
+				case AnnTraceFormat::resourceLoad:
+				{
+					const auto record = readPayload<AnnTraceFormat::ResourceLoadRecord>(payload, size);
+					rows.push_back({ record.time, "resource_load", frame, string(record.name), string(record.group) + "/" + resourceKindName(record.kind), record.duration, record.bytes });
+					break;
+				}
+				case AnnTraceFormat::scriptError:
+				{
+					const auto record = readPayload<AnnTraceFormat::ScriptErrorRecord>(payload, size);
+					rows.push_back({ record.time, "script_error", frame, string(record.script), string(record.message), 0, 0 });
+					break;
+				}
+				default: break; //Written by a newer engine, skip it
+			}
+		}
+
+		return rows;
+	}
+
+	void writeCsv(std::ostream& out, const std::vector<Row>& rows)
+	{
+		out << "time_us,record,frame,name,detail,duration_us,bytes\n";
+		for(const auto& row : rows)
+			out << row.time << ',' << row.record << ',' << row.frame << ',' << escapeCsv(row.name) << ',' << escapeCsv(row.detail) << ','
+				<< row.duration << ',' << row.bytes << '\n';
+	}
+
+	void writeJson(std::ostream& out, const std::vector<Row>& rows)
+	{
+		out << "[\n";
+		for(size_t i{ 0 }; i < rows.size(); ++i)
+		{
+			const auto& row = rows[i];
+			out << "  { \"time_us\": " << row.time << ", \"record\": \"" << row.record << "\", \"frame\": " << row.frame
+				<< ", \"name\": " << escapeJson(row.name) << ", \"detail\": " << escapeJson(row.detail)
+				<< ", \"duration_us\": " << row.duration << ", \"bytes\": " << row.bytes << " }" << (i + 1 < rows.size() ? ",\n" : "\n");
+		}
+		out << "]\n";
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto json{ false };
+	std::vector<std::string> paths;
+	for(auto i{ 1 }; i < argc; ++i)
+	{
+		if(std::string(argv[i]) == "--json")
+			json = true;
+		else
+			paths.emplace_back(argv[i]);
+	}
+
+	if(paths.empty() || paths.size() > 2)
+	{
+		std::cerr << "usage : " << argv[0] << " [--json] <trace.anntrace> [output]\n";
+		return 1;
+	}
+
+	std::ifstream input(paths[0], std::ios::binary);
+	if(!input)
+	{
+		std::cerr << "Cannot open " << paths[0] << '\n';
+		return 1;
+	}
+	const std::vector<char> file{ std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>() };
+
+	try
+	{
+		const auto rows = readTrace(file);
+
+		std::ofstream output;
+		if(paths.size() == 2)
+		{
+			output.open(paths[1]);
+			if(!output)
+			{
+				std::cerr << "Cannot write " << paths[1] << '\n';
+				return 1;
+			}
+		}
+		auto& out = paths.size() == 2 ? output : std::cout;
+
+		if(json)
+			writeJson(out, rows);
+		else
+			writeCsv(out, rows);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return 1;
+	}
+
+	return 0;
+}